@@ -46,6 +46,17 @@ extern ADC_HandleTypeDef hadc3;
 #define ADC_1_CHANNEL_COUNT (ADC_1_CHANNEL_INDEX_COUNT)
 #define ADC_2_CHANNEL_COUNT (ADC_2_CHANNEL_INDEX_COUNT)
 
+/** @brief Number of buffers used by the DMA of each ADC */
+#define ADC_BUFFER_COUNT (2U)
+
+/**
+ * @brief Number of conversion sequences stored inside each buffer
+ *
+ * @details The ADC timer runs this many times faster than the feedbacks
+ * acquisition so that every channel is oversampled
+ */
+#define ADC_OVERSAMPLING_COUNT (4U)
+
 /** @brief Feedbacks reference voltage in V */
 #define ADC_VREF (3.3f)
 
@@ -127,10 +138,15 @@ void MX_ADC3_Init(void);
 
 /* USER CODE BEGIN Prototypes */
 
-// TODO: Change DMA settings to run in continous conversion instead of just once
-// so that this function is not called only for the feedback module
-
-/** @brief Start the ADC conversions for the feedbacks acquisition */
+/**
+ * @brief Start the continuous acquisition of the ADC channels
+ *
+ * @details A conversion sequence is triggered by every update event of the ADC
+ * timer and the DMA keeps writing the results into the buffers without any
+ * intervention of the CPU, so this function has to be called only once
+ *
+ * @details The values are processed every ADC_OVERSAMPLING_COUNT sequences
+ */
 void adc_start_feedback_conversion(void);
 
 /* USER CODE END Prototypes */
@@ -0,0 +1,305 @@
+/**
+ * @file black-box.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Capture of the pack state before a fatal error
+ *
+ * @details A compact sample of the pack state is continuously recorded
+ * inside a ring buffer in RAM; when the BMS goes to the fatal state the
+ * buffer is frozen and its content is compressed and written to the EEPROM,
+ * from where it can be retrieved via CAN when the CONF_CANLIB_PENDING_MESSAGES_ENABLE
+ * option is defined.
+ *
+ * @details The capture is a byte stream made of a header followed by the samples,
+ * every field is encoded as the difference from the previous sample (the bitmasks
+ * are XORed) stored as a zigzag variable length integer, so a value that does not
+ * change takes a single byte. The stream is split into chunks that fit a storage slot
+ *
+ * @details The recording cost is constant since a sample only reads the already
+ * aggregated values of the other modules, the compression runs only during the
+ * flush, one chunk at a time
+ */
+
+#ifndef BLACK_BOX_H
+#define BLACK_BOX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "primary_network.h"
+#include "storage.h"
+
+/** @brief Interval between two samples in ms */
+#define BLACK_BOX_SAMPLE_INTERVAL_MS (20U)
+
+/** @brief Number of recorded samples (i.e. 5 seconds) */
+#define BLACK_BOX_SAMPLE_COUNT (250U)
+
+/** @brief Interval between two messages of the dump in ms */
+#define BLACK_BOX_DUMP_INTERVAL_MS (5U)
+
+/** @brief Resolution of the sampled values */
+#define BLACK_BOX_CELL_VOLTAGE_SCALE (10000.f) // 0.1 mV
+#define BLACK_BOX_TEMPERATURE_SCALE (10.f) // 0.1 °C
+#define BLACK_BOX_CURRENT_SCALE (10.f) // 0.1 A
+#define BLACK_BOX_VOLTAGE_SCALE (10.f) // 0.1 V
+
+/**
+ * @brief Maximum size of the encoded data in bytes
+ *
+ * @details A variable length integer takes at most 3 bytes for a 17 bit value
+ * and 5 bytes for a 32 bit value, the header contains six 32 bit values while
+ * each sample contains seven 16 bit values, two bitmasks and the FSM state
+ */
+#define BLACK_BOX_HEADER_ENCODED_SIZE_MAX (6U * 5U)
+#define BLACK_BOX_SAMPLE_ENCODED_SIZE_MAX (7U * 3U + 2U * 5U + 2U)
+
+/**
+ * @brief Number of bytes of the stream for each chunk
+ *
+ * @details A chunk fills a storage slot together with the record header (8 bytes)
+ */
+#define BLACK_BOX_CHUNK_DATA_SIZE (51U)
+
+/** @brief Maximum number of chunks of a capture */
+#define BLACK_BOX_CHUNK_COUNT_MAX \
+    ((BLACK_BOX_HEADER_ENCODED_SIZE_MAX + BLACK_BOX_SAMPLE_COUNT * BLACK_BOX_SAMPLE_ENCODED_SIZE_MAX + \
+      BLACK_BOX_CHUNK_DATA_SIZE - 1U) / BLACK_BOX_CHUNK_DATA_SIZE)
+
+#if BLACK_BOX_CHUNK_COUNT_MAX > STORAGE_BLACK_BOX_SLOT_COUNT
+#error "The black box region cannot contain a whole capture"
+#endif  // BLACK_BOX_CHUNK_COUNT_MAX > STORAGE_BLACK_BOX_SLOT_COUNT
+
+/** @brief Number of data bytes of a single dump message */
+#define BLACK_BOX_DUMP_DATA_SIZE (5U)
+
+/** @brief Type definition for the function used to read the CPU cycle counter */
+typedef uint32_t (* black_box_get_cycles_callback_t)(void);
+
+/**
+ * @brief Return code for the black box module functions
+ *
+ * @details
+ *     - BLACK_BOX_OK the function executed successfully
+ *     - BLACK_BOX_NULL_POINTER a NULL pointer is given as parameter
+ *     - BLACK_BOX_FROZEN the buffer is frozen and no sample is recorded
+ */
+typedef enum {
+    BLACK_BOX_OK,
+    BLACK_BOX_NULL_POINTER,
+    BLACK_BOX_FROZEN
+} BlackBoxReturnCode;
+
+/**
+ * @brief Single sample of the pack state
+ *
+ * @param feedback_high The bitmask of the feedbacks with a high status
+ * @param feedback_error The bitmask of the feedbacks with an error status
+ * @param min_volt The minimum cell voltage in 0.1 mV
+ * @param max_volt The maximum cell voltage in 0.1 mV
+ * @param min_temp The minimum cell temperature in 0.1 °C
+ * @param max_temp The maximum cell temperature in 0.1 °C
+ * @param current The current of the pack in 0.1 A
+ * @param ts_voltage The tractive system voltage in 0.1 V
+ * @param pack_voltage The pack voltage in 0.1 V
+ * @param fsm_state The state of the FSM
+ */
+typedef struct {
+    bit_flag32_t feedback_high;
+    bit_flag32_t feedback_error;
+    uint16_t min_volt;
+    uint16_t max_volt;
+    int16_t min_temp;
+    int16_t max_temp;
+    int16_t current;
+    uint16_t ts_voltage;
+    uint16_t pack_voltage;
+    uint8_t fsm_state;
+} BlackBoxSample;
+
+/**
+ * @brief Header of a capture
+ *
+ * @param sample_count The number of samples of the capture
+ * @param interval The interval between two samples in ms
+ * @param timestamp The time of the last sample in ms
+ * @param group The expired error group
+ * @param instance The expired error instance
+ * @param record_cycles_max The maximum number of CPU cycles spent to record a sample
+ */
+typedef struct {
+    uint32_t sample_count;
+    uint32_t interval;
+    uint32_t timestamp;
+    uint32_t group;
+    uint32_t instance;
+    uint32_t record_cycles_max;
+} BlackBoxHeader;
+
+/**
+ * @brief Chunk of a capture as stored inside the EEPROM
+ *
+ * @param capture The identifier of the capture, i.e. the sequence number of its first chunk
+ * @param index The index of the chunk inside the capture
+ * @param size The number of valid bytes of data
+ * @param last True if this is the last chunk of the capture
+ * @param data The bytes of the stream
+ */
+typedef struct {
+    uint16_t capture;
+    uint8_t index;
+    uint8_t size;
+    uint8_t last;
+    uint8_t data[BLACK_BOX_CHUNK_DATA_SIZE];
+} BlackBoxChunk;
+
+/**
+ * @brief Black box handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @param get_cycles A pointer to the function used to read the CPU cycle counter
+ * @param record_cycles The number of CPU cycles spent to record the last sample
+ * @param record_cycles_max The maximum number of CPU cycles spent to record a sample
+ * @param samples The ring buffer of the recorded samples
+ * @param head The index where the next sample is recorded
+ * @param count The number of recorded samples
+ * @param frozen True if the recording is stopped until the capture is written
+ * @param flushing True if the capture is being written to the EEPROM
+ * @param header The header of the capture
+ * @param encoded The number of stream items (header and samples) already encoded
+ * @param previous The last encoded sample
+ * @param pending The encoded item not yet copied into a chunk
+ * @param pending_size The size of the encoded item in bytes
+ * @param pending_offset The number of bytes of the encoded item already copied
+ * @param chunk The chunk being written
+ * @param chunk_ready True if the chunk has been filled and is waiting to be saved
+ * @param dumping True if the last capture is being sent via CAN
+ * @param locating True if the first chunk of the capture to dump has not been found yet
+ * @param dump_loaded True if the dumped chunk has been read from the EEPROM
+ * @param dump_sequence The sequence number of the dumped chunk
+ * @param dump_offset The number of bytes of the dumped chunk already sent
+ * @param dump_stream_offset The number of bytes of the stream already sent
+ * @param dump_chunk The dumped chunk
+ * @param black_box_can_payload The canlib payload of the dump
+ */
+typedef struct {
+    black_box_get_cycles_callback_t get_cycles;
+    uint32_t record_cycles;
+    uint32_t record_cycles_max;
+
+    BlackBoxSample samples[BLACK_BOX_SAMPLE_COUNT];
+    size_t head;
+    size_t count;
+    bool frozen;
+
+    bool flushing;
+    BlackBoxHeader header;
+    size_t encoded;
+    BlackBoxSample previous;
+    uint8_t pending[MAINBOARD_MAX(BLACK_BOX_HEADER_ENCODED_SIZE_MAX, BLACK_BOX_SAMPLE_ENCODED_SIZE_MAX)];
+    size_t pending_size;
+    size_t pending_offset;
+    BlackBoxChunk chunk;
+    bool chunk_ready;
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    bool dumping;
+    bool locating;
+    bool dump_loaded;
+    uint32_t dump_sequence;
+    size_t dump_offset;
+    uint16_t dump_stream_offset;
+    BlackBoxChunk dump_chunk;
+    primary_hv_black_box_converted_t black_box_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+} _BlackBoxHandler;
+
+#ifdef CONF_BLACK_BOX_MODULE_ENABLE
+
+/**
+ * @brief Initialize the black box module
+ *
+ * @attention The storage module must be initialized before this function
+ *
+ * @param get_cycles A pointer to the function used to read the CPU cycle counter
+ *
+ * @return BlackBoxReturnCode
+ *     - BLACK_BOX_NULL_POINTER if the parameter is NULL
+ *     - BLACK_BOX_OK otherwise
+ */
+BlackBoxReturnCode black_box_init(const black_box_get_cycles_callback_t get_cycles);
+
+/**
+ * @brief Record a new sample of the pack state overwriting the oldest one
+ *
+ * @return BlackBoxReturnCode
+ *     - BLACK_BOX_FROZEN if the buffer is frozen
+ *     - BLACK_BOX_OK otherwise
+ */
+BlackBoxReturnCode black_box_record(void);
+
+/**
+ * @brief Freeze the recorded samples and start writing them to the EEPROM
+ *
+ * @details A last sample is recorded before freezing the buffer; the
+ * buffer stays frozen, and other triggers are ignored, until the whole
+ * capture has been written
+ */
+void black_box_trigger(void);
+
+/**
+ * @brief Write the next chunk of the capture if the storage is not busy
+ */
+void black_box_routine(void);
+
+/**
+ * @brief Get the number of CPU cycles spent to record a sample
+ *
+ * @return uint32_t The maximum number of cycles since the initialization
+ */
+uint32_t black_box_get_record_cycles_max(void);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Handle the received black box dump request
+ *
+ * @details The newest capture stored inside the EEPROM is sent, the
+ * request is ignored while a capture is being written
+ *
+ * @param payload A pointer to the canlib payload
+ */
+void black_box_dump_request_handle(primary_hv_black_box_dump_request_converted_t * const payload);
+
+/**
+ * @brief Get a pointer to the canlib payload of the next bytes of the dumped capture
+ *
+ * @details The dump task is disabled when the last chunk is sent
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_black_box_converted_t* A pointer to the payload or NULL if no data is available yet
+ */
+primary_hv_black_box_converted_t * black_box_get_black_box_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#else  // CONF_BLACK_BOX_MODULE_ENABLE
+
+#define black_box_init(get_cycles) (BLACK_BOX_OK)
+#define black_box_record() (BLACK_BOX_OK)
+#define black_box_trigger() MAINBOARD_NOPE()
+#define black_box_routine() MAINBOARD_NOPE()
+#define black_box_get_record_cycles_max() (0U)
+#define black_box_dump_request_handle(payload) MAINBOARD_NOPE()
+#define black_box_get_black_box_canlib_payload(byte_size) (NULL)
+
+#endif  // CONF_BLACK_BOX_MODULE_ENABLE
+
+#endif  // BLACK_BOX_H
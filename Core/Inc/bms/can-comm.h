@@ -33,6 +33,58 @@
 #define CAN_COMM_TX_BUFFER_BYTE_SIZE (CAN_COMM_MESSAGE_COUNT)
 #define CAN_COMM_RX_BUFFER_BYTE_SIZE (CAN_COMM_MESSAGE_COUNT)
 
+/**
+ * @brief Maximum number of safety-critical messages waiting to be handled
+ *
+ * @details The buffer is emptied every time the fast routine runs, which
+ * happens multiple times for each iteration of the main loop
+ */
+#define CAN_COMM_RX_FAST_BUFFER_SIZE (16U)
+
+/**
+ * @brief List of the BMS network messages forwarded to the primary network
+ *
+ * @attention This file uses X macros (https://en.wikipedia.org/wiki/X_macro)
+ * to make it easier to add more routes without to much changes to the code
+ *
+ * @details The frames are forwarded as they are received (raw) without being
+ * converted, only the CAN identifier is changed
+ *
+ * @attention The primary identifiers are reserved as mirrors of the BMS messages
+ * inside assets/can/networks/primary/network.json, so the list is empty until the
+ * CONF_CANLIB_PENDING_MESSAGES_ENABLE option is defined
+ *
+ * @details The interval is shared by the frames of all the cellboards, so the
+ * routes of the multiplexed messages forward a sample of them
+ *
+ * @param name The name associated with the route (have to be unique)
+ * @param enabled True if the route should be enabled by default or not
+ * @param index The canlib index of the BMS message to forward
+ * @param id The CAN identifier used on the primary network
+ * @param interval The minimum time between two forwarded frames in ms (0 means no limit)
+ */
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+#define CAN_COMM_GATEWAY_X_LIST \
+    CAN_COMM_GATEWAY_X(CELLBOARD_STATUS, true, BMS_CELLBOARD_STATUS_INDEX, PRIMARY_HV_CELLBOARD_STATUS_FRAME_ID, PRIMARY_HV_CELLBOARD_STATUS_CYCLE_TIME_MS) \
+    CAN_COMM_GATEWAY_X(CELLS_VOLTAGE, true, BMS_CELLBOARD_CELLS_VOLTAGE_INDEX, PRIMARY_HV_CELLBOARD_CELLS_VOLTAGE_FRAME_ID, PRIMARY_HV_CELLBOARD_CELLS_VOLTAGE_CYCLE_TIME_MS) \
+    CAN_COMM_GATEWAY_X(CELLS_TEMPERATURE, true, BMS_CELLBOARD_CELLS_TEMPERATURE_INDEX, PRIMARY_HV_CELLBOARD_CELLS_TEMPERATURE_FRAME_ID, PRIMARY_HV_CELLBOARD_CELLS_TEMPERATURE_CYCLE_TIME_MS) \
+    CAN_COMM_GATEWAY_X(BALANCING_STATUS, true, BMS_CELLBOARD_BALANCING_STATUS_INDEX, PRIMARY_HV_CELLBOARD_BALANCING_STATUS_FRAME_ID, PRIMARY_HV_CELLBOARD_BALANCING_STATUS_CYCLE_TIME_MS)
+#else  // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+#define CAN_COMM_GATEWAY_X_LIST
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/** @brief Maximum number of raw frames waiting to be forwarded to the primary network */
+#define CAN_COMM_GATEWAY_BUFFER_SIZE (32U)
+
+/**
+ * @brief Number of bins of the queue latency histograms
+ *
+ * @details The first bin counts the messages with a latency of 0 ticks, the
+ * i-th bin the ones with a latency in the range [2^(i-1), 2^i) and the last
+ * bin every latency greater than that
+ */
+#define CAN_COMM_LATENCY_HISTOGRAM_SIZE (16U)
+
 /** @brief Mask for the bits that defines if the CAN module is enabled or not */
 #define CAN_COMM_ENABLED_ALL_MASK \
     ( \
@@ -139,6 +191,99 @@ typedef enum {
     CAN_COMM_ENABLE_BIT_COUNT
 } CanCommEnableBit;
 
+/**
+ * @brief Identifiers of the gateway routes
+ *
+ * @details The identifiers are in the format CAN_COMM_GATEWAY_ID_[NAME]
+ */
+#define CAN_COMM_GATEWAY_X(NAME, ENABLED, INDEX, ID, INTERVAL) CAN_COMM_GATEWAY_ID_##NAME,
+typedef enum {
+    CAN_COMM_GATEWAY_X_LIST
+    CAN_COMM_GATEWAY_ID_COUNT
+} CanCommGatewayId;
+#undef CAN_COMM_GATEWAY_X
+
+/**
+ * @brief Definition of a single gateway route
+ *
+ * @param enabled True if the route is enabled, false otherwise
+ * @param index The canlib index of the BMS message to forward
+ * @param id The CAN identifier used on the primary network
+ * @param interval The minimum time between two forwarded frames in ticks
+ * @param last The time when the last frame was forwarded in ticks
+ * @param sent The number of frames sent on the primary network
+ * @param failed The number of failed transmissions (the frame is sent again afterwards)
+ */
+typedef struct {
+    bool enabled;
+    can_index_t index;
+    can_id_t id;
+    ticks_t interval;
+    ticks_t last;
+
+    uint32_t sent;
+    uint32_t failed;
+} CanCommGatewayRoute;
+
+/**
+ * @brief Raw CAN frame forwarded by the gateway
+ *
+ * @param route The identifier of the route that forwarded the frame
+ * @param id The CAN identifier
+ * @param size The payload size in bytes
+ * @param data The raw payload
+ */
+typedef struct {
+    CanCommGatewayId route;
+    can_id_t id;
+    uint8_t size;
+    uint8_t data[CAN_COMM_MAX_PAYLOAD_BYTE_SIZE];
+} CanCommRawFrame;
+
+/**
+ * @brief Statistics of a single CAN message
+ *
+ * @details Each counter is written from a single context, the reception ones
+ * from the CAN reception interrupt and the others from the main loop, so no
+ * increment can be lost
+ *
+ * @param enqueued The number of messages added to the transmission buffer
+ * @param sent The number of messages sent successfully
+ * @param failed The number of messages that could not be sent
+ * @param dropped_busy The number of messages discarded because the same message was still inside the buffer
+ * @param dropped_overrun The number of messages discarded because the transmission buffer was full
+ * @param received The number of messages received (written by the interrupt)
+ * @param rx_dropped_overrun The number of messages discarded because the reception buffer was full (written by the interrupt)
+ * @param handled The number of received messages that have been handled
+ */
+typedef struct {
+    uint32_t enqueued;
+    uint32_t sent;
+    uint32_t failed;
+    uint32_t dropped_busy;
+    uint32_t dropped_overrun;
+    _VOLATILE uint32_t received;
+    _VOLATILE uint32_t rx_dropped_overrun;
+    uint32_t handled;
+} CanCommMessageStats;
+
+/**
+ * @brief Statistics of the CAN communication
+ *
+ * @param messages The statistics of each message
+ * @param tx_latency Histogram of the time spent by the messages inside the transmission buffer
+ * @param rx_latency Histogram of the time spent by the messages inside the reception buffer
+ * @param tx_high_water The maximum number of messages inside the transmission buffer
+ * @param rx_high_water The maximum number of messages inside the reception buffer
+ */
+typedef struct {
+    CanCommMessageStats messages[CAN_NETWORK_COUNT][CAN_COMM_MESSAGE_COUNT];
+    uint32_t tx_latency[CAN_COMM_LATENCY_HISTOGRAM_SIZE];
+    uint32_t rx_latency[CAN_COMM_LATENCY_HISTOGRAM_SIZE];
+    size_t tx_high_water;
+    size_t rx_high_water;
+} CanCommStats;
+
 /**
  * @brief Union used to choose the CAN payload based on transmission or reception
  *
@@ -159,12 +304,14 @@ typedef union {
  * @param network The CAN network used to communicate
  * @param index Index mapped to the CAN identifier
  * @param frame_type The frame type
+ * @param timestamp The time in ticks when the message was added to the buffer
  * @param payload A pointer to the actual content of the message
  */
 typedef struct {
     CanNetwork network;
     can_index_t index;
     CanFrameType frame_type;
+    ticks_t timestamp;
     CanPayload payload;
 } CanMessage;
 
@@ -200,10 +347,30 @@ typedef CanCommReturnCode (* can_comm_transmit_callback_t)(
  * @param rx_busy Reception messages flags to check if the message has not already been handled
  * @param tx_buf Transmission messages circular buffer
  * @param rx_buf Reception messages circular buffer
+ * @param rx_fast_buf Safety-critical messages waiting to be handled by the fast routine
  * @param send A pointer to the callback used to send the data via CAN
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
+ * @param rx_latency_max The maximum time in ticks elapsed between the reception of a message and its handling
+ * @param rx_fast_latency_max The maximum time in ticks elapsed between the reception of a safety-critical message and its handling
+ * @param rx_timestamp The reception time in ticks of the message that is being handled
+ * @param stats The CAN communication statistics
+ * @param stats_network The network of the next message statistics sent via CAN
+ * @param stats_index The index of the next message statistics sent via CAN
+ * @param stats_bin The next latency histograms bin sent via CAN
+ * @param stats_can_payload The canlib payload of the messages statistics
+ * @param buffers_can_payload The canlib payload of the buffers statistics
+ * @param gateway The gateway routes
+ * @param gateway_route The route identifier for each BMS message (CAN_COMM_GATEWAY_ID_COUNT if not forwarded)
+ * @param gateway_buf Raw frames waiting to be forwarded to the primary network
+ * @param gateway_frame The frame taken from the gateway buffer that is being sent
+ * @param gateway_pending True if the gateway frame could not be sent yet
  * @param rx_device The reception canlib message handler
  * @param rx_raw The reception raw data of the message
  * @param rx_conv The reception converted data of the message
+ * @param rx_fast_device The canlib message handler used by the fast routine
+ * @param rx_fast_raw The raw data of the message handled by the fast routine
+ * @param rx_fast_conv The converted data of the message handled by the fast routine
  */
 typedef struct {
     bit_flag8_t enabled;
@@ -211,13 +378,43 @@ typedef struct {
     bool rx_busy[CAN_NETWORK_COUNT][CAN_COMM_MESSAGE_COUNT];
     RingBuffer(CanMessage, CAN_COMM_TX_BUFFER_BYTE_SIZE) tx_buf;
     RingBuffer(CanMessage, CAN_COMM_RX_BUFFER_BYTE_SIZE) rx_buf;
+    RingBuffer(CanMessage, CAN_COMM_RX_FAST_BUFFER_SIZE) rx_fast_buf;
 
     can_comm_transmit_callback_t send;
+    interrupt_critical_section_enter_t cs_enter;
+    interrupt_critical_section_exit_t cs_exit;
+
+    ticks_t rx_latency_max;
+    ticks_t rx_fast_latency_max;
+    ticks_t rx_timestamp;
+
+    CanCommStats stats;
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    CanNetwork stats_network;
+    can_index_t stats_index;
+    size_t stats_bin;
+    primary_hv_debug_can_stats_converted_t stats_can_payload;
+    primary_hv_debug_can_buffers_converted_t buffers_can_payload;
+
+    CanCommGatewayRoute gateway[CAN_COMM_GATEWAY_ID_COUNT];
+    CanCommGatewayId gateway_route[bms_MESSAGE_COUNT];
+    RingBuffer(CanCommRawFrame, CAN_COMM_GATEWAY_BUFFER_SIZE) gateway_buf;
+    CanCommRawFrame gateway_frame;
+    bool gateway_pending;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
 
     // Canlib devices
     device_t rx_device;
     uint8_t rx_raw[bms_MAX_STRUCT_SIZE_RAW];
     uint8_t rx_conv[bms_MAX_STRUCT_SIZE_CONVERSION];
+
+    /*
+     * A separate device is needed because the fast routine can run while
+     * a message decoded with the device above is being handled
+     */
+    device_t rx_fast_device;
+    uint8_t rx_fast_raw[bms_MAX_STRUCT_SIZE_RAW];
+    uint8_t rx_fast_conv[bms_MAX_STRUCT_SIZE_CONVERSION];
 } _CanCommHandler;
 
 /**
@@ -240,12 +437,18 @@ typedef void (* deserialize_from_id_t)(device_t *, uint16_t, uint8_t *);
  * @brief Initialize the CAN communication handler structure
  *
  * @param send The callback of a function that should send the data via a CAN network
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
  *
  * @return CanCommReturnCode
  *     - CAN_COMM_NULL_POINTER a NULL pointer was given as parameter
  *     - CAN_COMM_OK otherwise
  */
-CanCommReturnCode can_comm_init(const can_comm_transmit_callback_t send);
+CanCommReturnCode can_comm_init(
+    const can_comm_transmit_callback_t send,
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit
+);
 
 /** @brief Enable the CAN manager */
 void can_comm_enable_all(void);
@@ -345,6 +548,10 @@ CanCommReturnCode can_comm_tx_add(
  * @brief Add a message to the reception buffer
  *
  * @details The message will be handled afterwards inside the routine
+ * @details Safety-critical messages (fast path) are added to a separate buffer
+ * which is emptied by the fast routine before any other work
+ *
+ * @attention This function is called from the CAN reception interrupt, no handler is executed here
  *
  * @param network The canlib network to select
  * @param index The CAN index mapped to its identifier
@@ -368,6 +575,98 @@ CanCommReturnCode can_comm_rx_add(
     const size_t size
 );
 
+/**
+ * @brief Get a pointer to the CAN communication statistics
+ *
+ * @return const CanCommStats* A pointer to the statistics
+ */
+const CanCommStats * can_comm_get_stats(void);
+
+/**
+ * @brief Get a pointer to the statistics of a single message
+ *
+ * @param network The canlib network of the message
+ * @param index The canlib index of the message
+ *
+ * @return const CanCommMessageStats* A pointer to the message statistics or NULL if the message is not valid
+ */
+const CanCommMessageStats * can_comm_get_message_stats(const CanNetwork network, const can_index_t index);
+
+/** @brief Reset all the CAN communication statistics */
+void can_comm_reset_stats(void);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload of the messages statistics
+ *
+ * @details Every call returns the statistics of the next message that has been
+ * either sent or received at least once
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_debug_can_stats_converted_t* A pointer to the payload
+ */
+primary_hv_debug_can_stats_converted_t * can_comm_get_stats_canlib_payload(size_t * const byte_size);
+
+/**
+ * @brief Get a pointer to the CAN payload of the buffers statistics
+ *
+ * @details Every call returns the next bin of the latency histograms
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_debug_can_buffers_converted_t* A pointer to the payload
+ */
+primary_hv_debug_can_buffers_converted_t * can_comm_get_buffers_canlib_payload(size_t * const byte_size);
+
+/**
+ * @brief Enable or disable a single gateway route
+ *
+ * @param id The route identifier
+ * @param enabled True to enable the route, false to disable
+ *
+ * @return CanCommReturnCode
+ *     - CAN_COMM_INVALID_INDEX the given identifier does not exists
+ *     - CAN_COMM_OK otherwise
+ */
+CanCommReturnCode can_comm_gateway_set_enable(const CanCommGatewayId id, const bool enabled);
+
+/**
+ * @brief Check if a gateway route is enabled
+ *
+ * @param id The route identifier
+ *
+ * @return bool True if the route is enabled, false otherwise
+ */
+bool can_comm_gateway_is_enabled(const CanCommGatewayId id);
+
+/**
+ * @brief Get the number of failed transmissions of a gateway route
+ *
+ * @param id The route identifier
+ *
+ * @return uint32_t The number of failed transmissions
+ */
+uint32_t can_comm_gateway_get_failed(const CanCommGatewayId id);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Handle the safety-critical messages (fast path) received so far
+ *
+ * @details The routine is executed before the timebase tasks in every iteration
+ * of the main loop and before every frame handled by the CAN routine, so those
+ * messages never wait for a long transmission or reception drain
+ *
+ * @attention This function must not be called from an interrupt
+ *
+ * @return CanCommReturnCode
+ *     - CAN_COMM_DISABLED the reception is not enabled
+ *     - CAN_COMM_OK otherwise
+ */
+CanCommReturnCode can_comm_fast_routine(void);
+
 /**
  * @brief Routine used to manage the sent or received can data
  *
@@ -378,9 +677,36 @@ CanCommReturnCode can_comm_rx_add(
  */
 CanCommReturnCode can_comm_routine(void);
 
+/**
+ * @brief Get the maximum time elapsed between the reception of a message
+ * and its handling inside the routine
+ *
+ * @details Messages handled in the fast path are not taken into account
+ *
+ * @return ticks_t The maximum latency in ticks
+ */
+ticks_t can_comm_get_rx_latency_max(void);
+
+/**
+ * @brief Get the maximum time elapsed between the reception of a
+ * safety-critical message and its handling inside the fast routine
+ *
+ * @return ticks_t The maximum latency in ticks
+ */
+ticks_t can_comm_get_rx_fast_latency_max(void);
+
+/**
+ * @brief Get the time of reception of the message that is currently being handled
+ *
+ * @attention This function should only be called from inside a message handler
+ *
+ * @return ticks_t The reception time in ticks
+ */
+ticks_t can_comm_get_rx_timestamp(void);
+
 #else  // CONF_CAN_COMM_MODULE_ENABLE
 
-#define can_comm_init(send) (CAN_COMM_OK)
+#define can_comm_init(send, cs_enter, cs_exit) (CAN_COMM_OK)
 #define can_comm_enable_all() CELLBOARD_NOPE()
 #define can_comm_disable_all() CELLBOARD_NOPE()
 #define can_comm_is_enabled_all() (false)
@@ -390,7 +716,19 @@ CanCommReturnCode can_comm_routine(void);
 #define can_comm_send_immidiate(index, frame_type, data, size) (CAN_COMM_OK)
 #define can_comm_tx_add(network, index, frame_type, data, size) (CAN_COMM_OK)
 #define can_comm_rx_add(network, index, frame_type, data, size) (CAN_COMM_OK)
+#define can_comm_get_stats() (NULL)
+#define can_comm_get_message_stats(network, index) (NULL)
+#define can_comm_reset_stats() CELLBOARD_NOPE()
+#define can_comm_get_stats_canlib_payload(byte_size) (NULL)
+#define can_comm_get_buffers_canlib_payload(byte_size) (NULL)
+#define can_comm_gateway_set_enable(id, enabled) (CAN_COMM_OK)
+#define can_comm_gateway_is_enabled(id) (false)
+#define can_comm_gateway_get_failed(id) (0U)
+#define can_comm_fast_routine() (CAN_COMM_OK)
 #define can_comm_routine() (CAN_COMM_OK)
+#define can_comm_get_rx_latency_max() (0U)
+#define can_comm_get_rx_fast_latency_max() (0U)
+#define can_comm_get_rx_timestamp() (0U)
 
 #endif // CONF_CAN_COMM_MODULE_ENABLE
 
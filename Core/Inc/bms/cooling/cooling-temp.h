@@ -42,6 +42,37 @@
 #define COOLING_TEMP_COEFF_5 (- 30.5363f)
 #define COOLING_TEMP_COEFF_6 (   3.0394f)
 
+/**
+ * @brief Evaluate the conversion polynomial with the Horner method
+ *
+ * @details Only used to compute the lookup table at compile time
+ *
+ * @param VALUE The voltage in V
+ */
+#define COOLING_TEMP_POLYNOMIAL(VALUE) \
+    ((double)COOLING_TEMP_COEFF_0 + (double)(VALUE) * \
+    ((double)COOLING_TEMP_COEFF_1 + (double)(VALUE) * \
+    ((double)COOLING_TEMP_COEFF_2 + (double)(VALUE) * \
+    ((double)COOLING_TEMP_COEFF_3 + (double)(VALUE) * \
+    ((double)COOLING_TEMP_COEFF_4 + (double)(VALUE) * \
+    ((double)COOLING_TEMP_COEFF_5 + (double)(VALUE) * \
+     (double)COOLING_TEMP_COEFF_6))))))
+
+/**
+ * @brief Number of segments of the lookup table used to convert the voltages
+ *
+ * @details The table samples the polynomial at equally spaced voltages between
+ * the limits and the values in between are linearly interpolated
+ *
+ * @details The maximum error from the polynomial is 0.19 °C over the whole
+ * voltage range, near 0 V where the polynomial is steepest, and 0.03 °C
+ * inside the allowed temperature range
+ */
+#define COOLING_TEMP_LUT_SEGMENT_COUNT (64U)
+
+/** @brief Voltage between two consecutive values of the lookup table in V */
+#define COOLING_TEMP_LUT_STEP_V ((COOLING_TEMP_MAX_LIMIT_V - COOLING_TEMP_MIN_LIMIT_V) / COOLING_TEMP_LUT_SEGMENT_COUNT)
+
 /**
  * @brief Return code for the cooling temperature module functions
  *
@@ -156,6 +187,13 @@ celsius_t cooling_temp_get_sum(void);
  */
 celsius_t cooling_temp_get_avg(void);
 
+/**
+ * @brief Get the standard deviation of the temperatures of the cooling loop
+ *
+ * @return celsius_t The sample standard deviation in °C
+ */
+celsius_t cooling_temp_get_std(void);
+
 /**
  * @brief Get a pointer to the CAN payload of the cooling temperatures
  *
@@ -174,6 +212,7 @@ primary_hv_cooling_temperature_converted_t * cooling_temp_get_temperatures_canli
 #define cooling_temp_get_max() (NULL)
 #define cooling_temp_get_sum() (NULL)
 #define cooling_temp_get_avg() (NULL)
+#define cooling_temp_get_std() (0.0f)
 #define cooling_temp_get_temperatures_canlib_payload(byte_size) (NULL)
 
 #endif  // CONF_COOLING_TEMPERATURE_MODULE_ENABLE
@@ -47,14 +47,23 @@
  */
 #define CURRENT_SENSOR_STARTUP_TIME_MS (400U)
 
+/**
+ * @brief Number of current samples kept to align the current with other measurements
+ *
+ * @details With the sensor sending a new value every 10 ms the history covers the last 160 ms
+ */
+#define CURRENT_HISTORY_SIZE (16U)
+
 /**
  * @brief Return code for the current module functions
  *
  * @details
  *     - CURRENT_OK the function executed succefully
+ *     - CURRENT_NULL_POINTER a NULL pointer is given as parameter
  */
 typedef enum {
-    CURRENT_OK
+    CURRENT_OK,
+    CURRENT_NULL_POINTER
 } CurrentReturnCode;
 
 /**
@@ -62,13 +71,26 @@ typedef enum {
  *
  * @attention This structure should not be used outside of this module
  *
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
  * @param current The current value in A
+ * @param history The last received current values in A
+ * @param history_time The reception time of the values of the history in ticks
+ * @param history_head The index of the next value of the history to write
+ * @param history_count The number of valid values of the history
  * @param sensor_wdg Watchdog used to check if the current sensor is connected
  * @param current_can_payload The canlib payload used to send the current value via CAN
  * @param power_can_payload The canlib payload used to send the power value via CAN
  */
 typedef struct {
+    interrupt_critical_section_enter_t cs_enter;
+    interrupt_critical_section_exit_t cs_exit;
+
     ampere_t current;    
+    ampere_t history[CURRENT_HISTORY_SIZE];
+    ticks_t history_time[CURRENT_HISTORY_SIZE];
+    _VOLATILE size_t history_head;
+    _VOLATILE size_t history_count;
 
     Watchdog sensor_wdg;
 
@@ -81,10 +103,17 @@ typedef struct {
 /**
  * @brief Initialize the internal current structure handler
  *
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
+ *
  * @return CurrentReturnCode
- *     - CURRENT_OK
+ *     - CURRENT_NULL_POINTER if any of the parameters is NULL
+ *     - CURRENT_OK otherwise
  */
-CurrentReturnCode current_init(void);
+CurrentReturnCode current_init(
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit
+);
 
 /**
  * @brief Get the supplied current in A
@@ -93,6 +122,19 @@ CurrentReturnCode current_init(void);
  */
 ampere_t current_get_current(void);
 
+/**
+ * @brief Get the current in A at a given time
+ *
+ * @details The value is linearly interpolated between the two received values
+ * closest to the given time, if the time is outside of the range of the history
+ * the oldest or the newest value is returned instead
+ *
+ * @param timestamp The time in ticks
+ *
+ * @return ampere_t The current in A
+ */
+ampere_t current_get_current_at(const ticks_t timestamp);
+
 /**
  * @brief Get the calculated power value in kW
  *
@@ -115,10 +157,24 @@ WatchdogReturnCode current_start_sensor_communication_watchdog(void);
 /**
  * @brief Handle the received response from the current sensor
  *
+ * @details The current and power values are checked against their limits
+ *
+ * @details This function is called by the CAN fast routine
+ *
  * @param payload A pointer to the canlib payload of the response
  */
 void current_handle(bms_ivt_msg_result_i_t * const payload);
 
+/**
+ * @brief Notify that a response from the current sensor was received
+ *
+ * @details The sensor watchdog is reset by the CAN routine, after every
+ * other message received before this one
+ *
+ * @param payload A pointer to the canlib payload of the response
+ */
+void current_sensor_communication_handle(bms_ivt_msg_result_i_t * const payload);
+
 /**
  * @brief Get a pointer to the CAN payload of the current
  * 
@@ -139,11 +195,13 @@ primary_hv_power_converted_t * current_get_power_canlib_payload(size_t * const b
 
 #else  // CONF_CURRENT_MODULE_ENABLE
 
-#define current_init() (CURRENT_OK)
+#define current_init(cs_enter, cs_exit) (CURRENT_OK)
 #define current_get_current() (0.f)
+#define current_get_current_at(timestamp) (0.f)
 #define current_get_power() (0.f)
 #define current_start_sensor_communication_watchdog() (WATCHDOG_OK)
 #define current_handle(payload) CELLBOARD_NOPE()
+#define current_sensor_communication_handle(payload) CELLBOARD_NOPE()
 #define current_get_current_canlib_payload(byte_size) (NULL)
 #define current_get_power_canlib_payload(byte_size) (NULL)
 
@@ -0,0 +1,184 @@
+/**
+ * @file m95256.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief M95256 256-Kbit SPI EEPROM driver
+ *
+ * @details The instruction set is the one shared by most of the 25xx series
+ * SPI EEPROMs with a 16-bit address, so other chips can be used by changing the
+ * size and page size macros
+ */
+
+#ifndef M95256_H
+#define M95256_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mainboard-def.h"
+
+/** @brief Total size of the memory in bytes */
+#define M95256_SIZE (32768U)
+
+/**
+ * @brief Size of a single page in bytes
+ *
+ * @details A single write operation can not cross a page boundary
+ */
+#define M95256_PAGE_SIZE (64U)
+
+/** @brief Maximum time needed by the chip to complete a write cycle in ms */
+#define M95256_WRITE_TIME_MS (5U)
+
+/** @brief Number of bytes of an instruction followed by an address */
+#define M95256_COMMAND_BYTE_SIZE (3U)
+
+/** @brief Type definition for a memory address */
+typedef uint16_t m95256_address_t;
+
+/**
+ * @brief Return code for the M95256 module functions
+ *
+ * @details
+ *     - M95256_OK the function executed succesfully
+ *     - M95256_NULL_POINTER a NULL pointer was given to a function
+ *     - M95256_OUT_OF_BOUNDS the memory region is outside of the chip or crosses a page boundary
+ *     - M95256_BUSY a write cycle is still in progress
+ */
+typedef enum {
+    M95256_OK,
+    M95256_NULL_POINTER,
+    M95256_OUT_OF_BOUNDS,
+    M95256_BUSY
+} M95256ReturnCode;
+
+/**
+ * @brief Instruction codes of the chip
+ *
+ * @details
+ *     - M95256_INSTRUCTION_WREN enable the write operations
+ *     - M95256_INSTRUCTION_WRDI disable the write operations
+ *     - M95256_INSTRUCTION_RDSR read the status register
+ *     - M95256_INSTRUCTION_WRSR write the status register
+ *     - M95256_INSTRUCTION_READ read from the memory array
+ *     - M95256_INSTRUCTION_WRITE write to the memory array
+ */
+typedef enum {
+    M95256_INSTRUCTION_WREN = 0x06U,
+    M95256_INSTRUCTION_WRDI = 0x04U,
+    M95256_INSTRUCTION_RDSR = 0x05U,
+    M95256_INSTRUCTION_WRSR = 0x01U,
+    M95256_INSTRUCTION_READ = 0x03U,
+    M95256_INSTRUCTION_WRITE = 0x02U
+} M95256Instruction;
+
+/**
+ * @brief Bits of the status register
+ *
+ * @details
+ *     - M95256_STATUS_WIP write in progress
+ *     - M95256_STATUS_WEL write enable latch
+ *     - M95256_STATUS_BP0 first block protect bit
+ *     - M95256_STATUS_BP1 second block protect bit
+ *     - M95256_STATUS_SRWD status register write protect
+ */
+typedef enum {
+    M95256_STATUS_WIP = 0U,
+    M95256_STATUS_WEL = 1U,
+    M95256_STATUS_BP0 = 2U,
+    M95256_STATUS_BP1 = 3U,
+    M95256_STATUS_SRWD = 7U
+} M95256Status;
+
+/**
+ * @brief Handler structure for the M95256 EEPROM
+ *
+ * @param send A pointer to the callback used to send data via SPI
+ * @param send_receive A pointer to the callback used to send and receive data via SPI
+ * @param buffer The buffer used to send the write command
+ */
+typedef struct {
+    spi_send_callback_t send;
+    spi_send_receive_callback_t send_receive;
+
+    uint8_t buffer[M95256_COMMAND_BYTE_SIZE + M95256_PAGE_SIZE];
+} M95256Handler;
+
+/**
+ * @brief Initialize the M95256 handler structure
+ *
+ * @param handler The EEPROM handler structure
+ * @param send A pointer to the callback used to send data via SPI
+ * @param send_receive A pointer to the callback used to send and receive data via SPI
+ *
+ * @return M95256ReturnCode
+ *     - M95256_NULL_POINTER if any of the parameter is NULL
+ *     - M95256_OK otherwise
+ */
+M95256ReturnCode m95256_init(
+    M95256Handler * const handler,
+    const spi_send_callback_t send,
+    const spi_send_receive_callback_t send_receive
+);
+
+/**
+ * @brief Check if a write cycle is in progress
+ *
+ * @details While the chip is busy every instruction except the status register read is ignored
+ *
+ * @param handler A pointer to the EEPROM handler structure
+ *
+ * @return bool True if the chip is busy, false otherwise
+ */
+bool m95256_is_busy(M95256Handler * const handler);
+
+/**
+ * @brief Read a region of the memory
+ *
+ * @details The region can cross the page boundaries
+ *
+ * @param handler A pointer to the EEPROM handler structure
+ * @param address The address of the first byte to read
+ * @param out[out] A pointer to the array where the data is stored
+ * @param size The number of bytes to read
+ *
+ * @return M95256ReturnCode
+ *     - M95256_NULL_POINTER if any of the parameter is NULL
+ *     - M95256_OUT_OF_BOUNDS if the region exceeds the size of the memory
+ *     - M95256_BUSY if a write cycle is in progress
+ *     - M95256_OK otherwise
+ */
+M95256ReturnCode m95256_read(
+    M95256Handler * const handler,
+    const m95256_address_t address,
+    uint8_t * const out,
+    const size_t size
+);
+
+/**
+ * @brief Write data inside a single page of the memory
+ *
+ * @details The function does not wait for the end of the write cycle,
+ * use m95256_is_busy to check when the chip is ready again
+ *
+ * @param handler A pointer to the EEPROM handler structure
+ * @param address The address of the first byte to write
+ * @param data A pointer to the data to write
+ * @param size The number of bytes to write
+ *
+ * @return M95256ReturnCode
+ *     - M95256_NULL_POINTER if any of the parameter is NULL
+ *     - M95256_OUT_OF_BOUNDS if the region crosses a page boundary or exceeds the size of the memory
+ *     - M95256_BUSY if a write cycle is in progress
+ *     - M95256_OK otherwise
+ */
+M95256ReturnCode m95256_write_page(
+    M95256Handler * const handler,
+    const m95256_address_t address,
+    const uint8_t * const data,
+    const size_t size
+);
+
+#endif  // M95256_H
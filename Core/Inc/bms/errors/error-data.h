@@ -0,0 +1,145 @@
+/**
+ * @file error-data.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Error groups and their constant properties
+ *
+ * @attention This file is generated from errors.json by the
+ * generate-error-handler.py script, do not modify it manually
+ */
+
+#ifndef ERROR_DATA_H
+#define ERROR_DATA_H
+
+#include <stdint.h>
+
+#include "mainboard-def.h"
+
+#include "bms_network.h"
+
+/** @brief Error instances count for each group */
+#define ERROR_POST_INSTANCE_COUNT (1U)
+#define ERROR_OVER_CURRENT_INSTANCE_COUNT (1U)
+#define ERROR_OVER_POWER_INSTANCE_COUNT (1U)
+#define ERROR_UNDER_VOLTAGE_INSTANCE_COUNT (CELLBOARD_SERIES_COUNT)
+#define ERROR_OVER_VOLTAGE_INSTANCE_COUNT (CELLBOARD_SERIES_COUNT)
+#define ERROR_UNDER_TEMPERATURE_INSTANCE_COUNT (CELLBOARD_TEMP_SENSOR_COUNT)
+#define ERROR_OVER_TEMPERATURE_INSTANCE_COUNT (CELLBOARD_TEMP_SENSOR_COUNT)
+#define ERROR_CAN_COMMUNICATION_INSTANCE_COUNT (CAN_NETWORK_COUNT)
+#define ERROR_CURRENT_SENSOR_COMMUNICATION_INSTANCE_COUNT (1U)
+#define ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT (COOLING_TEMP_SENSOR_COUNT)
+#define ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT (COOLING_TEMP_SENSOR_COUNT)
+#define ERROR_CELLBOARD_ERROR_INSTANCE_COUNT (CELLBOARD_COUNT)
+
+/** @brief Number of 32-bit words needed to store the flags of a group of instances */
+#define ERROR_BITSET_SIZE(COUNT) (((COUNT) + 31U) / 32U)
+
+/** @brief Index of the first 32-bit word of each group inside the instances flags */
+#define ERROR_POST_BITSET_OFFSET (0U)
+#define ERROR_OVER_CURRENT_BITSET_OFFSET (ERROR_POST_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_POST_INSTANCE_COUNT))
+#define ERROR_OVER_POWER_BITSET_OFFSET (ERROR_OVER_CURRENT_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_OVER_CURRENT_INSTANCE_COUNT))
+#define ERROR_UNDER_VOLTAGE_BITSET_OFFSET (ERROR_OVER_POWER_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_OVER_POWER_INSTANCE_COUNT))
+#define ERROR_OVER_VOLTAGE_BITSET_OFFSET (ERROR_UNDER_VOLTAGE_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_UNDER_VOLTAGE_INSTANCE_COUNT))
+#define ERROR_UNDER_TEMPERATURE_BITSET_OFFSET (ERROR_OVER_VOLTAGE_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_OVER_VOLTAGE_INSTANCE_COUNT))
+#define ERROR_OVER_TEMPERATURE_BITSET_OFFSET (ERROR_UNDER_TEMPERATURE_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_UNDER_TEMPERATURE_INSTANCE_COUNT))
+#define ERROR_CAN_COMMUNICATION_BITSET_OFFSET (ERROR_OVER_TEMPERATURE_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_OVER_TEMPERATURE_INSTANCE_COUNT))
+#define ERROR_CURRENT_SENSOR_COMMUNICATION_BITSET_OFFSET (ERROR_CAN_COMMUNICATION_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_CAN_COMMUNICATION_INSTANCE_COUNT))
+#define ERROR_COOLING_UNDER_TEMPERATURE_BITSET_OFFSET (ERROR_CURRENT_SENSOR_COMMUNICATION_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_CURRENT_SENSOR_COMMUNICATION_INSTANCE_COUNT))
+#define ERROR_COOLING_OVER_TEMPERATURE_BITSET_OFFSET (ERROR_COOLING_UNDER_TEMPERATURE_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT))
+#define ERROR_CELLBOARD_ERROR_BITSET_OFFSET (ERROR_COOLING_OVER_TEMPERATURE_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT))
+
+/** @brief Number of 32-bit words needed to store the flags of all the groups */
+#define ERROR_BITSET_TOTAL_SIZE (ERROR_CELLBOARD_ERROR_BITSET_OFFSET + ERROR_BITSET_SIZE(ERROR_CELLBOARD_ERROR_INSTANCE_COUNT))
+
+/** @brief Number of set counters of each group, only the groups with a threshold have them */
+#define ERROR_POST_COUNTER_COUNT (0U)
+#define ERROR_OVER_CURRENT_COUNTER_COUNT (ERROR_OVER_CURRENT_INSTANCE_COUNT)
+#define ERROR_OVER_POWER_COUNTER_COUNT (ERROR_OVER_POWER_INSTANCE_COUNT)
+#define ERROR_UNDER_VOLTAGE_COUNTER_COUNT (0U)
+#define ERROR_OVER_VOLTAGE_COUNTER_COUNT (0U)
+#define ERROR_UNDER_TEMPERATURE_COUNTER_COUNT (0U)
+#define ERROR_OVER_TEMPERATURE_COUNTER_COUNT (0U)
+#define ERROR_CAN_COMMUNICATION_COUNTER_COUNT (ERROR_CAN_COMMUNICATION_INSTANCE_COUNT)
+#define ERROR_CURRENT_SENSOR_COMMUNICATION_COUNTER_COUNT (0U)
+#define ERROR_COOLING_UNDER_TEMPERATURE_COUNTER_COUNT (ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT)
+#define ERROR_COOLING_OVER_TEMPERATURE_COUNTER_COUNT (ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT)
+#define ERROR_CELLBOARD_ERROR_COUNTER_COUNT (ERROR_CELLBOARD_ERROR_INSTANCE_COUNT)
+
+/** @brief Index of the first set counter of each group */
+#define ERROR_POST_COUNTER_OFFSET (0U)
+#define ERROR_OVER_CURRENT_COUNTER_OFFSET (ERROR_POST_COUNTER_OFFSET + ERROR_POST_COUNTER_COUNT)
+#define ERROR_OVER_POWER_COUNTER_OFFSET (ERROR_OVER_CURRENT_COUNTER_OFFSET + ERROR_OVER_CURRENT_COUNTER_COUNT)
+#define ERROR_UNDER_VOLTAGE_COUNTER_OFFSET (ERROR_OVER_POWER_COUNTER_OFFSET + ERROR_OVER_POWER_COUNTER_COUNT)
+#define ERROR_OVER_VOLTAGE_COUNTER_OFFSET (ERROR_UNDER_VOLTAGE_COUNTER_OFFSET + ERROR_UNDER_VOLTAGE_COUNTER_COUNT)
+#define ERROR_UNDER_TEMPERATURE_COUNTER_OFFSET (ERROR_OVER_VOLTAGE_COUNTER_OFFSET + ERROR_OVER_VOLTAGE_COUNTER_COUNT)
+#define ERROR_OVER_TEMPERATURE_COUNTER_OFFSET (ERROR_UNDER_TEMPERATURE_COUNTER_OFFSET + ERROR_UNDER_TEMPERATURE_COUNTER_COUNT)
+#define ERROR_CAN_COMMUNICATION_COUNTER_OFFSET (ERROR_OVER_TEMPERATURE_COUNTER_OFFSET + ERROR_OVER_TEMPERATURE_COUNTER_COUNT)
+#define ERROR_CURRENT_SENSOR_COMMUNICATION_COUNTER_OFFSET (ERROR_CAN_COMMUNICATION_COUNTER_OFFSET + ERROR_CAN_COMMUNICATION_COUNTER_COUNT)
+#define ERROR_COOLING_UNDER_TEMPERATURE_COUNTER_OFFSET (ERROR_CURRENT_SENSOR_COMMUNICATION_COUNTER_OFFSET + ERROR_CURRENT_SENSOR_COMMUNICATION_COUNTER_COUNT)
+#define ERROR_COOLING_OVER_TEMPERATURE_COUNTER_OFFSET (ERROR_COOLING_UNDER_TEMPERATURE_COUNTER_OFFSET + ERROR_COOLING_UNDER_TEMPERATURE_COUNTER_COUNT)
+#define ERROR_CELLBOARD_ERROR_COUNTER_OFFSET (ERROR_COOLING_OVER_TEMPERATURE_COUNTER_OFFSET + ERROR_COOLING_OVER_TEMPERATURE_COUNTER_COUNT)
+
+/** @brief Total number of set counters of all the groups */
+#define ERROR_COUNTER_TOTAL_COUNT (ERROR_CELLBOARD_ERROR_COUNTER_OFFSET + ERROR_CELLBOARD_ERROR_COUNTER_COUNT)
+
+/**
+ * @brief Type of the error that categorize a group of instances
+ *
+ * @details
+ *     - ERROR_GROUP_POST the Power On Self Test procedure failed
+ *     - ERROR_GROUP_OVER_CURRENT Too much current is flowing in/out from the pack
+ *     - ERROR_GROUP_OVER_POWER The power must not exceed 80 kW
+ *     - ERROR_GROUP_UNDER_VOLTAGE A cell voltage is below the minimum allowed value
+ *     - ERROR_GROUP_OVER_VOLTAGE A cell voltage is above the maximum allowed value
+ *     - ERROR_GROUP_UNDER_TEMPERATURE A cell temperature is below the minimum allowed value
+ *     - ERROR_GROUP_OVER_TEMPERATURE A cell temperature is above the maximum allowed value
+ *     - ERROR_GROUP_CAN_COMMUNICATION A CAN network can not transmit messages
+ *     - ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION The current sensor stopped sending its measurements
+ *     - ERROR_GROUP_COOLING_UNDER_TEMPERATURE A cooling temperature is below the minimum allowed value
+ *     - ERROR_GROUP_COOLING_OVER_TEMPERATURE A cooling temperature is above the maximum allowed value
+ *     - ERROR_GROUP_CELLBOARD_ERROR A cellboard has detected an error
+ */
+typedef enum {
+    ERROR_GROUP_POST,
+    ERROR_GROUP_OVER_CURRENT,
+    ERROR_GROUP_OVER_POWER,
+    ERROR_GROUP_UNDER_VOLTAGE,
+    ERROR_GROUP_OVER_VOLTAGE,
+    ERROR_GROUP_UNDER_TEMPERATURE,
+    ERROR_GROUP_OVER_TEMPERATURE,
+    ERROR_GROUP_CAN_COMMUNICATION,
+    ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION,
+    ERROR_GROUP_COOLING_UNDER_TEMPERATURE,
+    ERROR_GROUP_COOLING_OVER_TEMPERATURE,
+    ERROR_GROUP_CELLBOARD_ERROR,
+    ERROR_GROUP_COUNT
+} ErrorGroup;
+
+/** @brief Total number of instances for each group */
+extern const uint16_t error_instances[ERROR_GROUP_COUNT];
+
+/**
+ * @brief Time in ms after which each group expires
+ *
+ * @details A group with a zero timeout expires as soon as one of its instances is set
+ */
+extern const uint16_t error_timeouts[ERROR_GROUP_COUNT];
+
+/**
+ * @brief Number of consecutive sets after which an instance of each group becomes active
+ *
+ * @details The instances of a group without a threshold become active as soon as they are set
+ */
+extern const uint8_t error_thresholds[ERROR_GROUP_COUNT];
+
+/** @brief Index of the first 32-bit word of each group inside the instances flags */
+extern const uint16_t error_bitset_offsets[ERROR_GROUP_COUNT];
+
+/** @brief Index of the first set counter of each group */
+extern const uint16_t error_counter_offsets[ERROR_GROUP_COUNT];
+
+/** @brief Human readable name of each group */
+extern const char * const error_group_names[ERROR_GROUP_COUNT];
+
+#endif  // ERROR_DATA_H
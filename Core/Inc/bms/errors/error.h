@@ -3,37 +3,48 @@
  * @date 2024-07-12
  * @author Antonio Gelain [antonio.gelain2@gmail.com]
  *
- * @brief Simple wrapper for the error handler generated code
+ * @brief Error handling with timeouts based on a hardware timer
  */
 
 #ifndef ERROR_H
 #define ERROR_H
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
 #include "mainboard-def.h"
 #include "mainboard-conf.h"
 
-#include "errorlib.h"
-
 #include "bms_network.h"
 
 #include "primary_network.h"
+#include "error-data.h"
+
+/** @brief Interval between two messages of the error report in ms */
+#define ERROR_REPORT_INTERVAL_MS (10U)
+
+/** @brief Minimum time between the start of two error reports in ms, limits the bus load of flapping instances */
+#define ERROR_REPORT_MIN_INTERVAL_MS (100U)
+
+/** @brief Time after which the error report is sent again even if nothing changed in ms */
+#define ERROR_REPORT_KEEP_ALIVE_MS (500U)
 
-/** @brief Error instances count for each group */
-#define ERROR_POST_INSTANCE_COUNT (1U)
-#define ERROR_OVER_CURRENT_INSTANCE_COUNT (1U)
-#define ERROR_OVER_POWER_INSTANCE_COUNT (1U)
-#define ERROR_UNDER_VOLTAGE_INSTANCE_COUNT (CELLBOARD_SERIES_COUNT)
-#define ERROR_OVER_VOLTAGE_INSTANCE_COUNT (CELLBOARD_SERIES_COUNT)
-#define ERROR_UNDER_TEMPERATURE_INSTANCE_COUNT (CELLBOARD_TEMP_SENSOR_COUNT)
-#define ERROR_OVER_TEMPERATURE_INSTANCE_COUNT (CELLBOARD_TEMP_SENSOR_COUNT)
-#define ERROR_CAN_COMMUNICATION_INSTANCE_COUNT (CAN_NETWORK_COUNT)
-#define ERROR_CURRENT_SENSOR_COMMUNICATION_INSTANCE_COUNT (1U)
-#define ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT (COOLING_TEMP_SENSOR_COUNT)
-#define ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT (COOLING_TEMP_SENSOR_COUNT)
-#define ERROR_CELLBOARD_ERROR_INSTANCE_COUNT (CELLBOARD_COUNT)
+/** @brief Type definition for an error instance */
+typedef uint16_t error_instance_t;
+
+/**
+ * @brief Type definition for the callback used to start the error timer
+ *
+ * @details The timer should call error_expire when it elapses
+ *
+ * @param timestamp The time in which the error was set in ms
+ * @param timeout The time after which the error should expire in ms
+ */
+typedef void (* error_update_timer_callback_t)(const uint32_t timestamp, const uint16_t timeout);
 
-/** @brief Type redefinition for an error instance */
-typedef errorlib_error_instance_t error_instance_t;
+/** @brief Type definition for the callback used to stop the error timer */
+typedef void (* error_stop_timer_callback_t)(void);
 
 /**
  * @brief Return code for the error module functions
@@ -41,68 +52,209 @@ typedef errorlib_error_instance_t error_instance_t;
  * @details
  *     - ERROR_OK the function executed succesfully
  *     - ERROR_NULL_POINTER a NULL pointer was given to a function
+ *     - ERROR_OUT_OF_BOUNDS the group or the instance are not valid
  *     - ERROR_UNKNOWN unknown error
  */
 typedef enum {
     ERROR_OK,
     ERROR_NULL_POINTER,
+    ERROR_OUT_OF_BOUNDS,
     ERROR_UNKNOWN
 } ErrorReturnCode;
 
-/**
- * @brief Type of the error that categorize a group of instances
- *
- * @details
- *     - ERROR_GROUP_POST the Power On Self Test procedure failed
- *     - ERROR_GROUP_OVER_CURRENT no description
- *     - ERROR_GROUP_OVER_POWER The power must not exceed 80 kW
- *     - ERROR_GROUP_UNDER_VOLTAGE no description
- *     - ERROR_GROUP_OVER_VOLTAGE no description
- *     - ERROR_GROUP_UNDER_TEMPERATURE no description
- *     - ERROR_GROUP_OVER_TEMPERATURE no description
- *     - ERROR_GROUP_CAN_COMMUNICATION no description
- *     - ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION no description
- *     - ERROR_GROUP_COOLING_UNDER_TEMPERATURE no description
- *     - ERROR_GROUP_COOLING_OVER_TEMPERATURE no description
- *     - ERROR_GROUP_CELLBOARD_ERROR no description
-
- */
-typedef enum {
-    ERROR_GROUP_POST,
-    ERROR_GROUP_OVER_CURRENT,
-    ERROR_GROUP_OVER_POWER,
-    ERROR_GROUP_UNDER_VOLTAGE,
-    ERROR_GROUP_OVER_VOLTAGE,
-    ERROR_GROUP_UNDER_TEMPERATURE,
-    ERROR_GROUP_OVER_TEMPERATURE,
-    ERROR_GROUP_CAN_COMMUNICATION,
-    ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION,
-    ERROR_GROUP_COOLING_UNDER_TEMPERATURE,
-    ERROR_GROUP_COOLING_OVER_TEMPERATURE,
-    ERROR_GROUP_CELLBOARD_ERROR,
-    ERROR_GROUP_COUNT
-} ErrorGroup;
-
 typedef enum {
     ERROR_CAN_COMMUNICATION_INSTANCE_BMS,
     ERROR_CAN_COMMUNICATION_INSTANCE_PRIMARY,
     ERROR_CAN_COMMUNICATION_INSTANCE_SECONDARY
 } ErrorCanCommunicationInstance;
 
+/**
+ * @brief Information about the expired error
+ *
+ * @param group The group of the expired error
+ * @param instance The instance of the group that has been active for the longest time when it expired
+ * @param timestamp The time in which that instance became active in ms
+ */
+typedef struct {
+    ErrorGroup group;
+    error_instance_t instance;
+    milliseconds_t timestamp;
+} ErrorInfo;
+
+/**
+ * @brief Error handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @details The active instances of each group are stored as bits and the number of
+ * active instances is kept updated so that the state of a group can be checked in constant time.
+ * The instances of a group with a threshold become active only after that number of
+ * consecutive sets. A group starts its timeout when its first instance becomes active,
+ * restarts it from the reset time when the instance that started it is reset while others
+ * are still active and stops it when the last one is reset, the hardware timer is always
+ * set to the nearest timeout
+ *
+ * @details No time is stored for the single instances, so an instance that was already
+ * active when the timeout is restarted can expire up to twice the group timeout after it
+ * became active
+ *
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
+ * @param update_timer A pointer to the function used to start the error timer
+ * @param stop_timer A pointer to the function used to stop the error timer
+ * @param instances The flags of the active instances of all the groups
+ * @param count The number of active instances of each group
+ * @param counters The number of consecutive sets of each inactive instance of the groups with a threshold
+ * @param oldest The active instance of each group that started its current timeout
+ * @param timestamp The time in which the current timeout of each group started in ms
+ * @param running The flags of the groups that are active and waiting for the timeout
+ * @param scheduled The group whose timeout is set on the timer or ERROR_GROUP_COUNT if the timer is stopped
+ * @param expired True if an error is expired
+ * @param expired_info The information about the first expired error
+ * @param version Incremented each time an instance is set, reset or expires
+ * @param can_payload The canlib payload of the expired error
+ * @param reporting True if a report is being sent
+ * @param report_version The version of the flags copied for the last report
+ * @param report_timestamp The time in which the last report started in ms
+ * @param report_flags The copy of the instances flags being sent
+ * @param report_expired_group The expired group of the report or ERROR_GROUP_COUNT if none is expired
+ * @param report_group The group from which the next run of active instances is searched
+ * @param report_instance The instance from which the next run of active instances is searched
+ * @param report_can_payload The canlib payload of the error report
+ */
+typedef struct {
+    interrupt_critical_section_enter_t cs_enter;
+    interrupt_critical_section_exit_t cs_exit;
+    error_update_timer_callback_t update_timer;
+    error_stop_timer_callback_t stop_timer;
+
+    bit_flag32_t instances[ERROR_BITSET_TOTAL_SIZE];
+    uint16_t count[ERROR_GROUP_COUNT];
+    uint8_t counters[ERROR_COUNTER_TOTAL_COUNT];
+    error_instance_t oldest[ERROR_GROUP_COUNT];
+    milliseconds_t timestamp[ERROR_GROUP_COUNT];
+    bit_flag32_t running;
+    ErrorGroup scheduled;
+
+    _VOLATILE bool expired;
+    ErrorInfo expired_info;
+    uint16_t version;
+
+    primary_hv_error_converted_t can_payload;
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    bool reporting;
+    uint16_t report_version;
+    milliseconds_t report_timestamp;
+    bit_flag32_t report_flags[ERROR_BITSET_TOTAL_SIZE];
+    ErrorGroup report_expired_group;
+    ErrorGroup report_group;
+    error_instance_t report_instance;
+    primary_hv_error_report_converted_t report_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+} _ErrorHandler;
+
 #ifdef CONF_ERROR_MODULE_ENABLE
 
 /**
  * @brief Initialization of the internal error handler structure
+ *
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
+ * @param update_timer A pointer to the function used to start the error timer
+ * @param stop_timer A pointer to the function used to stop the error timer
+ *
+ * @return ErrorReturnCode
+ *     - ERROR_NULL_POINTER if any of the parameters are NULL
+ *     - ERROR_OK otherwise
+ */
+ErrorReturnCode error_init(
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit,
+    const error_update_timer_callback_t update_timer,
+    const error_stop_timer_callback_t stop_timer
+);
+
+/**
+ * @brief Set an error instance
+ *
+ * @details The instances of a group with a threshold become active only when they are
+ * set that number of consecutive times without being reset.
+ * If the instance is the first active one of its group the group timeout is started,
+ * groups with a zero timeout expire immediately
+ *
+ * @param group The error group
+ * @param instance The error instance
+ *
+ * @return ErrorReturnCode
+ *     - ERROR_OUT_OF_BOUNDS if the group or the instance are not valid
+ *     - ERROR_OK otherwise
  */
-ErrorReturnCode error_init(void);
 ErrorReturnCode error_set(const ErrorGroup group, const error_instance_t instance);
+
+/**
+ * @brief Reset an error instance
+ *
+ * @details The consecutive sets of the instance are cleared.
+ * If the instance is the last active one of its group the group timeout is stopped, if it
+ * is the oldest active one the timeout is restarted from the next oldest active instance
+ *
+ * @param group The error group
+ * @param instance The error instance
+ *
+ * @return ErrorReturnCode
+ *     - ERROR_OUT_OF_BOUNDS if the group or the instance are not valid
+ *     - ERROR_OK otherwise
+ */
 ErrorReturnCode error_reset(const ErrorGroup group, const error_instance_t instance);
-size_t error_get_expired(void);
+
+/**
+ * @brief Check if an error instance is active
+ *
+ * @param group The error group
+ * @param instance The error instance
+ *
+ * @return bool True if the instance is active, false otherwise
+ */
+bool error_is_active(const ErrorGroup group, const error_instance_t instance);
+
+/**
+ * @brief Get the number of active instances of a group
+ *
+ * @param group The error group
+ *
+ * @return size_t The number of active instances
+ */
+size_t error_get_active_count(const ErrorGroup group);
+
+/**
+ * @brief Check if any error is expired
+ *
+ * @details The flag is set once and never cleared
+ *
+ * @return bool True if an error is expired, false otherwise
+ */
+bool error_is_expired(void);
+
+/**
+ * @brief Get the information about the first expired error
+ *
+ * @return ErrorInfo The expired error information
+ */
 ErrorInfo error_get_expired_info(void);
 
+/**
+ * @brief Expire the groups whose timeout is elapsed and set the timer for the next one
+ *
+ * @attention This function should be called when the error timer elapses
+ */
+void error_expire(void);
+
 /**
  * @brief Handle cellboard error
  *
+ * @details This function is called by the CAN fast routine
+ *
  * @param payload the payload of the error message
  */
 void error_cellboard_handle(bms_cellboard_error_t * const payload);
@@ -116,9 +268,30 @@ void error_cellboard_handle(bms_cellboard_error_t * const payload);
  */
 primary_hv_error_converted_t * error_get_error_canlib_payload(size_t * const byte_size);
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload of the next message of the error report
+ *
+ * @details The report contains every active instance of each group encoded as runs
+ * of consecutive instances, up to two runs of the same group for each message, together
+ * with the expired group. The instances flags are copied when a report starts so
+ * that all the messages of a report are consistent.
+ * A new report starts when any instance changes, at most once every ERROR_REPORT_MIN_INTERVAL_MS
+ * so that the changes of that interval are sent together, and at least every
+ * ERROR_REPORT_KEEP_ALIVE_MS, if no instance is active a single message with no runs is sent
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_error_report_converted_t* A pointer to the payload or NULL if there is nothing to send
+ */
+primary_hv_error_report_converted_t * error_get_error_report_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 #ifdef CONF_ERROR_STRINGS_ENABLE
 
-char * error_get_group_name_string(const ErrorGroup group);
+const char * error_get_group_name_string(const ErrorGroup group);
 
 #else  // CONF_ERROR_STRINGS_ENABLE
 
@@ -128,13 +301,17 @@ char * error_get_group_name_string(const ErrorGroup group);
 
 #else  // CONF_ERROR_MODULE_ENABLE
 
-#define error_init() (ERROR_OK)
+#define error_init(cs_enter, cs_exit, update_timer, stop_timer) (ERROR_OK)
 #define error_set(group, instance) (ERROR_OK)
 #define error_reset(group, instance) (ERROR_OK)
-#define error_get_expired() (0U)
+#define error_is_active(group, instance) (false)
+#define error_get_active_count(group) (0U)
+#define error_is_expired() (false)
 #define error_get_expired_info() ((ErrorInfo){ 0U })
+#define error_expire() MAINBOARD_NOPE()
 #define error_cellboard_handle(payload) (NULL)
-#define error_get_error_canlib_payload(byte_size) (NULL);
+#define error_get_error_canlib_payload(byte_size) (NULL)
+#define error_get_error_report_canlib_payload(byte_size) (NULL)
 
 #endif // CONF_ERROR_MODULE_ENABLE
 
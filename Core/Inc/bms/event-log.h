@@ -0,0 +1,185 @@
+/**
+ * @file event-log.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Persistent log of the system events
+ *
+ * @details The events are pushed into a small queue in RAM and written
+ * one at a time inside the event log region of the EEPROM by the event log
+ * routine so that no producer ever waits for the EEPROM.
+ * If the queue is full the event is discarded and the number of discarded
+ * events is logged as soon as possible.
+ * The newest stored events can be dumped via CAN on request when the
+ * CONF_CANLIB_PENDING_MESSAGES_ENABLE option is defined
+ */
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "primary_network.h"
+#include "ring-buffer.h"
+
+/** @brief Maximum number of events waiting to be written */
+#define EVENT_LOG_QUEUE_SIZE (32U)
+
+/** @brief Interval between two messages of the dump in ms */
+#define EVENT_LOG_DUMP_INTERVAL_MS (10U)
+
+/**
+ * @brief Return code for the event log module functions
+ *
+ * @details
+ *     - EVENT_LOG_OK the function executed successfully
+ *     - EVENT_LOG_NULL_POINTER a NULL pointer is given as parameter
+ *     - EVENT_LOG_FULL the queue is full and the event has been discarded
+ */
+typedef enum {
+    EVENT_LOG_OK,
+    EVENT_LOG_NULL_POINTER,
+    EVENT_LOG_FULL
+} EventLogReturnCode;
+
+/**
+ * @brief Type of the logged events
+ *
+ * @details
+ *     - EVENT_LOG_TYPE_RESET the mainboard has been started
+ *     - EVENT_LOG_TYPE_ERROR_SET an error group became active (group, first active instance)
+ *     - EVENT_LOG_TYPE_ERROR_EXPIRED an error group expired (group, oldest active instance)
+ *     - EVENT_LOG_TYPE_FSM_TRANSITION the FSM changed state (previous state, next state)
+ *     - EVENT_LOG_TYPE_DROPPED some events have been discarded (none, number of events)
+ */
+typedef enum {
+    EVENT_LOG_TYPE_RESET,
+    EVENT_LOG_TYPE_ERROR_SET,
+    EVENT_LOG_TYPE_ERROR_EXPIRED,
+    EVENT_LOG_TYPE_FSM_TRANSITION,
+    EVENT_LOG_TYPE_DROPPED,
+    EVENT_LOG_TYPE_COUNT
+} EventLogType;
+
+/**
+ * @brief Single event as stored inside the EEPROM
+ *
+ * @param timestamp The time at which the event happened in ms
+ * @param type The type of the event
+ * @param data_0 The first argument of the event
+ * @param data_1 The second argument of the event
+ */
+typedef struct {
+    uint32_t timestamp;
+    uint8_t type;
+    uint8_t data_0;
+    uint16_t data_1;
+} EventLogRecord;
+
+/**
+ * @brief Event log handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
+ * @param queue The events waiting to be written
+ * @param dropped The number of discarded events not yet logged
+ * @param dump_sequence The sequence number of the next event to dump
+ * @param dump_end The sequence number of the last event to dump
+ * @param event_log_can_payload The canlib payload of the dumped event
+ */
+typedef struct {
+    interrupt_critical_section_enter_t cs_enter;
+    interrupt_critical_section_exit_t cs_exit;
+
+    RingBuffer(EventLogRecord, EVENT_LOG_QUEUE_SIZE) queue;
+    uint16_t dropped;
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    uint32_t dump_sequence;
+    uint32_t dump_end;
+    primary_hv_event_log_converted_t event_log_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+} _EventLogHandler;
+
+#ifdef CONF_EVENT_LOG_MODULE_ENABLE
+
+/**
+ * @brief Initialize the event log module
+ *
+ * @attention The storage module must be initialized before this function
+ *
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
+ *
+ * @return EventLogReturnCode
+ *     - EVENT_LOG_NULL_POINTER if any of the parameters is NULL
+ *     - EVENT_LOG_OK otherwise
+ */
+EventLogReturnCode event_log_init(
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit
+);
+
+/**
+ * @brief Add an event to the queue
+ *
+ * @details This function can be called from an interrupt but not inside a critical section
+ *
+ * @param type The type of the event
+ * @param data_0 The first argument of the event
+ * @param data_1 The second argument of the event
+ *
+ * @return EventLogReturnCode
+ *     - EVENT_LOG_NULL_POINTER if the module is not initialized yet
+ *     - EVENT_LOG_FULL if the queue is full
+ *     - EVENT_LOG_OK otherwise
+ */
+EventLogReturnCode event_log_push(const EventLogType type, const uint8_t data_0, const uint16_t data_1);
+
+/**
+ * @brief Write the oldest queued event if the storage is not busy
+ */
+void event_log_routine(void);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Handle the received event log dump request
+ *
+ * @details The requested number of newest events is sent in chronological order,
+ * if the count is zero every stored event is sent
+ *
+ * @param payload A pointer to the canlib payload
+ */
+void event_log_dump_request_handle(primary_hv_event_log_dump_request_converted_t * const payload);
+
+/**
+ * @brief Get a pointer to the canlib payload of the next dumped event
+ *
+ * @details The dump task is disabled when the last event is read
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_event_log_converted_t* A pointer to the payload or NULL if the event can't be read yet
+ */
+primary_hv_event_log_converted_t * event_log_get_event_log_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#else  // CONF_EVENT_LOG_MODULE_ENABLE
+
+#define event_log_init(cs_enter, cs_exit) (EVENT_LOG_OK)
+#define event_log_push(type, data_0, data_1) (EVENT_LOG_OK)
+#define event_log_routine() MAINBOARD_NOPE()
+#define event_log_dump_request_handle(payload) MAINBOARD_NOPE()
+#define event_log_get_event_log_canlib_payload(byte_size) (NULL)
+
+#endif  // CONF_EVENT_LOG_MODULE_ENABLE
+
+#endif  // EVENT_LOG_H
@@ -9,6 +9,8 @@
 #ifndef FEEDBACK_H
 #define FEEDBACK_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 #include "mainboard-def.h"
@@ -19,7 +21,7 @@
 /** @brief Alias for the total number of feedbacks */
 #define FEEDBACK_COUNT (FEEDBACK_ID_COUNT)
 
-/** @brief The period with which feedbacks are updated */
+/** @brief The period with which feedbacks are acquired (i.e. the time needed to fill a DMA buffer) */
 #define FEEDBACK_CYCLE_TIME_MS (1U)
 
 /** @brief Voltage reference for the 5V to the MCU and the ShutDown */
@@ -27,6 +29,9 @@
 #define FEEDBACK_5V_VREF (5.f)
 #define FEEDBACK_SD_VREF (12.f)
 
+/** @brief Resolution of the ADC used for the analog feedbacks in bits */
+#define FEEDBACK_ADC_RESOLUTION (12U)
+
 /**
  * @brief Thresholds for the analog feedbacks in V
  *
@@ -37,6 +42,94 @@
 #define FEEDBACK_THRESHOLD_HIGH_V (1.9f)
 #define FEEDBACK_THRESHOLD_LOW_V (0.7f)
 
+/**
+ * @brief Default hysteresis of the thresholds in V
+ *
+ * @details A feedback leaves its current logical state only if the voltage
+ * crosses the threshold by more than this value
+ */
+#define FEEDBACK_HYSTERESIS_V (0.1f)
+
+/** @brief Maximum number of samples of each analog feedback for a single acquisition */
+#define FEEDBACK_OVERSAMPLING_MAX (4U)
+
+/** @brief Number of fractional bits of the filtered analog feedbacks */
+#define FEEDBACK_FILTER_FRACTION_BITS (8U)
+
+/**
+ * @brief Number of acquisitions kept until the status is updated
+ *
+ * @details The status is updated every FEEDBACK_CYCLE_TIME_MS, so the queue covers
+ * a main loop late by a few cycles without losing any transition
+ */
+#define FEEDBACK_ACQUISITION_QUEUE_SIZE (8U)
+
+/**
+ * @brief Maximum time in us without new acquisitions before the status of every feedback is set to error
+ *
+ * @details The acquisitions are published every FEEDBACK_CYCLE_TIME_MS, so a few
+ * missing ones mean that the ADCs or their trigger are stopped
+ */
+#define FEEDBACK_ACQUISITION_TIMEOUT_US (5000U)
+
+/** @brief Number of feedback status transitions kept in the edge log */
+#define FEEDBACK_EDGE_LOG_SIZE (32U)
+
+/**
+ * @brief Maximum time in us between a contactor command and the transition of its feedback
+ *
+ * @details Transitions that happen later are not considered as a response to the command
+ */
+#define FEEDBACK_CONTACTOR_LATENCY_TIMEOUT_US (1000000U)
+
+/** @brief Weight of the last sample in the exponentially weighted average of the latencies */
+#define FEEDBACK_CONTACTOR_LATENCY_EWMA_ALPHA (0.125f)
+
+/** @brief Interval between two messages of the contactors latency in ms */
+#define FEEDBACK_CONTACTOR_LATENCY_INTERVAL_MS (100U)
+
+/**
+ * @brief Convert a voltage in V to the corresponding raw value of the ADC
+ *
+ * @param value The voltage in V
+ *
+ * @return raw_volt_t The raw value
+ */
+#define FEEDBACK_VOLT_TO_RAW_VALUE(value) \
+    ((raw_volt_t)((value) / FEEDBACK_VREF * ((1U << FEEDBACK_ADC_RESOLUTION) - 1U) + 0.5f))
+
+/**
+ * @brief Configuration of the acquisition of each analog feedback
+ *
+ * @attention !!! DO NOT USE THIS MACRO OUTSIDE OF THIS FILE AND THE SOURCE !!!
+ *
+ * @details Each acquisition the oversampled values are averaged and fed to
+ * a first order IIR filter y += (x - y) / 2^shift computed in fixed point,
+ * the filtered value is then compared with the thresholds of the feedback
+ *
+ * @details A window feedback is high if its value is between the two thresholds
+ * and in the error state otherwise
+ *
+ * @param index The name of the analog feedback index
+ * @param oversampling The number of averaged samples (a power of two up to FEEDBACK_OVERSAMPLING_MAX)
+ * @param shift The shift of the filter coefficient (0 disables the filter)
+ * @param low The low threshold in V
+ * @param high The high threshold in V
+ * @param hysteresis The hysteresis of the thresholds in V
+ * @param window True if the feedback is high inside the thresholds
+ */
+#define FEEDBACK_ANALOG_CONFIG_X_LIST \
+    FEEDBACK_ANALOG_CONFIG_X(AIRN_OPEN_MEC, 4U, 2U, 1.6f, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false) \
+    FEEDBACK_ANALOG_CONFIG_X(AIRP_OPEN_MEC, 4U, 2U, 1.6f, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false) \
+    FEEDBACK_ANALOG_CONFIG_X(IMD_OK, 4U, 2U, 1.6f, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false) \
+    FEEDBACK_ANALOG_CONFIG_X(PLAUSIBLE_STATE_RC, 4U, 2U, FEEDBACK_THRESHOLD_LOW_V, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false) \
+    FEEDBACK_ANALOG_CONFIG_X(TSAL_GREEN, 4U, 2U, FEEDBACK_THRESHOLD_LOW_V, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false) \
+    FEEDBACK_ANALOG_CONFIG_X(PROBING_3V3, 4U, 3U, FEEDBACK_THRESHOLD_LOW_V, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, true) \
+    FEEDBACK_ANALOG_CONFIG_X(SD_OUT, 4U, 3U, FEEDBACK_THRESHOLD_LOW_V, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false) \
+    FEEDBACK_ANALOG_CONFIG_X(SD_IN, 4U, 3U, FEEDBACK_THRESHOLD_LOW_V, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false) \
+    FEEDBACK_ANALOG_CONFIG_X(SD_END, 4U, 3U, FEEDBACK_THRESHOLD_LOW_V, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false) \
+    FEEDBACK_ANALOG_CONFIG_X(V5_MCU, 4U, 3U, FEEDBACK_THRESHOLD_LOW_V, FEEDBACK_THRESHOLD_HIGH_V, FEEDBACK_HYSTERESIS_V, false)
+
 /**
  * @brief Convert the feedback voltage to the 5V to MCU voltage in V
  *
@@ -228,6 +321,13 @@ typedef bit_flag32_t (* feedback_read_digital_all_callback_t)(void);
  */
 typedef void (* feedback_start_analog_conversion_callback_t)(void);
 
+/**
+ * @brief Type definition for a callback function that reads the current time
+ *
+ * @return microseconds_t The elapsed time in us
+ */
+typedef microseconds_t (* feedback_get_time_us_callback_t)(void);
+
 /**
  * @brief Return code for the feedback module functions
  *
@@ -437,6 +537,40 @@ typedef enum {
     FEEDBACK_ANALOG_INDEX_UNKNOWN
 } FeedbackAnalogIndex;
 
+/**
+ * @brief Contactors whose command to feedback latency is measured
+ *
+ * @details
+ *     - FEEDBACK_CONTACTOR_AIRN The AIR-
+ *     - FEEDBACK_CONTACTOR_PRECHARGE The precharge relay
+ *     - FEEDBACK_CONTACTOR_AIRP The AIR+
+ */
+typedef enum {
+    FEEDBACK_CONTACTOR_AIRN,
+    FEEDBACK_CONTACTOR_PRECHARGE,
+    FEEDBACK_CONTACTOR_AIRP,
+    FEEDBACK_CONTACTOR_COUNT
+} FeedbackContactor;
+
+/**
+ * @brief Acquisition parameters of an analog feedback
+ *
+ * @param oversampling The number of averaged samples
+ * @param shift The shift of the filter coefficient
+ * @param low The low threshold as a raw value
+ * @param high The high threshold as a raw value
+ * @param hysteresis The hysteresis of the thresholds as a raw value
+ * @param window True if the feedback is high inside the thresholds
+ */
+typedef struct {
+    uint8_t oversampling;
+    uint8_t shift;
+    raw_volt_t low;
+    raw_volt_t high;
+    raw_volt_t hysteresis;
+    bool window;
+} FeedbackAnalogConfig;
+
 /**
  * @brief Status of the feedbacks
  *
@@ -451,6 +585,62 @@ typedef enum {
     FEEDBACK_STATUS_HIGH
 } FeedbackStatus;
 
+/**
+ * @brief Type definition for a single acquisition of the feedbacks
+ *
+ * @details The acquisitions are written by the ADC interrupt in a queue read by the
+ * main loop, the sequence number of the handler is used to find the new acquisitions
+ * and to detect a copy interrupted by an acquisition that reuses the same slot
+ *
+ * @param timestamp The time of the acquisition in us
+ * @param digital The bit flag where each bit represent a specific digital feedback state
+ * @param analog_high A bit flag of the analog feedbacks in the high status indexed by identifier
+ * @param analog_low A bit flag of the analog feedbacks in the low status indexed by identifier
+ */
+typedef struct {
+    microseconds_t timestamp;
+    bit_flag32_t digital;
+    bit_flag32_t analog_high;
+    bit_flag32_t analog_low;
+} FeedbackAcquisition;
+
+/**
+ * @brief Single transition of the status of a feedback
+ *
+ * @param timestamp The time of the acquisition where the transition is detected in us
+ * @param id The identifier of the feedback
+ * @param status The new status of the feedback
+ */
+typedef struct {
+    microseconds_t timestamp;
+    uint8_t id;
+    uint8_t status;
+} FeedbackEdge;
+
+/**
+ * @brief Command to feedback latency statistics of a contactor
+ *
+ * @param command The time of the last command in us
+ * @param expected The status of the mechanical feedback expected after the command
+ * @param pending True if the feedback has not reached the expected status yet
+ * @param count The number of measured latencies
+ * @param last The last latency in us
+ * @param min The minimum latency in us
+ * @param max The maximum latency in us
+ * @param ewma The exponentially weighted moving average of the latencies in us
+ */
+typedef struct {
+    microseconds_t command;
+    FeedbackStatus expected;
+    bool pending;
+
+    uint32_t count;
+    microseconds_t last;
+    microseconds_t min;
+    microseconds_t max;
+    float ewma;
+} FeedbackContactorLatency;
+
 /**
  * @brief Type definition for the internal feedback handler structure
  *
@@ -458,29 +648,75 @@ typedef enum {
  *
  * @param read_digital A pointer to the function used to read all the digital feedbacks
  * @param start_conversion A pointer to the function used to start the converison of the analog feedbacks
+ * @param get_time_us A pointer to the function used to read the current time in us
+ * @param filtered An array of filtered raw values of the analog feedbacks in fixed point
+ * @param primed A bit flag where each bit is set if the filter of the analog feedback has been initialized
+ * @param analog_high A bit flag of the analog feedbacks in the high status updated by the interrupt
+ * @param analog_low A bit flag of the analog feedbacks in the low status updated by the interrupt
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
+ * @param sequence The number of acquisitions published by the interrupt
+ * @param acquisitions The queue of the last acquisitions, the n-th one is stored at index n % FEEDBACK_ACQUISITION_QUEUE_SIZE
+ * @param last_sequence The sequence number of the last acquisition used to update the status
+ * @param lost The number of acquisitions overwritten before the status was updated
+ * @param last_acquisition The time in us when the last new acquisition has been found by the status update
+ * @param stale True if the status has been set to error because no acquisition is published anymore
  * @param digital The bit flag where each bit represent a specific feedback state
- * @param analog An array of raw voltages of the analog feedbacks
- * @param status An array of all the feedbacks current status
+ * @param status_high A bit flag of all the feedbacks in the high status indexed by identifier
+ * @param status_low A bit flag of all the feedbacks in the low status indexed by identifier
+ * @param edges The ring buffer of the last status transitions
+ * @param edge_head The index where the next transition is recorded
+ * @param edge_count The number of recorded transitions
+ * @param latency The latency statistics of each contactor, shared with the contactor commands
+ * @param latency_contactor The contactor sent with the next latency message
  * @param status_can_payload The canlib payload of the feedbacks status
  * @param digital_can_payload The canlib payload of the digital feedbacks values
  * @param analog_can_payload The canlib payload of the analog feedbacks values
  * @param analog_sd_can_payload The canlib payload of the analog shutdown feedbacks values
  * @param enzomma_can_payload The canlib payload of the feedback that did not allow the BMS to go the TS ON state
+ * @param contactor_latency_can_payload The canlib payload of the contactors latency
  */
 typedef struct {
     feedback_read_digital_all_callback_t read_digital;
     feedback_start_analog_conversion_callback_t start_conversion;
+    feedback_get_time_us_callback_t get_time_us;
+
+    uint32_t filtered[FEEDBACK_ANALOG_INDEX_COUNT];
+    bit_flag32_t primed;
+    bit_flag32_t analog_high;
+    bit_flag32_t analog_low;
+
+    interrupt_critical_section_enter_t cs_enter;
+    interrupt_critical_section_exit_t cs_exit;
+
+    _VOLATILE uint32_t sequence;
+    _VOLATILE FeedbackAcquisition acquisitions[FEEDBACK_ACQUISITION_QUEUE_SIZE];
+    uint32_t last_sequence;
+    uint32_t lost;
+    microseconds_t last_acquisition;
+    bool stale;
 
     bit_flag32_t digital; 
-    volt_t analog[FEEDBACK_ANALOG_INDEX_COUNT];
+    bit_flag32_t status_high;
+    bit_flag32_t status_low;
+
+    FeedbackEdge edges[FEEDBACK_EDGE_LOG_SIZE];
+    size_t edge_head;
+    size_t edge_count;
 
-    FeedbackStatus status[FEEDBACK_COUNT];
+    FeedbackContactorLatency latency[FEEDBACK_CONTACTOR_COUNT];
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    FeedbackContactor latency_contactor;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
 
     primary_hv_feedback_status_converted_t status_can_payload;
     primary_hv_feedback_digital_converted_t digital_can_payload;
     primary_hv_feedback_analog_converted_t analog_can_payload;
     primary_hv_feedback_analog_sd_converted_t analog_sd_can_payload;
     primary_hv_feedback_enzomma_converted_t enzomma_can_payload;
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    primary_hv_contactor_latency_converted_t contactor_latency_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
 } _FeedbackHandler;
 
 #ifdef CONF_FEEDBACK_MODULE_ENABLE
@@ -490,23 +726,38 @@ typedef struct {
  *
  * @param read_all A pointer to the callback that should read all the digital feedbacks
  * @param start_conversion A pointer to the callback that should start the conversion of the analog feedbacks
+ * @param get_time_us A pointer to the callback that should read the current time in us
+ * @param cs_enter A pointer to the function used to enter a critical section
+ * @param cs_exit A pointer to the function used to exit a critical section
  *
  * @return FeedbackReturnCode
  *     - FEEDBACK_NULL_POINTER if any of the parameters are NULL
  *     - FEEDBACK_OK otherwise
  */
-FeedbackReturnCode feedback_init(const feedback_read_digital_all_callback_t read_all, const feedback_start_analog_conversion_callback_t start_conversion);
+FeedbackReturnCode feedback_init(
+    const feedback_read_digital_all_callback_t read_all,
+    const feedback_start_analog_conversion_callback_t start_conversion,
+    const feedback_get_time_us_callback_t get_time_us,
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit
+);
 
 /**
  * @brief Update all the digital feedbacks
  *
+ * @attention The values are written in the acquisition that is being published
+ * so this function should be called only from feedback_notify_conversion_complete
+ *
  * @return FeedbackReturnCode
  *     - FEEDBACK_OK
  */
 FeedbackReturnCode feedback_update_digital_feedback_all(void);
 
 /**
- * @brief Start the conversion of the analog feedbacks
+ * @brief Start the continuous acquisition of the analog feedbacks
+ *
+ * @details The conversions are triggered by an hardware timer so this function
+ * has to be called only once
  *
  * @return FeedbackReturnCode
  *     - FEEDBACK_OK
@@ -516,18 +767,53 @@ FeedbackReturnCode feedback_start_analog_conversion_all(void);
 /**
  * @brief Update a single value of the analog feedbacks
  *
+ * @details The samples are filtered and the status of the feedback is updated
+ * immediately, it is published with the next completed acquisition
+ *
+ * @attention The array must contain at least FEEDBACK_OVERSAMPLING_MAX samples,
+ * the newest ones are at the end
+ *
  * @param index The index of the analog feedback
- * @param value The voltage value of the feedback in V
+ * @param samples A pointer to the first raw value of the feedback
+ * @param stride The distance between two consecutive samples of the feedback
  *
  * @return FeedbackReturnCode
+ *     - FEEDBACK_NULL_POINTER if the samples are NULL
  *     - FEEDBACK_INVALID_INDEX the given index is not valid
  *     - FEEDBACK_OK otherwise
  */
-FeedbackReturnCode feedback_update_analog_feedback(const FeedbackAnalogIndex index, const volt_t value);
+FeedbackReturnCode feedback_update_analog_feedback(
+    const FeedbackAnalogIndex index,
+    const raw_volt_t * const samples,
+    const size_t stride
+);
+
+/**
+ * @brief Notify the module that a new acquisition of the analog feedbacks is completed
+ *
+ * @details The digital feedbacks are read here so that they are sampled
+ * together with the analog ones, then the whole acquisition is written in the
+ * next slot of the queue and published incrementing the sequence number
+ *
+ * @attention This function should be called from the ADC interrupt once every
+ * analog feedback has been updated
+ */
+void feedback_notify_conversion_complete(void);
 
 /**
  * @brief Update the status of all the feedbacks
  *
+ * @details Every acquisition published since the last call is used in order, so that
+ * no transition is lost if the call is late. An acquisition is dropped and counted as
+ * lost if the interrupt reuses its slot before or during the copy, so that every
+ * status comes from a single acquisition
+ *
+ * @details Every status transition is recorded in the edge log with the time
+ * of the acquisition and the latency of the contactors is updated
+ *
+ * @details If no acquisition is published for FEEDBACK_ACQUISITION_TIMEOUT_US the
+ * status of every feedback is set to error until the acquisitions start again
+ *
  * @return FeedbackReturnCode
  *      - FEEDBACK_OK
  */
@@ -560,8 +846,21 @@ volt_t feedback_get_analog(const FeedbackAnalogIndex index);
  */
 FeedbackStatus feedback_get_status(const FeedbackId id);
 
+/**
+ * @brief Get all the feedbacks that are in a given status
+ *
+ * @param status The status of the feedbacks
+ *
+ * @return bit_flag32_t A bit flag where each bit is set if the corresponding
+ * feedback is in the given status, the feedback identifier is used as the position of the bit
+ */
+bit_flag32_t feedback_get_status_mask(const FeedbackStatus status);
+
 /**
  * @brief Check if the feedbacks specified in the mask are in the expected status
+ *
+ * @details The check is done on the whole bit flags at once, if more than one
+ * feedback does not match the one with the lowest identifier is returned
  * 
  * @param mask The mask used to select the feedbacks to check
  * @param value The expected values of the feedbacks
@@ -603,6 +902,45 @@ FeedbackDigitalBit feedback_get_digital_bit_from_id(const FeedbackId id);
  */
 FeedbackAnalogIndex feedback_get_analog_index_from_id(const FeedbackId id);
 
+/**
+ * @brief Notify the module that a contactor has been commanded
+ *
+ * @details The latency is measured from this moment up to the first acquisition
+ * where the mechanical feedback of the contactor reaches the commanded state,
+ * nothing is measured if the feedback is already in that state
+ *
+ * @details A command equal to the one still being measured is ignored so that
+ * the latency starts from the first command
+ *
+ * @details This function is also called by the CAN fast routine when the TS
+ * off request of the ECU opens the contactors, the latency statistics are
+ * accessed inside a critical section so it can be called from any context
+ *
+ * @param contactor The commanded contactor
+ * @param closed True if the contactor has been commanded to close, false to open
+ */
+void feedback_notify_contactor_command(const FeedbackContactor contactor, const bool closed);
+
+/**
+ * @brief Get the number of transitions inside the edge log
+ *
+ * @return size_t The number of recorded transitions
+ */
+size_t feedback_get_edge_count(void);
+
+/**
+ * @brief Get a transition from the edge log
+ *
+ * @param index The index of the transition, where 0 is the oldest one
+ * @param out[out] A pointer where the transition is copied
+ *
+ * @return FeedbackReturnCode
+ *     - FEEDBACK_NULL_POINTER if the output pointer is NULL
+ *     - FEEDBACK_INVALID_INDEX if the index is greater or equal than the number of transitions
+ *     - FEEDBACK_OK otherwise
+ */
+FeedbackReturnCode feedback_get_edge(const size_t index, FeedbackEdge * const out);
+
 /**
  * @brief Get a pointer to the CAN payload structure of the feedbacks status
  *
@@ -650,6 +988,21 @@ primary_hv_feedback_analog_sd_converted_t * feedback_get_analog_sd_payload(size_
  */
 primary_hv_feedback_enzomma_converted_t * feedback_get_enzomma_payload(const FeedbackId id, size_t * const byte_size);
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload structure of the latency of the next contactor
+ *
+ * @details The contactors are sent in turn, the ones without any measured latency are skipped
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_contactor_latency_converted_t* A pointer to the payload or NULL if no latency has been measured
+ */
+primary_hv_contactor_latency_converted_t * feedback_get_contactor_latency_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 #ifdef CONF_FEEDBACK_STRINGS_ENABLE
 
 /**
@@ -669,14 +1022,16 @@ const char * const feedback_get_feedback_id_name(const FeedbackId id);
 
 #else  // CONF_FEEDBACK_MODULE_ENABLE
 
-#define feedback_init(read_all, start_conversion) (FEEDBACK_OK)
+#define feedback_init(read_all, start_conversion, get_time_us, cs_enter, cs_exit) (FEEDBACK_OK)
 #define feedback_update_digital_feedback_all() (FEEDBACK_OK)
 #define feedback_start_analog_conversion_all() (FEEDBACK_OK)
-#define feedback_update_analog_feedback(index, value) (FEEDBACK_OK)
+#define feedback_update_analog_feedback(index, samples, stride) (FEEDBACK_OK)
+#define feedback_notify_conversion_complete() MAINBOARD_NOPE()
 #define feedback_update_status() (FEEDBACK_OK)
 #define feedback_get_digital(bit) (false)
 #define feedback_get_analog(index) (0.f)
 #define feedback_get_status(id) (FEEDBACK_STATUS_ERROR)
+#define feedback_get_status_mask(status) (0U)
 #define feedback_check_values(mask, value, out) (true)
 #define feedback_is_digital(id) (true)
 #define feedback_get_digital_bit_from_id(id) (FEEDBACK_DIGITAL_BIT_UNKNOWN)
@@ -686,6 +1041,10 @@ const char * const feedback_get_feedback_id_name(const FeedbackId id);
 #define feedback_get_analog_payload(byte_size) (NULL)
 #define feedback_get_analog_sd_payload(byte_size) (NULL)
 #define feedback_get_enzomma_payload(id, byte_size) (NULL)
+#define feedback_notify_contactor_command(contactor, closed) MAINBOARD_NOPE()
+#define feedback_get_edge_count() (0U)
+#define feedback_get_edge(index, out) (FEEDBACK_OK)
+#define feedback_get_contactor_latency_payload(byte_size) (NULL)
 
 #endif // CONF_FEEDBACK_MODULE_ENABLE
 
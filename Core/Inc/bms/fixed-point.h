@@ -0,0 +1,148 @@
+/**
+ * @file fixed-point.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Fixed-point representation of the cells data and aggregate kernels
+ *
+ * @details Voltages are stored as unsigned millivolts and temperatures as signed
+ * tenths of degree so that two values fit inside a single 32-bit word and can be
+ * processed together by the Cortex-M4 SIMD instructions
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+/**
+ * @brief Range of the fixed-point values
+ *
+ * @details The millivolts are limited to the positive range of a signed 16-bit
+ * integer so that the sums can be computed with signed multiply-accumulate instructions
+ */
+#define FIXED_POINT_MILLIVOLT_MAX (INT16_MAX)
+#define FIXED_POINT_DECICELSIUS_MIN (INT16_MIN)
+#define FIXED_POINT_DECICELSIUS_MAX (INT16_MAX)
+
+/**
+ * @brief Convert a voltage in V to fixed-point millivolts
+ *
+ * @param V The voltage in V
+ *
+ * @return uint16_t The voltage in mV
+ */
+#define FIXED_POINT_MILLIVOLT_FROM_VOLT(V) ((uint16_t)(MAINBOARD_CLAMP((V) * 1000.f, 0.f, (float)FIXED_POINT_MILLIVOLT_MAX) + 0.5f))
+
+/**
+ * @brief Convert fixed-point millivolts to a voltage in V
+ *
+ * @param MV The voltage in mV
+ *
+ * @return volt_t The voltage in V
+ */
+#define FIXED_POINT_VOLT_FROM_MILLIVOLT(MV) ((volt_t)(MV) * 0.001f)
+
+/**
+ * @brief Convert a temperature in °C to fixed-point tenths of degree
+ *
+ * @param C The temperature in °C
+ *
+ * @return int16_t The temperature in tenths of °C
+ */
+#define FIXED_POINT_DECICELSIUS_FROM_CELSIUS(C) ((int16_t)(MAINBOARD_CLAMP((C) * 10.f, (float)FIXED_POINT_DECICELSIUS_MIN, (float)FIXED_POINT_DECICELSIUS_MAX) + (((C) < 0.f) ? -0.5f : 0.5f)))
+
+/**
+ * @brief Convert fixed-point tenths of degree to a temperature in °C
+ *
+ * @param DC The temperature in tenths of °C
+ *
+ * @return celsius_t The temperature in °C
+ */
+#define FIXED_POINT_CELSIUS_FROM_DECICELSIUS(DC) ((celsius_t)(DC) * 0.1f)
+
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+
+/**
+ * @brief Get the minimum, maximum and sum of an array of unsigned 16-bit values
+ *
+ * @details Two values are processed for each instruction when the DSP extension is available
+ *
+ * @attention The number of values must be greater than zero and the values
+ * must not exceed FIXED_POINT_MILLIVOLT_MAX
+ *
+ * @param data The array of values
+ * @param count The number of values
+ * @param min[out] A pointer where the minimum value is stored (can be NULL)
+ * @param max[out] A pointer where the maximum value is stored (can be NULL)
+ * @param sum[out] A pointer where the sum of the values is stored (can be NULL)
+ */
+void fixed_point_u16_aggregate(
+    const uint16_t * const data,
+    const size_t count,
+    uint16_t * const min,
+    uint16_t * const max,
+    uint32_t * const sum
+);
+
+/**
+ * @brief Get the minimum, maximum and sum of an array of signed 16-bit values
+ *
+ * @details Two values are processed for each instruction when the DSP extension is available
+ *
+ * @attention The number of values must be greater than zero
+ *
+ * @param data The array of values
+ * @param count The number of values
+ * @param min[out] A pointer where the minimum value is stored (can be NULL)
+ * @param max[out] A pointer where the maximum value is stored (can be NULL)
+ * @param sum[out] A pointer where the sum of the values is stored (can be NULL)
+ */
+void fixed_point_i16_aggregate(
+    const int16_t * const data,
+    const size_t count,
+    int16_t * const min,
+    int16_t * const max,
+    int32_t * const sum
+);
+
+/**
+ * @brief Get the sum of the squares of an array of signed 16-bit values
+ *
+ * @details Two values are processed for each instruction when the DSP extension is available
+ *
+ * @param data The array of values
+ * @param count The number of values
+ *
+ * @return int64_t The sum of the squares
+ */
+int64_t fixed_point_i16_sum_squares(const int16_t * const data, const size_t count);
+
+/**
+ * @brief Count the number of values of an array of unsigned 16-bit values that fall inside each bin
+ *
+ * @details Values outside the histogram range are counted inside the first or last bin
+ *
+ * @param data The array of values
+ * @param count The number of values
+ * @param low The lower bound of the first bin
+ * @param width The width of each bin (must be greater than zero)
+ * @param bins[out] The array of bins counters
+ * @param bin_count The number of bins
+ */
+void fixed_point_u16_histogram(
+    const uint16_t * const data,
+    const size_t count,
+    const uint16_t low,
+    const uint16_t width,
+    uint16_t * const bins,
+    const size_t bin_count
+);
+
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
+
+#endif  // FIXED_POINT_H
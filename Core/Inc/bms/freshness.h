@@ -0,0 +1,123 @@
+/**
+ * @file freshness.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Freshness and sweep tracking of a group of measured values
+ *
+ * @details Every value is marked as fresh when it is updated and a sweep is
+ * completed once every value has been updated at least once since the end
+ * of the previous sweep, at that point the bitmap is cleared
+ *
+ * @details The index of the oldest value is kept while the values are updated
+ * and it is searched again only when the oldest value itself is refreshed,
+ * which happens about once per sweep when the values are received in order,
+ * so the age of the data can be read in constant time
+ *
+ * @attention The completion of a sweep is not notified with a callback, the
+ * users have to poll the sweep counter and compare it with a stored value
+ */
+
+#ifndef FRESHNESS_H
+#define FRESHNESS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+/** @brief Get the number of words of the bitmap needed for a given number of values */
+#define FRESHNESS_WORD_COUNT(COUNT) (((COUNT) + 31U) / 32U)
+
+/**
+ * @brief Freshness tracking structure
+ *
+ * @details The bitmap and the array of update times are owned by the user and
+ * must contain at least FRESHNESS_WORD_COUNT(count) words and count values
+ *
+ * @param fresh Bitmap of the values updated since the end of the last sweep
+ * @param last_update The time of the last update of each value in ticks
+ * @param count The total number of values
+ * @param fresh_count The number of values updated since the end of the last sweep
+ * @param oldest The index of the value with the oldest update time
+ * @param sweep The number of completed sweeps
+ * @param sweep_time The time when the last sweep has been completed in ticks
+ */
+typedef struct {
+    bit_flag32_t * fresh;
+    ticks_t * last_update;
+    size_t count;
+    size_t fresh_count;
+    size_t oldest;
+    uint32_t sweep;
+    ticks_t sweep_time;
+} Freshness;
+
+/**
+ * @brief Initialize the freshness tracking of a group of values
+ *
+ * @details Every value is considered updated at time zero
+ *
+ * @param freshness A pointer to the structure to initialize
+ * @param fresh The bitmap used to store the fresh values
+ * @param last_update The array used to store the update times
+ * @param count The number of values
+ */
+void freshness_init(
+    Freshness * const freshness,
+    bit_flag32_t * const fresh,
+    ticks_t * const last_update,
+    const size_t count
+);
+
+/**
+ * @brief Mark a range of consecutive values as updated
+ *
+ * @param freshness A pointer to the freshness structure
+ * @param start The index of the first updated value
+ * @param size The number of updated values
+ * @param timestamp The time when the values have been received in ticks
+ *
+ * @return bool True if a sweep has been completed, false otherwise or if the range is not valid
+ */
+bool freshness_update(
+    Freshness * const freshness,
+    const size_t start,
+    const size_t size,
+    const ticks_t timestamp
+);
+
+/**
+ * @brief Check if a value has been updated since the end of the last sweep
+ *
+ * @param freshness A pointer to the freshness structure
+ * @param index The index of the value
+ *
+ * @return bool True if the value has been updated, false otherwise or if the index is not valid
+ */
+bool freshness_is_fresh(const Freshness * const freshness, const size_t index);
+
+/**
+ * @brief Get the time elapsed since the last update of a single value
+ *
+ * @param freshness A pointer to the freshness structure
+ * @param index The index of the value
+ * @param now The current time in ticks
+ *
+ * @return ticks_t The age of the value in ticks or 0 if the index is not valid
+ */
+ticks_t freshness_get_age(const Freshness * const freshness, const size_t index, const ticks_t now);
+
+/**
+ * @brief Get the age of the oldest value
+ *
+ * @param freshness A pointer to the freshness structure
+ * @param now The current time in ticks
+ *
+ * @return ticks_t The age of the oldest value in ticks
+ */
+ticks_t freshness_get_oldest_age(const Freshness * const freshness, const ticks_t now);
+
+#endif  // FRESHNESS_H
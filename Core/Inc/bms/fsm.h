@@ -212,6 +212,8 @@ fsm_state_t fsm_get_status(void);
 /**
  * @brief Handle the received cellboard status
  *
+ * @details This function is called by the CAN fast routine
+ *
  * @param payload A pointer to the canlib payload
  */
 void fsm_cellboard_state_handle(bms_cellboard_status_converted_t * const payload);
@@ -89,6 +89,11 @@ typedef void (* pcu_toggle_state_callback_t)(const PcuPin pcu_pin);
  *
  * @param set A pointer to the function callback used to set a PCU pin
  * @param toggle A pointer to the function callback used to toggle a PCU pin
+ * @param event The event triggered by the handcart set status message
+ * @param ecu_event The event triggered by the ECU set status message
+ * @param timeout_event The event triggered when one of the watchdogs times out
+ * @param ts_off_requested True if the ECU requested the TS off, latched by the
+ * CAN fast routine until the FSM completes the procedure
  * @param precharge_watchdog Precharge watchdog
  */
 typedef struct {
@@ -96,8 +101,11 @@ typedef struct {
     pcu_toggle_state_callback_t toggle;
 
     fsm_event_data_t event;
+    fsm_event_data_t ecu_event;
     fsm_event_data_t timeout_event;
 
+    bool ts_off_requested;
+
     Watchdog airn_watchdog;
     Watchdog precharge_watchdog;
     Watchdog airp_watchdog;
@@ -117,7 +125,11 @@ typedef struct {
  */
 PcuReturnCode pcu_init(const pcu_set_state_callback_t set, const pcu_toggle_state_callback_t toggle);
 
-/** @brief Reset all the pins to their initial states */
+/**
+ * @brief Reset all the pins to their initial states
+ *
+ * @details The TS off request latched by the ECU set status handler is cleared as well
+ */
 void pcu_reset_all(void);
 
 /** @brief Open or close the AIR- */
@@ -156,9 +168,26 @@ precise_percentage_t pcu_get_precharge_percentage(void);
  */
 bool pcu_is_precharge_complete(void);
 
+/**
+ * @brief Check if the ECU requested the TS off
+ *
+ * @details The request is latched instead of relying only on the FSM event
+ * because an event triggered while another one is pending is dropped
+ *
+ * @return bool True if the TS off was requested and not handled yet, false otherwise
+ */
+bool pcu_is_ts_off_requested(void);
+
 /**
  * @brief Handle the received set status message sent from the ECU
  *
+ * @details If the TS has to be turned off the AIRs and the precharge are opened
+ * immediately, the feedback module is notified of the commands and the request
+ * is latched, the rest of the procedure is then completed by the FSM
+ *
+ * @details This function is called by the CAN fast routine, before the timebase
+ * tasks and the CAN buffers drain of the main loop
+ *
  * @param payload A pointer to the canlib payload of the response
  */
 void pcu_set_state_from_ecu_handle(primary_hv_set_status_ecu_converted_t * const payload);
@@ -187,6 +216,7 @@ void pcu_set_state_from_handcart_handle(primary_hv_set_status_handcart_converted
 #define pcu_ams_deactivate() MAINBOARD_NOPE()
 #define pcu_get_precharge_percentage() (0.f)
 #define pcu_is_precharge_complete() (false)
+#define pcu_is_ts_off_requested() (false)
 #define pcu_set_state_from_ecu_handle(payload) MAINBOARD_NOPE()
 #define pcu_set_state_from_handcart_handle(payload) MAINBOARD_NOPE()
 
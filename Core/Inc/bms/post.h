@@ -20,6 +20,7 @@
 #include "pcu.h"
 #include "feedback.h"
 #include "display.h"
+#include "black-box.h"
 
 /**
  * @brief Return code for the post module functions
@@ -53,17 +54,19 @@ typedef enum {
  * @param pcu_toggle A pointer to a function that toggles the state of a PCU pin
  * @param feedback_read_all A pointer to a function that read all the digital feedbacks
  * @param feedback_start_conversion A pointer to a function that starts the ADC conversion of the analog feedbacks
+ * @param feedback_get_time_us A pointer to a function that reads the current time in us
  * @param display_set A pointer to a function that sets the state of a single segment of the 7-segment display
  * @param display_toggle A pointer to a function that toggles the state a single segment of the 7-segment display
  * @param spi_send A pointer to a function that send data via an SPI network
  * @param spi_send_receive A pointer to a function that send and receive data via an SPI network
+ * @param get_cycles A pointer to a function that reads the CPU cycle counter
  */
 typedef struct {
     system_reset_callback_t system_reset;
     interrupt_critical_section_enter_t cs_enter;
     interrupt_critical_section_exit_t cs_exit;
-    // error_update_timer_callback_t error_update_timer;
-    // error_stop_timer_callback_t error_stop_timer;
+    error_update_timer_callback_t error_update_timer;
+    error_stop_timer_callback_t error_stop_timer;
     can_comm_transmit_callback_t can_send;
     led_set_state_callback_t led_set;
     led_toggle_state_callback_t led_toggle;
@@ -72,10 +75,12 @@ typedef struct {
     pcu_toggle_state_callback_t pcu_toggle;
     feedback_read_digital_all_callback_t feedback_read_all;
     feedback_start_analog_conversion_callback_t feedback_start_conversion;
+    feedback_get_time_us_callback_t feedback_get_time_us;
     display_segment_set_state_callback_t display_set;
     display_segment_toggle_state_callback_t display_toggle;
     spi_send_callback_t spi_send;
     spi_send_receive_callback_t spi_send_receive;
+    black_box_get_cycles_callback_t get_cycles;
 } PostInitData;
 
 #ifdef CONF_POST_MODULE_ENABLE
@@ -0,0 +1,202 @@
+/**
+ * @file resistance.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Online estimation of the internal resistance and open circuit voltage of the cells
+ *
+ * @details Each cell is modeled as an ideal voltage source with a series resistance
+ * V = OCV - R * I, where the current is positive during discharge.
+ * Both parameters are estimated with a recursive least squares filter
+ * with exponential forgetting which is updated every time a new voltage
+ * value is received using the current measured at the same time
+ */
+
+#ifndef RESISTANCE_H
+#define RESISTANCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "primary_network.h"
+
+/** @brief Forgetting factor of the filter, older samples weight decays as LAMBDA^n */
+#define RESISTANCE_FORGETTING_FACTOR (0.998f)
+
+/** @brief Initial value of the internal resistance in Ohm */
+#define RESISTANCE_INITIAL_OHM (0.003f)
+/** @brief Initial variance of the open circuit voltage in V^2 and of the resistance in Ohm^2 */
+#define RESISTANCE_INITIAL_OCV_VARIANCE (1e-2f)
+#define RESISTANCE_INITIAL_RESISTANCE_VARIANCE (1e-5f)
+/**
+ * @brief Maximum trace of the covariance matrix
+ *
+ * @details Without enough current variation the covariance grows exponentially
+ * because of the forgetting factor, over this limit the forgetting is disabled
+ */
+#define RESISTANCE_COVARIANCE_TRACE_MAX (1e-1f)
+
+/** @brief Number of updates needed before the estimation of a cell is considered valid */
+#define RESISTANCE_MIN_UPDATE_COUNT (64U)
+
+/** @brief Number of cells with the highest resistance sent via CAN */
+#define RESISTANCE_WORST_COUNT (4U)
+
+/**
+ * @brief Return code for the resistance module functions
+ *
+ * @details
+ *     - RESISTANCE_OK the function executed successfully
+ *     - RESISTANCE_OUT_OF_BOUNDS an index (or pointer) value is greater/lower than the maximum/minimum allowed value
+ *     - RESISTANCE_NOT_READY the estimation has not converged yet
+ */
+typedef enum {
+    RESISTANCE_OK,
+    RESISTANCE_OUT_OF_BOUNDS,
+    RESISTANCE_NOT_READY
+} ResistanceReturnCode;
+
+/**
+ * @brief Estimator state of a single cell
+ *
+ * @param ocv The estimated open circuit voltage in V
+ * @param resistance The estimated internal resistance in Ohm
+ * @param p00 The variance of the open circuit voltage
+ * @param p01 The covariance between the open circuit voltage and the resistance
+ * @param p11 The variance of the resistance
+ * @param count The number of updates (saturated)
+ */
+typedef struct {
+    float ocv;
+    float resistance;
+    float p00;
+    float p01;
+    float p11;
+    uint16_t count;
+} ResistanceEstimator;
+
+/**
+ * @brief Resistance handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @param cells The estimator of each cell
+ * @param worst The indices of the cells with the highest resistance
+ * @param worst_count The number of valid indices
+ * @param worst_offset The rank of the next cell sent via CAN
+ * @param resistance_can_payload The canlib payload of the cells with the highest resistance
+ */
+typedef struct {
+    ResistanceEstimator cells[CELLBOARD_COUNT][CELLBOARD_SEGMENT_SERIES_COUNT];
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    size_t worst[RESISTANCE_WORST_COUNT];
+    size_t worst_count;
+    size_t worst_offset;
+    primary_hv_cells_resistance_converted_t resistance_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+} _ResistanceHandler;
+
+#ifdef CONF_RESISTANCE_MODULE_ENABLE
+
+/**
+ * @brief Initialize the resistance module
+ *
+ * @return ResistanceReturnCode
+ *     - RESISTANCE_OK
+ */
+ResistanceReturnCode resistance_init(void);
+
+/**
+ * @brief Update the estimation of a cell with a new pair of measurements
+ *
+ * @details The update takes a constant amount of operations and can
+ * be executed inside the handler of the received voltages
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ * @param voltage The voltage of the cell in V
+ * @param current The current of the pack at the time of the voltage measurement in A
+ *
+ * @return ResistanceReturnCode
+ *     - RESISTANCE_OUT_OF_BOUNDS the cellboard identifier or the offset are not valid
+ *     - RESISTANCE_OK otherwise
+ */
+ResistanceReturnCode resistance_update(
+    const CellboardId id,
+    const size_t offset,
+    const volt_t voltage,
+    const ampere_t current
+);
+
+/**
+ * @brief Get the estimated internal resistance of a cell
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ * @param out[out] A pointer where the resistance in Ohm is stored
+ *
+ * @return ResistanceReturnCode
+ *     - RESISTANCE_OUT_OF_BOUNDS the parameters are not valid
+ *     - RESISTANCE_NOT_READY not enough updates have been done
+ *     - RESISTANCE_OK otherwise
+ */
+ResistanceReturnCode resistance_get_resistance(const CellboardId id, const size_t offset, float * const out);
+
+/**
+ * @brief Get the estimated open circuit voltage of a cell
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ * @param out[out] A pointer where the voltage in V is stored
+ *
+ * @return ResistanceReturnCode
+ *     - RESISTANCE_OUT_OF_BOUNDS the parameters are not valid
+ *     - RESISTANCE_NOT_READY not enough updates have been done
+ *     - RESISTANCE_OK otherwise
+ */
+ResistanceReturnCode resistance_get_ocv(const CellboardId id, const size_t offset, volt_t * const out);
+
+/**
+ * @brief Get the cells with the highest estimated resistance
+ *
+ * @details Only the cells with a valid estimation are considered
+ *
+ * @param k The number of cells to get
+ * @param out[out] The array where the indices (cellboard * series count + offset) are stored in descending order
+ *
+ * @return size_t The number of indices copied into the array
+ */
+size_t resistance_get_worst(const size_t k, size_t * const out);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload of the cells with the highest resistance
+ *
+ * @details Every call returns the payload of the next cell of the ranking
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_cells_resistance_converted_t* A pointer to the payload
+ */
+primary_hv_cells_resistance_converted_t * resistance_get_cells_resistance_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#else  // CONF_RESISTANCE_MODULE_ENABLE
+
+#define resistance_init() (RESISTANCE_OK)
+#define resistance_update(id, offset, voltage, current) (RESISTANCE_OK)
+#define resistance_get_resistance(id, offset, out) (RESISTANCE_NOT_READY)
+#define resistance_get_ocv(id, offset, out) (RESISTANCE_NOT_READY)
+#define resistance_get_worst(k, out) (0U)
+#define resistance_get_cells_resistance_canlib_payload(byte_size) (NULL)
+
+#endif  // CONF_RESISTANCE_MODULE_ENABLE
+
+#endif  // RESISTANCE_H
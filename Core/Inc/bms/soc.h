@@ -0,0 +1,296 @@
+/**
+ * @file soc.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief State of charge estimation of the pack and of each segment
+ *
+ * @details The charge of each segment is estimated with a one state extended
+ * Kalman filter which uses coulomb counting for the prediction step and the
+ * average cell voltage of the segment, compared with the open circuit voltage
+ * curve of the cells, for the correction step.
+ * While the pack is at rest the voltage measurements are trusted more so that
+ * the drift of the coulomb counter is corrected
+ */
+
+#ifndef SOC_H
+#define SOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "primary_network.h"
+
+/** @brief Nominal capacity of a single cell in Ah */
+#define SOC_CELL_CAPACITY_AH (4.5f)
+/** @brief Capacity of a group of parallel cells in As */
+#define SOC_CAPACITY_AS (SOC_CELL_CAPACITY_AH * CELLBOARD_SEGMENT_PARALLELS_COUNT * 3600.f)
+/** @brief Nominal internal resistance of a group of parallel cells in Ohm */
+#define SOC_GROUP_RESISTANCE_OHM (0.003f)
+
+/** @brief Interval between two updates of the filter in ms */
+#define SOC_UPDATE_INTERVAL_MS (100U)
+/** @brief Interval between two updates of the state snapshot in ms */
+#define SOC_STORE_INTERVAL_MS (10000U)
+
+/** @brief Maximum absolute current in A and minimum duration in ms for the pack to be considered at rest */
+#define SOC_REST_CURRENT_A (1.f)
+#define SOC_REST_TIME_MS (30000U)
+
+/**
+ * @brief Parameters of the filter
+ *
+ * @details The process noise is the variance added at each update and accounts for
+ * the error of the current sensor and of the capacity, the measurement noise is the
+ * variance in V^2 of the difference between the voltage and the model output
+ */
+#define SOC_INITIAL_VARIANCE (1e-2f)
+#define SOC_PROCESS_NOISE (1e-8f)
+#define SOC_MEASUREMENT_NOISE_LOAD (1e-1f)
+#define SOC_MEASUREMENT_NOISE_REST (1e-4f)
+
+/**
+ * @brief Return code for the state of charge module functions
+ *
+ * @details
+ *     - SOC_OK the function executed successfully
+ *     - SOC_NULL_POINTER a NULL pointer is given as parameter
+ *     - SOC_OUT_OF_BOUNDS an index value is greater/lower than the maximum/minimum allowed value
+ *     - SOC_NOT_READY the estimation has not been initialized yet
+ */
+typedef enum {
+    SOC_OK,
+    SOC_NULL_POINTER,
+    SOC_OUT_OF_BOUNDS,
+    SOC_NOT_READY
+} SocReturnCode;
+
+/**
+ * @brief State of the filter of a single segment
+ *
+ * @param soc The state of charge in the range [0, 1]
+ * @param variance The variance of the state of charge
+ */
+typedef struct {
+    float soc;
+    float variance;
+} SocEstimator;
+
+/**
+ * @brief Compact copy of the state of the filters that can be stored and restored after a reset
+ *
+ * @param segments The state of the filter of each segment
+ */
+typedef struct {
+    SocEstimator segments[CELLBOARD_COUNT];
+} SocSnapshot;
+
+/**
+ * @brief State of charge handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @details The charge is accumulated by the CAN fast routine in mA * ticks
+ * as a wrapping integer, the filter uses the difference between two readings
+ *
+ * @param initialized True if the filters have been initialized
+ * @param resting True if the pack is at rest
+ * @param segments The state of the filter of each segment
+ * @param charge The accumulated charge in mA * ticks
+ * @param last_charge The value of the charge at the last update of the filter
+ * @param last_current The last current value in mA
+ * @param last_current_time The time of the last current value in ticks
+ * @param rest_start The time when the pack has started to rest in ticks
+ * @param snapshot The last stored state of the filters
+ * @param snapshot_time The time of the last update of the snapshot in ticks
+ * @param cellboard_id The cellboard identifier of the next segment sent via CAN
+ * @param soc_can_payload The canlib payload of the pack state of charge
+ * @param segment_soc_can_payload The canlib payload of the segments state of charge
+ */
+typedef struct {
+    bool initialized;
+    bool resting;
+    SocEstimator segments[CELLBOARD_COUNT];
+
+    _VOLATILE uint32_t charge;
+    uint32_t last_charge;
+    int32_t last_current;
+    ticks_t last_current_time;
+    ticks_t rest_start;
+
+    SocSnapshot snapshot;
+    ticks_t snapshot_time;
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    CellboardId cellboard_id;
+    primary_hv_soc_estimation_converted_t soc_can_payload;
+    primary_hv_segment_soc_converted_t segment_soc_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+} _SocHandler;
+
+#ifdef CONF_SOC_MODULE_ENABLE
+
+/**
+ * @brief Initialize the state of charge module
+ *
+ * @details The filters are initialized from the open circuit voltage
+ * when the first voltages are available unless a snapshot is restored
+ *
+ * @return SocReturnCode
+ *     - SOC_OK
+ */
+SocReturnCode soc_init(void);
+
+/**
+ * @brief Integrate a new current value
+ *
+ * @details This function is called by the CAN fast routine
+ *
+ * @param current The current in A, positive during discharge
+ * @param timestamp The time of the measurement in ticks
+ */
+void soc_integrate_current(const ampere_t current, const ticks_t timestamp);
+
+/**
+ * @brief Update the filters with the charge accumulated since the last update and the current voltages
+ *
+ * @details The amount of operations is constant and proportional to the number of segments
+ */
+void soc_update(void);
+
+/**
+ * @brief Get the state of charge of the pack
+ *
+ * @details The pack state of charge is the average of the segments one
+ *
+ * @return float The state of charge in the range [0, 1]
+ */
+float soc_get_soc(void);
+
+/**
+ * @brief Get the state of charge of the most discharged segment
+ *
+ * @details The pack can not be discharged further once this segment is empty
+ *
+ * @return float The state of charge in the range [0, 1]
+ */
+float soc_get_min_segment_soc(void);
+
+/**
+ * @brief Get the state of charge of the most charged segment
+ *
+ * @details The pack can not be charged further once this segment is full
+ *
+ * @return float The state of charge in the range [0, 1]
+ */
+float soc_get_max_segment_soc(void);
+
+/**
+ * @brief Get the charge exchanged by the pack
+ *
+ * @details The counter wraps around so only the difference between two readings,
+ * converted to a signed integer, is meaningful
+ *
+ * @return uint32_t The charge in mA * ticks, positive during discharge
+ */
+uint32_t soc_get_charge(void);
+
+/**
+ * @brief Check if the pack is at rest
+ *
+ * @details The pack is at rest if the current stays below SOC_REST_CURRENT_A for at least SOC_REST_TIME_MS
+ *
+ * @return bool True if the pack is at rest, false otherwise
+ */
+bool soc_is_resting(void);
+
+/**
+ * @brief Get the state of charge that corresponds to the average cell voltage
+ *
+ * @details The value is meaningful only while the pack is at rest
+ *
+ * @return float The state of charge in the range [0, 1]
+ */
+float soc_get_ocv_soc(void);
+
+/**
+ * @brief Get the state of charge of a segment
+ *
+ * @param id The cellboard identifier
+ * @param out[out] A pointer where the state of charge in the range [0, 1] is stored
+ *
+ * @return SocReturnCode
+ *     - SOC_NULL_POINTER the output pointer is NULL
+ *     - SOC_OUT_OF_BOUNDS the cellboard identifier is not valid
+ *     - SOC_NOT_READY the filters have not been initialized yet
+ *     - SOC_OK otherwise
+ */
+SocReturnCode soc_get_segment_soc(const CellboardId id, float * const out);
+
+/**
+ * @brief Get the last snapshot of the state of the filters
+ *
+ * @return const SocSnapshot* A pointer to the snapshot
+ */
+const SocSnapshot * soc_get_snapshot(void);
+
+/**
+ * @brief Restore the state of the filters from a snapshot
+ *
+ * @param snapshot A pointer to the snapshot
+ *
+ * @return SocReturnCode
+ *     - SOC_NULL_POINTER the snapshot is NULL
+ *     - SOC_OUT_OF_BOUNDS the values of the snapshot are not valid
+ *     - SOC_OK otherwise
+ */
+SocReturnCode soc_restore(const SocSnapshot * const snapshot);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload of the pack state of charge
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_soc_estimation_converted_t* A pointer to the payload
+ */
+primary_hv_soc_estimation_converted_t * soc_get_soc_canlib_payload(size_t * const byte_size);
+
+/**
+ * @brief Get a pointer to the CAN payload of the segments state of charge
+ *
+ * @details Every call returns the payload of the next segment
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_segment_soc_converted_t* A pointer to the payload
+ */
+primary_hv_segment_soc_converted_t * soc_get_segment_soc_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#else  // CONF_SOC_MODULE_ENABLE
+
+#define soc_init() (SOC_OK)
+#define soc_integrate_current(current, timestamp) MAINBOARD_NOPE()
+#define soc_update() MAINBOARD_NOPE()
+#define soc_get_soc() (0.f)
+#define soc_get_min_segment_soc() (0.f)
+#define soc_get_max_segment_soc() (0.f)
+#define soc_get_charge() (0U)
+#define soc_is_resting() (false)
+#define soc_get_ocv_soc() (0.f)
+#define soc_get_segment_soc(id, out) (SOC_NOT_READY)
+#define soc_get_snapshot() (NULL)
+#define soc_restore(snapshot) (SOC_OK)
+#define soc_get_soc_canlib_payload(byte_size) (NULL)
+#define soc_get_segment_soc_canlib_payload(byte_size) (NULL)
+
+#endif  // CONF_SOC_MODULE_ENABLE
+
+#endif  // SOC_H
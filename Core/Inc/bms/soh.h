@@ -0,0 +1,192 @@
+/**
+ * @file soh.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief State of health tracking of the pack
+ *
+ * @details The module accumulates the charge and energy throughput of the pack,
+ * counts the charge cycles with the rainflow algorithm and estimates the actual
+ * capacity comparing the charge exchanged between two rest points with the
+ * difference of the state of charge given by the open circuit voltage.
+ * The state is periodically saved inside the EEPROM together with a snapshot
+ * of the state of charge so that both survive a reset
+ */
+
+#ifndef SOH_H
+#define SOH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "soc.h"
+
+/** @brief Interval between two updates in ms */
+#define SOH_UPDATE_INTERVAL_MS (100U)
+/** @brief Interval between two saves of the state in ms */
+#define SOH_SAVE_INTERVAL_MS (60000U)
+
+/**
+ * @brief Number of bins of the depth of discharge histogram
+ *
+ * @details Each bin covers 10% of depth of discharge, the last one includes the full cycles
+ */
+#define SOH_DOD_BIN_COUNT (10U)
+
+/**
+ * @brief Parameters of the rainflow counting
+ *
+ * @details The hysteresis is the minimum change of the state of charge needed
+ * to detect a reversal and filters the noise of the estimation
+ */
+#define SOH_RAINFLOW_HYSTERESIS (0.01f)
+#define SOH_RAINFLOW_STACK_SIZE (16U)
+
+/**
+ * @brief Parameters of the capacity estimation
+ *
+ * @details The capacity is updated only if the state of charge difference between
+ * two rest points is large enough for the open circuit voltage error to be negligible
+ */
+#define SOH_CAPACITY_MIN_DELTA_SOC (0.3f)
+#define SOH_CAPACITY_GAIN (0.1f)
+
+/**
+ * @brief Return code for the state of health module functions
+ *
+ * @details
+ *     - SOH_OK the function executed successfully
+ *     - SOH_NOT_RESTORED no valid saved state has been found
+ */
+typedef enum {
+    SOH_OK,
+    SOH_NOT_RESTORED
+} SohReturnCode;
+
+/**
+ * @brief Persistent state of health data
+ *
+ * @attention The size of this structure plus the record header must fit inside a storage slot
+ *
+ * @param charge_out The total charge delivered by the pack in uAs
+ * @param charge_in The total charge received by the pack in uAs
+ * @param energy_out The total energy delivered by the pack in mJ
+ * @param energy_in The total energy received by the pack in mJ
+ * @param rest_charge The net charge delivered by the pack at the last rest point in uAs
+ * @param capacity The estimated capacity of a group of parallel cells in As
+ * @param rest_soc The open circuit voltage state of charge at the last rest point
+ * @param dod_histogram The number of half cycles for each depth of discharge bin
+ * @param rest_valid True if the last rest point is valid
+ * @param soc The snapshot of the state of charge
+ */
+typedef struct {
+    uint64_t charge_out;
+    uint64_t charge_in;
+    uint64_t energy_out;
+    uint64_t energy_in;
+    int64_t rest_charge;
+    float capacity;
+    float rest_soc;
+    uint16_t dod_histogram[SOH_DOD_BIN_COUNT];
+    bool rest_valid;
+    SocSnapshot soc;
+} SohState;
+
+/**
+ * @brief State of health handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @param state The persistent state
+ * @param last_charge The value of the charge counter of the current module at the last update
+ * @param last_resting True if the pack was at rest during the last update
+ * @param save_time The time of the last save in ticks
+ * @param started True if the first state of charge value has been received
+ * @param extreme The state of charge of the current local extreme
+ * @param direction The direction of the state of charge variation (1 rising, -1 falling, 0 unknown)
+ * @param reversals The stack of the reversal points not yet counted as cycles
+ * @param reversal_count The number of elements of the stack
+ */
+typedef struct {
+    SohState state;
+
+    uint32_t last_charge;
+    bool last_resting;
+    ticks_t save_time;
+
+    bool started;
+    float extreme;
+    int8_t direction;
+    float reversals[SOH_RAINFLOW_STACK_SIZE];
+    size_t reversal_count;
+} _SohHandler;
+
+#ifdef CONF_SOH_MODULE_ENABLE
+
+/**
+ * @brief Initialize the state of health module
+ *
+ * @details The saved state is loaded from the EEPROM and the
+ * state of charge is restored from its snapshot
+ *
+ * @attention The storage and state of charge modules must be initialized before this function
+ *
+ * @return SohReturnCode
+ *     - SOH_NOT_RESTORED if no valid state is found and the default values are used
+ *     - SOH_OK otherwise
+ */
+SohReturnCode soh_init(void);
+
+/**
+ * @brief Update the throughput, the cycle count and the capacity estimation
+ *
+ * @details The state is saved every SOH_SAVE_INTERVAL_MS
+ */
+void soh_update(void);
+
+/**
+ * @brief Get the state of health of the pack
+ *
+ * @return float The ratio between the estimated and nominal capacity
+ */
+float soh_get_soh(void);
+
+/**
+ * @brief Get the estimated capacity of a group of parallel cells
+ *
+ * @return float The capacity in As
+ */
+float soh_get_capacity(void);
+
+/**
+ * @brief Get the number of equivalent full cycles
+ *
+ * @details The value is the total charge delivered divided by the nominal capacity
+ *
+ * @return float The number of equivalent full cycles
+ */
+float soh_get_equivalent_cycles(void);
+
+/**
+ * @brief Get the persistent state of health data
+ *
+ * @return const SohState* A pointer to the state
+ */
+const SohState * soh_get_state(void);
+
+#else  // CONF_SOH_MODULE_ENABLE
+
+#define soh_init() (SOH_OK)
+#define soh_update() MAINBOARD_NOPE()
+#define soh_get_soh() (1.f)
+#define soh_get_capacity() (SOC_CAPACITY_AS)
+#define soh_get_equivalent_cycles() (0.f)
+#define soh_get_state() (NULL)
+
+#endif  // CONF_SOH_MODULE_ENABLE
+
+#endif  // SOH_H
@@ -0,0 +1,157 @@
+/**
+ * @file sop.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief State of power estimation, i.e. the maximum current and power that
+ * can be drawn from or supplied to the pack for a given amount of time
+ *
+ * @details The cells are modeled as a voltage source with a series resistance that
+ * grows with the duration of the pulse because of the polarization.
+ * The current limit is the lowest between the one that brings the weakest cell to
+ * its voltage limit, the one allowed by the temperature derating, the remaining charge
+ * of the most discharged (or the room left in the most charged) segment and the
+ * limits enforced by the current module
+ */
+
+#ifndef SOP_H
+#define SOP_H
+
+#include <stddef.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "primary_network.h"
+
+/** @brief Interval between two updates of the limits in ms */
+#define SOP_UPDATE_INTERVAL_MS (10U)
+
+/** @brief Fraction of the absolute limits used so that the errors are not triggered */
+#define SOP_LIMIT_MARGIN (0.95f)
+/** @brief Margin from the cells voltage limits in V */
+#define SOP_VOLTAGE_MARGIN_V (0.05f)
+
+/** @brief Increase of the cell resistance for each horizon because of the polarization */
+#define SOP_RESISTANCE_FACTOR_2S (1.2f)
+#define SOP_RESISTANCE_FACTOR_10S (1.6f)
+
+/**
+ * @brief Temperatures in °C at which the current derating starts
+ *
+ * @details The limits decrease linearly reaching zero at the maximum allowed temperature
+ * or, for the charge at low temperature, at 0 °C
+ */
+#define SOP_DISCHARGE_DERATING_HIGH_C (50.f)
+#define SOP_CHARGE_DERATING_HIGH_C (45.f)
+#define SOP_CHARGE_DERATING_LOW_C (10.f)
+
+/**
+ * @brief Return code for the state of power module functions
+ *
+ * @details
+ *     - SOP_OK the function executed successfully
+ */
+typedef enum {
+    SOP_OK
+} SopReturnCode;
+
+/**
+ * @brief Time horizons for which the limits are computed
+ *
+ * @details
+ *     - SOP_HORIZON_2S limits valid for a 2 s pulse
+ *     - SOP_HORIZON_10S limits valid for a 10 s pulse
+ */
+typedef enum {
+    SOP_HORIZON_2S,
+    SOP_HORIZON_10S,
+    SOP_HORIZON_COUNT
+} SopHorizon;
+
+/**
+ * @brief Current and power limits for a single horizon
+ *
+ * @details All the values are positive
+ *
+ * @param discharge_current The maximum discharge current in A
+ * @param charge_current The maximum charge current in A
+ * @param discharge_power The maximum discharge power in kW
+ * @param charge_power The maximum charge power in kW
+ */
+typedef struct {
+    ampere_t discharge_current;
+    ampere_t charge_current;
+    kilowatt_t discharge_power;
+    kilowatt_t charge_power;
+} SopLimits;
+
+/**
+ * @brief State of power handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @param limits The limits of each horizon
+ * @param horizon The horizon of the next payload sent via CAN
+ * @param power_limits_can_payload The canlib payload of the limits
+ */
+typedef struct {
+    SopLimits limits[SOP_HORIZON_COUNT];
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    SopHorizon horizon;
+    primary_hv_power_limits_converted_t power_limits_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+} _SopHandler;
+
+#ifdef CONF_SOP_MODULE_ENABLE
+
+/**
+ * @brief Initialize the state of power module
+ *
+ * @details All the limits are zero until the first update
+ *
+ * @return SopReturnCode
+ *     - SOP_OK
+ */
+SopReturnCode sop_init(void);
+
+/**
+ * @brief Update the limits with the latest measurements
+ */
+void sop_update(void);
+
+/**
+ * @brief Get the limits for a given horizon
+ *
+ * @param horizon The time horizon
+ *
+ * @return const SopLimits* A pointer to the limits or NULL if the horizon is not valid
+ */
+const SopLimits * sop_get_limits(const SopHorizon horizon);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload of the power limits
+ *
+ * @details Every call returns the payload of the next horizon
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_power_limits_converted_t* A pointer to the payload
+ */
+primary_hv_power_limits_converted_t * sop_get_power_limits_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#else  // CONF_SOP_MODULE_ENABLE
+
+#define sop_init() (SOP_OK)
+#define sop_update() MAINBOARD_NOPE()
+#define sop_get_limits(horizon) (NULL)
+#define sop_get_power_limits_canlib_payload(byte_size) (NULL)
+
+#endif  // CONF_SOP_MODULE_ENABLE
+
+#endif  // SOP_H
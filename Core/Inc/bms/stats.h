@@ -0,0 +1,79 @@
+/**
+ * @file stats.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Statistics functions shared by the measurement modules
+ *
+ * @details The functions are implemented using the CMSIS-DSP library when
+ * the CONF_STATS_CMSIS_DSP_ENABLE option is set and the code is compiled for
+ * an ARM target, otherwise a portable C implementation is used
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+/**
+ * @brief Get the minimum value of an array
+ *
+ * @attention The number of values must be greater than zero
+ *
+ * @param data The array of values
+ * @param count The number of values
+ * @param index[out] A pointer where the index of the minimum value is stored (can be NULL)
+ *
+ * @return float The minimum value
+ */
+float stats_min_f32(const float * const data, const size_t count, size_t * const index);
+
+/**
+ * @brief Get the maximum value of an array
+ *
+ * @attention The number of values must be greater than zero
+ *
+ * @param data The array of values
+ * @param count The number of values
+ * @param index[out] A pointer where the index of the maximum value is stored (can be NULL)
+ *
+ * @return float The maximum value
+ */
+float stats_max_f32(const float * const data, const size_t count, size_t * const index);
+
+/**
+ * @brief Get the sum of the values of an array
+ *
+ * @param data The array of values
+ * @param count The number of values
+ *
+ * @return float The sum of the values
+ */
+float stats_sum_f32(const float * const data, const size_t count);
+
+/**
+ * @brief Get the mean value of an array
+ *
+ * @attention The number of values must be greater than zero
+ *
+ * @param data The array of values
+ * @param count The number of values
+ *
+ * @return float The mean value
+ */
+float stats_mean_f32(const float * const data, const size_t count);
+
+/**
+ * @brief Get the sample standard deviation of the values of an array
+ *
+ * @param data The array of values
+ * @param count The number of values
+ *
+ * @return float The standard deviation or 0 if there are less than two values
+ */
+float stats_std_f32(const float * const data, const size_t count);
+
+#endif  // STATS_H
@@ -0,0 +1,299 @@
+/**
+ * @file storage.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Persistent storage of data inside the external EEPROM
+ *
+ * @details The EEPROM is divided into regions, each one containing a fixed
+ * number of slots used as a ring buffer: every save writes the next slot so that
+ * the wear is spread across the whole region and a record interrupted by a reset
+ * never overwrites the last valid one.
+ * Each record starts with a header containing an increasing sequence number,
+ * the size of the data and a CRC used to validate the record.
+ * The slots are always written in order starting from the first one, so the
+ * sequence numbers along a region are sorted except for a single rotation point
+ * and the newest record is found at boot with a binary search on the headers
+ *
+ * @details The records are written asynchronously one page at a time
+ * by the storage routine so that the main loop is never blocked waiting
+ * for the write cycles of the EEPROM
+ */
+
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "m95256.h"
+
+/** @brief Interval between two executions of the storage routine in ms */
+#define STORAGE_ROUTINE_INTERVAL_MS (M95256_WRITE_TIME_MS)
+
+/**
+ * @brief Maximum number of attempts while waiting for the EEPROM at startup
+ *
+ * @details Polling the status register takes at least a microsecond on the
+ * SPI bus, so the attempts cover a whole write cycle before giving up
+ */
+#define STORAGE_BUSY_RETRY_COUNT (M95256_WRITE_TIME_MS * 1000U)
+
+/**
+ * @brief Layout of the state of health region
+ *
+ * @details With a record saved every minute each slot is written
+ * every 16 minutes of operation
+ */
+#define STORAGE_SOH_BASE_ADDRESS (0x0000U)
+#define STORAGE_SOH_SLOT_SIZE (128U)
+#define STORAGE_SOH_SLOT_COUNT (16U)
+
+/**
+ * @brief Layout of the event log region
+ *
+ * @details Each slot contains a single event and four slots share a page
+ */
+#define STORAGE_EVENT_LOG_BASE_ADDRESS (STORAGE_SOH_BASE_ADDRESS + STORAGE_SOH_SLOT_SIZE * STORAGE_SOH_SLOT_COUNT)
+#define STORAGE_EVENT_LOG_SLOT_SIZE (16U)
+#define STORAGE_EVENT_LOG_SLOT_COUNT (1024U)
+
+/**
+ * @brief Layout of the black box region
+ *
+ * @details The region fills the rest of the EEPROM and each slot contains
+ * a chunk of a compressed capture
+ */
+#define STORAGE_BLACK_BOX_BASE_ADDRESS (STORAGE_EVENT_LOG_BASE_ADDRESS + STORAGE_EVENT_LOG_SLOT_SIZE * STORAGE_EVENT_LOG_SLOT_COUNT)
+#define STORAGE_BLACK_BOX_SLOT_SIZE (64U)
+#define STORAGE_BLACK_BOX_SLOT_COUNT (224U)
+
+/** @brief Maximum size of a slot in bytes */
+#define STORAGE_SLOT_SIZE_MAX (128U)
+
+/**
+ * @brief Return code for the storage module functions
+ *
+ * @details
+ *     - STORAGE_OK the function executed successfully
+ *     - STORAGE_NULL_POINTER a NULL pointer is given as parameter
+ *     - STORAGE_OUT_OF_BOUNDS the region is not valid, the data does not fit inside a slot or the record has been overwritten
+ *     - STORAGE_BUSY another record or the EEPROM are being written
+ *     - STORAGE_EMPTY no valid record is found
+ */
+typedef enum {
+    STORAGE_OK,
+    STORAGE_NULL_POINTER,
+    STORAGE_OUT_OF_BOUNDS,
+    STORAGE_BUSY,
+    STORAGE_EMPTY
+} StorageReturnCode;
+
+/**
+ * @brief Regions of the EEPROM
+ *
+ * @details
+ *     - STORAGE_REGION_SOH state of health and state of charge data
+ *     - STORAGE_REGION_EVENT_LOG log of the system events
+ *     - STORAGE_REGION_BLACK_BOX captures of the pack state before a fatal error
+ */
+typedef enum {
+    STORAGE_REGION_SOH,
+    STORAGE_REGION_EVENT_LOG,
+    STORAGE_REGION_BLACK_BOX,
+    STORAGE_REGION_COUNT
+} StorageRegion;
+
+/**
+ * @brief Layout of a single region
+ *
+ * @param base The address of the first slot
+ * @param slot_size The size of a single slot in bytes
+ * @param slot_count The number of slots
+ */
+typedef struct {
+    m95256_address_t base;
+    size_t slot_size;
+    size_t slot_count;
+} StorageRegionLayout;
+
+/**
+ * @brief Header of a record
+ *
+ * @details The CRC is calculated on the sequence number, the size and the data
+ *
+ * @param sequence The sequence number of the record
+ * @param size The size of the data in bytes
+ * @param crc The CRC of the record
+ */
+typedef struct {
+    uint32_t sequence;
+    uint16_t size;
+    uint16_t crc;
+} StorageRecordHeader;
+
+/**
+ * @brief Storage handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @param eeprom The EEPROM driver handler
+ * @param sequence The sequence number of the newest record of each region (0 if the region is empty)
+ * @param pending True if a record is being written
+ * @param address The address of the next byte of the record to write
+ * @param offset The number of bytes of the record already written
+ * @param size The total size of the record being written in bytes
+ * @param buffer The record being written
+ */
+typedef struct {
+    M95256Handler eeprom;
+    uint32_t sequence[STORAGE_REGION_COUNT];
+
+    bool pending;
+    m95256_address_t address;
+    size_t offset;
+    size_t size;
+    uint8_t buffer[STORAGE_SLOT_SIZE_MAX];
+} _StorageHandler;
+
+#ifdef CONF_STORAGE_MODULE_ENABLE
+
+/**
+ * @brief Initialize the storage module
+ *
+ * @details The newest record of each region is searched reading a number
+ * of headers proportional to the logarithm of the number of slots
+ *
+ * @attention This function waits for the EEPROM and should be called only at startup
+ *
+ * @details If the EEPROM stays busy for more than STORAGE_BUSY_RETRY_COUNT attempts
+ * the region is considered empty
+ *
+ * @param send A pointer to the callback used to send data via SPI
+ * @param send_receive A pointer to the callback used to send and receive data via SPI
+ *
+ * @return StorageReturnCode
+ *     - STORAGE_NULL_POINTER if any of the parameter is NULL
+ *     - STORAGE_BUSY if the EEPROM did not respond in time for any of the regions
+ *     - STORAGE_OK otherwise
+ */
+StorageReturnCode storage_init(const spi_send_callback_t send, const spi_send_receive_callback_t send_receive);
+
+/**
+ * @brief Load the newest valid record of a region
+ *
+ * @details If the CRC of the newest record is not valid the previous ones are used instead
+ *
+ * @attention This function waits for the EEPROM, completing the record being written
+ * if any, and should be called only at startup
+ *
+ * @details Every wait is bounded by STORAGE_BUSY_RETRY_COUNT attempts, restarted
+ * after each page of the record being written
+ *
+ * @param region The region to read from
+ * @param out[out] A pointer where the data is copied
+ * @param size The expected size of the data in bytes
+ *
+ * @return StorageReturnCode
+ *     - STORAGE_NULL_POINTER if the output pointer is NULL
+ *     - STORAGE_OUT_OF_BOUNDS if the region is not valid or the data does not fit inside a slot
+ *     - STORAGE_BUSY if the record being written can not be completed in time
+ *     - STORAGE_EMPTY if no valid record with the given size is found or the EEPROM did not respond in time
+ *     - STORAGE_OK otherwise
+ */
+StorageReturnCode storage_load(const StorageRegion region, void * const out, const size_t size);
+
+/**
+ * @brief Save a new record inside the next slot of a region
+ *
+ * @details The data is copied and written in background by the storage routine
+ *
+ * @param region The region to write to
+ * @param data A pointer to the data to save
+ * @param size The size of the data in bytes
+ *
+ * @return StorageReturnCode
+ *     - STORAGE_NULL_POINTER if the data pointer is NULL
+ *     - STORAGE_OUT_OF_BOUNDS if the region is not valid or the data does not fit inside a slot
+ *     - STORAGE_BUSY if the previous record has not been written yet
+ *     - STORAGE_OK otherwise
+ */
+StorageReturnCode storage_save(const StorageRegion region, const void * const data, const size_t size);
+
+/**
+ * @brief Read a single record of a region
+ *
+ * @details The function does not wait for the EEPROM
+ *
+ * @param region The region to read from
+ * @param sequence The sequence number of the record
+ * @param out[out] A pointer where the data is copied
+ * @param size The expected size of the data in bytes
+ *
+ * @return StorageReturnCode
+ *     - STORAGE_NULL_POINTER if the output pointer is NULL
+ *     - STORAGE_OUT_OF_BOUNDS if the region is not valid, the data does not fit inside a slot
+ *       or the record does not exist anymore
+ *     - STORAGE_BUSY if the EEPROM is being written
+ *     - STORAGE_EMPTY if the record is not valid
+ *     - STORAGE_OK otherwise
+ */
+StorageReturnCode storage_read(
+    const StorageRegion region,
+    const uint32_t sequence,
+    void * const out,
+    const size_t size
+);
+
+/**
+ * @brief Get the sequence number of the newest record of a region
+ *
+ * @details The sequence numbers start from 1 and are incremented for every saved record
+ *
+ * @param region The region
+ *
+ * @return uint32_t The sequence number or 0 if the region is empty or not valid
+ */
+uint32_t storage_get_sequence(const StorageRegion region);
+
+/**
+ * @brief Get the number of records that are still stored in a region
+ *
+ * @param region The region
+ *
+ * @return size_t The number of records
+ */
+size_t storage_get_count(const StorageRegion region);
+
+/**
+ * @brief Check if a record is being written
+ *
+ * @return bool True if a record is being written, false otherwise
+ */
+bool storage_is_busy(void);
+
+/**
+ * @brief Write the next chunk of the pending record
+ *
+ * @details At most a single page is written for each call
+ */
+void storage_routine(void);
+
+#else  // CONF_STORAGE_MODULE_ENABLE
+
+#define storage_init(send, send_receive) (STORAGE_OK)
+#define storage_load(region, out, size) (STORAGE_EMPTY)
+#define storage_save(region, data, size) (STORAGE_OK)
+#define storage_read(region, sequence, out, size) (STORAGE_EMPTY)
+#define storage_get_sequence(region) (0U)
+#define storage_get_count(region) (0U)
+#define storage_is_busy() (false)
+#define storage_routine() MAINBOARD_NOPE()
+
+#endif  // CONF_STORAGE_MODULE_ENABLE
+
+#endif  // STORAGE_H
@@ -0,0 +1,153 @@
+/**
+ * @file tdma.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Time division of the BMS network between the cellboards
+ *
+ * @details The mainboard periodically broadcasts a sync frame on the BMS network
+ * which marks the start of a new cycle, each cellboard is then allowed to transmit
+ * only inside its own slot which starts SLOT_TIME * ID milliseconds after the sync
+ */
+
+#ifndef TDMA_H
+#define TDMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "bms_network.h"
+
+/** @brief Duration of a full cycle and of a single cellboard slot in ms */
+#define TDMA_CYCLE_TIME_MS (60U)
+#define TDMA_SLOT_TIME_MS ((TDMA_CYCLE_TIME_MS) / (CELLBOARD_COUNT))
+
+/**
+ * @brief Return code for the TDMA module functions
+ *
+ * @details
+ *     - TDMA_OK the function executed successfully
+ *     - TDMA_OUT_OF_BOUNDS an index (or pointer) value is greater/lower than the maximum/minimum allowed value
+ *     - TDMA_NOT_SYNCED no sync frame has been sent yet
+ */
+typedef enum {
+    TDMA_OK,
+    TDMA_OUT_OF_BOUNDS,
+    TDMA_NOT_SYNCED
+} TdmaReturnCode;
+
+/**
+ * @brief Slot adherence statistics of a single cellboard
+ *
+ * @param received The total number of frames received after the first sync
+ * @param in_slot The number of frames received inside the assigned slot
+ * @param out_of_slot The number of frames received outside the assigned slot
+ * @param max_offset The maximum delay from the start of the slot in ticks
+ */
+typedef struct {
+    uint32_t received;
+    uint32_t in_slot;
+    uint32_t out_of_slot;
+    ticks_t max_offset;
+} TdmaSlotStats;
+
+/**
+ * @brief TDMA handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @param synced True if at least one sync frame has been sent
+ * @param cycle The counter of the sent sync frames
+ * @param sync_time The time when the last sync frame was sent in ticks
+ * @param cycle_time The duration of a cycle in ticks
+ * @param slot_time The duration of a slot in ticks
+ * @param stats The slot adherence statistics of each cellboard
+ * @param sync_can_payload The canlib payload of the sync frame
+ */
+typedef struct {
+    bool synced;
+    uint8_t cycle;
+    ticks_t sync_time;
+    ticks_t cycle_time;
+    ticks_t slot_time;
+
+    TdmaSlotStats stats[CELLBOARD_COUNT];
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    bms_mainboard_sync_converted_t sync_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+} _TdmaHandler;
+
+#ifdef CONF_TDMA_MODULE_ENABLE
+
+/**
+ * @brief Initialize the TDMA module
+ *
+ * @attention The timebase has to be initialized before this function is called
+ *
+ * @return TdmaReturnCode
+ *     - TDMA_OK
+ */
+TdmaReturnCode tdma_init(void);
+
+/**
+ * @brief Notify the reception of a frame sent by a cellboard
+ *
+ * @details The frame is counted as in slot if it has been received inside
+ * the window assigned to the cellboard in the current cycle
+ *
+ * @param id The identifier of the cellboard that sent the frame
+ * @param timestamp The time of reception of the frame in ticks
+ *
+ * @return TdmaReturnCode
+ *     - TDMA_OUT_OF_BOUNDS the cellboard identifier is not valid
+ *     - TDMA_NOT_SYNCED no sync frame has been sent yet
+ *     - TDMA_OK otherwise
+ */
+TdmaReturnCode tdma_notify_reception(const CellboardId id, const ticks_t timestamp);
+
+/**
+ * @brief Get the slot adherence statistics of a cellboard
+ *
+ * @param id The cellboard identifier
+ *
+ * @return TdmaSlotStats* A pointer to the statistics or NULL if the id is not valid
+ */
+const TdmaSlotStats * tdma_get_slot_stats(const CellboardId id);
+
+/**
+ * @brief Reset the slot adherence statistics of every cellboard
+ */
+void tdma_reset_slot_stats(void);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload of the sync frame
+ *
+ * @attention Calling this function starts a new cycle so the payload should be
+ * sent immediately afterwards
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return bms_mainboard_sync_converted_t* A pointer to the payload
+ */
+bms_mainboard_sync_converted_t * tdma_get_sync_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#else  // CONF_TDMA_MODULE_ENABLE
+
+#define tdma_init() (TDMA_OK)
+#define tdma_notify_reception(id, timestamp) (TDMA_OK)
+#define tdma_get_slot_stats(id) (NULL)
+#define tdma_reset_slot_stats() MAINBOARD_NOPE()
+#define tdma_get_sync_canlib_payload(byte_size) (NULL)
+
+#endif  // CONF_TDMA_MODULE_ENABLE
+
+#endif  // TDMA_H
@@ -9,11 +9,17 @@
 #ifndef TEMP_H
 #define TEMP_H
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
 #include "mainboard-def.h"
 #include "mainboard-conf.h"
 
 #include "primary_network.h"
 #include "bms_network.h"
+#include "fixed-point.h"
+#include "freshness.h"
 
 /** @brief Minimum and maximum allowed cell temperature in celsius */
 #define TEMP_MIN_C (-10.f)
@@ -22,6 +28,33 @@
 /** @brief Number of temperatures sent in a single temp can message */
 #define TEMP_NUM_TEMP_CAN_MESSAGE (4U)
 
+/** @brief Number of words of the bitmaps used to store a flag for each sensor of a segment */
+#define TEMP_BITMAP_WORD_COUNT (((CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT) + 31U) / 32U)
+
+/**
+ * @brief Number of leaves of the temperature index trees
+ *
+ * @details Each segment owns a block of TEMP_TREE_SEGMENT_LEAF_COUNT leaves so that
+ * its values are contained in a single subtree, both values have to be powers of two
+ * and greater than or equal to the number of sensors of a segment and the total
+ * number of segment leaves respectively
+ *
+ * @details Only the TEMP_TREE_LEAF_COUNT - 1 internal nodes are stored since the
+ * value of a leaf depends only on its position, so each tree takes 1 KiB of RAM
+ */
+#define TEMP_TREE_SEGMENT_LEAF_COUNT (64U)
+#define TEMP_TREE_LEAF_COUNT (512U)
+/** @brief Depth of the temperature index trees */
+#define TEMP_TREE_DEPTH (9U)
+/** @brief Value of an empty node of the temperature index trees */
+#define TEMP_TREE_NONE (UINT16_MAX)
+
+/** @brief Maximum number of sensors that can be retrieved by the top-k functions */
+#define TEMP_TOP_K_MAX_COUNT (8U)
+/** @brief Number of hottest sensors sent via CAN and number of sensors in a single message */
+#define TEMP_HOTTEST_COUNT (TEMP_TOP_K_MAX_COUNT)
+#define TEMP_HOTTEST_PER_CAN_MESSAGE (2U)
+
 /**
  * @brief Return code for the temperature module functions
  *
@@ -39,28 +72,77 @@ typedef enum {
 } TempReturnCode;
 
 /**
- * @brief Type definition for a matrix of cells temperatures in °C
+ * @brief Type definition and conversion macros of a single stored cell temperature
+ *
+ * @details If the fixed-point storage is enabled the temperatures are stored
+ * in tenths of °C otherwise they are stored in °C
+ */
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+typedef int16_t temp_cell_t;
+#define TEMP_CELL_FROM_CELSIUS(C) (FIXED_POINT_DECICELSIUS_FROM_CELSIUS(C))
+#define TEMP_CELL_TO_CELSIUS(T) (FIXED_POINT_CELSIUS_FROM_DECICELSIUS(T))
+#else  // CONF_CELLS_FIXED_POINT_ENABLE
+typedef celsius_t temp_cell_t;
+#define TEMP_CELL_FROM_CELSIUS(C) ((celsius_t)(C))
+#define TEMP_CELL_TO_CELSIUS(T) ((celsius_t)(T))
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
+
+/**
+ * @brief Type definition for a matrix of cells temperatures
  *
  * @details The matrix contains a row for each cellboard and every column contains
  * the i-th voltage of each segment
+ *
+ * @details Use TEMP_CELL_TO_CELSIUS to convert the values to °C
  */
-typedef celsius_t cells_temp_t[CELLBOARD_COUNT][CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT];
+typedef temp_cell_t cells_temp_t[CELLBOARD_COUNT][CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT];
 
 /**
  * @brief Type definition for the temperature module handler structure
  *
  * @param temperatures The array of temperatures in °C
+ * @param min_tree Internal nodes of the tournament tree with the index of the coldest sensor of each subtree
+ * @param max_tree Internal nodes of the tournament tree with the index of the hottest sensor of each subtree
+ * @param segment_sum The sum of the temperatures of each segment
+ * @param sum The sum of the temperatures of the pack
+ * @param under Bitmap of the sensors whose temperature is below the minimum allowed value
+ * @param over Bitmap of the sensors whose temperature is above the maximum allowed value
+ * @param fresh Bitmap of the sensors updated since the end of the last sweep
+ * @param last_update The time of the last update of each sensor in ticks
+ * @param freshness The freshness and sweep tracking of the sensors
  * @param cellboard_id The cellboard identifier used when the canlib payload is sent
  * @param offset An offset used when the canlib payload is sent
  * @param temp_can_payload The canlib message payload for the cells temperatures
+ * @param temp_stats_can_payload The canlib message payload for the cells temperatures stats
+ * @param hottest The indices of the hottest sensors sent via CAN
+ * @param hottest_count The number of valid indices in the hottest array
+ * @param hottest_offset The offset of the next hottest sensor sent via CAN
+ * @param hottest_can_payload The canlib message payload for the hottest sensors
  */
 typedef struct {
     cells_temp_t temperatures;
+    uint16_t min_tree[TEMP_TREE_LEAF_COUNT];
+    uint16_t max_tree[TEMP_TREE_LEAF_COUNT];
+    celsius_t segment_sum[CELLBOARD_COUNT];
+    celsius_t sum;
+
+    bit_flag32_t under[CELLBOARD_COUNT][TEMP_BITMAP_WORD_COUNT];
+    bit_flag32_t over[CELLBOARD_COUNT][TEMP_BITMAP_WORD_COUNT];
+    bit_flag32_t fresh[FRESHNESS_WORD_COUNT(CELLBOARD_TEMP_SENSOR_COUNT)];
+    ticks_t last_update[CELLBOARD_COUNT][CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT];
+    Freshness freshness;
 
     CellboardId cellboard_id;
     size_t offset; 
     primary_hv_cells_temperature_converted_t temp_can_payload;
     primary_hv_cells_temp_stats_converted_t temp_stats_can_payload;
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    size_t hottest[TEMP_HOTTEST_COUNT];
+    size_t hottest_count;
+    size_t hottest_offset;
+    primary_hv_cells_temp_hottest_converted_t hottest_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
 } _TempHandler;
 
 #ifdef CONF_TEMPERATURE_MODULE_ENABLE
@@ -83,6 +165,9 @@ const cells_temp_t * temp_get_values(void);
 /**
  * @brief Get the minimum cell temperature in the pack
  *
+ * @details The temperatures are indexed every time new values are received
+ * so this function (and the other getters) runs in constant time
+ *
  * @return celsius_t The minimum temperature value in °C
  */
 celsius_t temp_get_min(void);
@@ -101,6 +186,59 @@ celsius_t temp_get_max(void);
  */
 celsius_t temp_get_sum(void);
 
+/**
+ * @brief Get the standard deviation of the cells temperatures of the pack
+ *
+ * @details Unlike the other aggregates the value is computed on request
+ *
+ * @return celsius_t The sample standard deviation in °C
+ */
+celsius_t temp_get_std(void);
+
+/**
+ * @brief Get the minimum temperature of a single segment
+ *
+ * @param id The cellboard identifier
+ *
+ * @return celsius_t The minimum temperature in °C or 0 if the id is not valid
+ */
+celsius_t temp_get_segment_min(const CellboardId id);
+
+/**
+ * @brief Get the maximum temperature of a single segment
+ *
+ * @param id The cellboard identifier
+ *
+ * @return celsius_t The maximum temperature in °C or 0 if the id is not valid
+ */
+celsius_t temp_get_segment_max(const CellboardId id);
+
+/**
+ * @brief Get the indices of the k hottest sensors of the pack
+ *
+ * @details The indices are sorted from the hottest to the coldest and are relative
+ * to the start of the pack, i.e. cellboard_id * CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT + offset
+ *
+ * @param k The number of sensors to retrieve (at most TEMP_TOP_K_MAX_COUNT)
+ * @param indices[out] The array where the indices are stored
+ *
+ * @return size_t The number of indices stored in the array
+ */
+size_t temp_get_top_k(size_t k, size_t * const indices);
+
+/**
+ * @brief Get the indices of the k hottest sensors of a single segment
+ *
+ * @details The indices have the same format of the ones returned by temp_get_top_k
+ *
+ * @param id The cellboard identifier
+ * @param k The number of sensors to retrieve (at most TEMP_TOP_K_MAX_COUNT)
+ * @param indices[out] The array where the indices are stored
+ *
+ * @return size_t The number of indices stored in the array
+ */
+size_t temp_get_segment_top_k(const CellboardId id, size_t k, size_t * const indices);
+
 /**
  * @brief Get the average cell temperature of the pack
  *
@@ -108,6 +246,54 @@ celsius_t temp_get_sum(void);
  */
 celsius_t temp_get_avg(void);
 
+/**
+ * @brief Get the number of complete sweeps of the pack
+ *
+ * @details A sweep is completed once every sensor of every cellboard
+ * has been updated at least once since the end of the previous sweep
+ *
+ * @details No callback is invoked at the end of a sweep, the counter has to be
+ * polled and compared with a previously stored value to run a computation
+ * exactly once per sweep
+ *
+ * @return uint32_t The number of completed sweeps
+ */
+uint32_t temp_get_sweep_count(void);
+
+/**
+ * @brief Get the time when the last sweep has been completed
+ *
+ * @return ticks_t The time in ticks
+ */
+ticks_t temp_get_sweep_time(void);
+
+/**
+ * @brief Check if a sensor has been updated since the end of the last sweep
+ *
+ * @param id The cellboard identifier
+ * @param offset The sensor offset of the segment
+ *
+ * @return bool True if the sensor has been updated, false otherwise or if the parameters are not valid
+ */
+bool temp_is_cell_fresh(const CellboardId id, const size_t offset);
+
+/**
+ * @brief Get the time elapsed since the last update of a single sensor
+ *
+ * @param id The cellboard identifier
+ * @param offset The sensor offset of the segment
+ *
+ * @return ticks_t The age of the temperature in ticks or 0 if the parameters are not valid
+ */
+ticks_t temp_get_cell_age(const CellboardId id, const size_t offset);
+
+/**
+ * @brief Get the age of the oldest temperature in the pack
+ *
+ * @return ticks_t The age of the oldest value in ticks
+ */
+ticks_t temp_get_data_age(void);
+
 /**
  * @brief Handle the received cellboard cells temperature
  *
@@ -133,6 +319,22 @@ primary_hv_cells_temperature_converted_t * temp_get_cells_temperature_canlib_pay
  */
 primary_hv_cells_temp_stats_converted_t * temp_get_cells_temperature_stats_canlib_payload(size_t * const byte_size);
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload of the hottest sensors of the pack
+ *
+ * @details Every call returns the next TEMP_HOTTEST_PER_CAN_MESSAGE sensors of the
+ * list which is updated only when all of its elements have been sent
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_cells_temp_hottest_converted_t* A pointer to the payload
+ */
+primary_hv_cells_temp_hottest_converted_t * temp_get_cells_temperature_hottest_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 #else
 
 #define temp_init() (TEMP_OK)
@@ -140,9 +342,20 @@ primary_hv_cells_temp_stats_converted_t * temp_get_cells_temperature_stats_canli
 #define temp_get_min() (NULL)
 #define temp_get_max() (NULL)
 #define temp_get_avg() (NULL)
+#define temp_get_std() (0.f)
+#define temp_get_segment_min(id) (0U)
+#define temp_get_segment_max(id) (0U)
+#define temp_get_top_k(k, indices) (0U)
+#define temp_get_segment_top_k(id, k, indices) (0U)
+#define temp_get_sweep_count() (0U)
+#define temp_get_sweep_time() (0U)
+#define temp_is_cell_fresh(id, offset) (false)
+#define temp_get_cell_age(id, offset) (0U)
+#define temp_get_data_age() (0U)
 #define temp_cells_temperature_handle(payload) MAINBOARD_NOPE()
 #define temp_get_cells_temperature_canlib_payload(byte_size) (NULL)
 #define temp_get_cells_temperature_stats_canlib_payload(byte_size) (NULL)
+#define temp_get_cells_temperature_hottest_canlib_payload(byte_size) (NULL)
 
 #endif  // CONF_TEMPERATURE_MODULE_ENABLE
 
@@ -23,6 +23,36 @@
 /**@brief Total number of tasks */
 #define TASKS_COUNT (TASKS_ID_COUNT)
 
+/**
+ * @brief List of the tasks that send messages missing from the pinned canlib
+ *
+ * @attention !!! DO NOT USE THIS MACRO OUTSIDE OF THIS FILE !!!
+ *
+ * @details The list is empty until the CONF_CANLIB_PENDING_MESSAGES_ENABLE option
+ * is defined, the parameters are the same of the TASKS_X_LIST below
+ *
+ * @details The TDMA sync changes the timing of the whole BMS network so it is
+ * disabled by default even when the option is defined
+ */
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+#define TASKS_X_CANLIB_PENDING_LIST \
+    TASKS_X(SEND_TDMA_SYNC, false, 0U, TDMA_CYCLE_TIME_MS, _tasks_send_tdma_sync) \
+    TASKS_X(SEND_DEBUG_CAN_STATS, false, 0U, 100U, _tasks_send_debug_can_stats) \
+    TASKS_X(SEND_DEBUG_CAN_BUFFERS, false, 0U, 100U, _tasks_send_debug_can_buffers) \
+    TASKS_X(SEND_CELLS_TEMPERATURE_HOTTEST, true, 10U, PRIMARY_HV_CELLS_TEMP_HOTTEST_CYCLE_TIME_MS, _tasks_send_hv_cells_temperature_hottest) \
+    TASKS_X(SEND_WEAK_CELLS, true, 10U, PRIMARY_HV_WEAK_CELLS_CYCLE_TIME_MS, _tasks_send_hv_weak_cells) \
+    TASKS_X(SEND_CELLS_RESISTANCE, true, 10U, PRIMARY_HV_CELLS_RESISTANCE_CYCLE_TIME_MS, _tasks_send_hv_cells_resistance) \
+    TASKS_X(SEND_SOC_ESTIMATION, true, 10U, PRIMARY_HV_SOC_ESTIMATION_CYCLE_TIME_MS, _tasks_send_hv_soc_estimation) \
+    TASKS_X(SEND_SEGMENT_SOC, true, 10U, PRIMARY_HV_SEGMENT_SOC_CYCLE_TIME_MS, _tasks_send_hv_segment_soc) \
+    TASKS_X(SEND_POWER_LIMITS, true, 5U, PRIMARY_HV_POWER_LIMITS_CYCLE_TIME_MS, _tasks_send_hv_power_limits) \
+    TASKS_X(SEND_EVENT_LOG, false, 0U, EVENT_LOG_DUMP_INTERVAL_MS, _tasks_send_event_log) \
+    TASKS_X(SEND_BLACK_BOX, false, 0U, BLACK_BOX_DUMP_INTERVAL_MS, _tasks_send_black_box) \
+    TASKS_X(SEND_ERROR_REPORT, true, 0U, ERROR_REPORT_INTERVAL_MS, _tasks_send_error_report) \
+    TASKS_X(SEND_CONTACTOR_LATENCY, true, 10U, FEEDBACK_CONTACTOR_LATENCY_INTERVAL_MS, _tasks_send_hv_contactor_latency)
+#else  // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+#define TASKS_X_CANLIB_PENDING_LIST
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 /**
  * @brief List of tasks parameters
  *
@@ -65,9 +95,15 @@
     TASKS_X(SEND_IMD_STATUS, true, 0U, PRIMARY_HV_IMD_STATUS_CYCLE_TIME_MS, _tasks_send_hv_imd_status) \
     TASKS_X(SEND_CELLBOARD_SET_BALANCING_STATUS, false, 0U, BMS_CELLBOARD_SET_BALANCING_STATUS_CYCLE_TIME_MS, _tasks_send_cellboard_set_balancing_status) \
     TASKS_X(SEND_ERRORS, false, 0U, PRIMARY_HV_ERROR_CYCLE_TIME_MS, _tasks_send_errors) \
-    TASKS_X(READ_DIGITAL_FEEDBACKS, true, 0U, FEEDBACK_CYCLE_TIME_MS, _tasks_read_digital_feedbacks) \
-    TASKS_X(START_ANALOG_CONVERSION_FEEDBACKS, true, 0U, FEEDBACK_CYCLE_TIME_MS, _tasks_start_analog_conversion_feedbacks) \
-    TASKS_X(UPDATE_FEEDBACKS_STATUS, true, 2U, FEEDBACK_CYCLE_TIME_MS, _tasks_update_feedbacks_status) \
+    TASKS_X_CANLIB_PENDING_LIST \
+    TASKS_X(UPDATE_SOC, true, 0U, SOC_UPDATE_INTERVAL_MS, _tasks_update_soc) \
+    TASKS_X(UPDATE_SOP, true, 0U, SOP_UPDATE_INTERVAL_MS, _tasks_update_sop) \
+    TASKS_X(UPDATE_SOH, true, 0U, SOH_UPDATE_INTERVAL_MS, _tasks_update_soh) \
+    TASKS_X(RECORD_BLACK_BOX, true, 0U, BLACK_BOX_SAMPLE_INTERVAL_MS, _tasks_record_black_box) \
+    TASKS_X(RUN_BLACK_BOX, true, 0U, STORAGE_ROUTINE_INTERVAL_MS, _tasks_run_black_box) \
+    TASKS_X(RUN_EVENT_LOG, true, 0U, STORAGE_ROUTINE_INTERVAL_MS, _tasks_run_event_log) \
+    TASKS_X(RUN_STORAGE, true, 0U, STORAGE_ROUTINE_INTERVAL_MS, _tasks_run_storage) \
+    TASKS_X(UPDATE_FEEDBACKS_STATUS, true, 0U, FEEDBACK_CYCLE_TIME_MS, _tasks_update_feedbacks_status) \
     TASKS_X(START_INTERNAL_VOLTAGE_CONVERSION, true, 0U, INTERNAL_VOLTAGE_CYCLE_TIME_MS, _tasks_start_internal_voltage_conversion) 
 
 /** @brief Convert a task name to the corresponding TasksId name */
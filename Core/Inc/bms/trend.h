@@ -0,0 +1,224 @@
+/**
+ * @file trend.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Cells voltage history and weak cells detection
+ *
+ * @details The voltage of each cell is decimated and stored in millivolts inside
+ * a ring buffer from which the rate of change of the voltage is computed with a
+ * least squares fit that is updated in constant time for each new sample
+ *
+ * @details The samples are assumed to be equally spaced in time, if a cell is not
+ * updated for more than TREND_GAP_PERIODS sample periods its history is discarded
+ *
+ * @details The memory used by the module is fixed and equal to
+ * CELLBOARD_SERIES_COUNT * (TREND_HISTORY_SIZE * 2 + 20) bytes plus the CAN payload,
+ * i.e. 12096 bytes with 144 cells and 32 samples of history
+ */
+
+#ifndef TREND_H
+#define TREND_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "primary_network.h"
+
+/** @brief Number of samples of the history of each cell */
+#define TREND_HISTORY_SIZE (32U)
+/** @brief Minimum time between two samples of the history in ms */
+#define TREND_SAMPLE_PERIOD_MS (250U)
+/** @brief Number of missed sample periods after which the history of a cell is discarded */
+#define TREND_GAP_PERIODS (4U)
+
+/** @brief Minimum absolute value of the current in A for the pack to be considered under load */
+#define TREND_LOAD_CURRENT_A (20.f)
+/**
+ * @brief Amount of mV/s that the voltage of a cell has to change faster than
+ * the pack average to be considered as a possible weak cell
+ */
+#define TREND_WEAK_SLOPE_MARGIN_MV_S (2.f)
+/** @brief Number of consecutive detections needed to flag a cell as weak */
+#define TREND_WEAK_THRESHOLD (8U)
+
+/**
+ * @brief Return code for the trend module functions
+ *
+ * @details
+ *     - TREND_OK the function executed successfully
+ *     - TREND_OUT_OF_BOUNDS an index (or pointer) value is greater/lower than the maximum/minimum allowed value
+ *     - TREND_NOT_READY not enough samples are available
+ */
+typedef enum {
+    TREND_OK,
+    TREND_OUT_OF_BOUNDS,
+    TREND_NOT_READY
+} TrendReturnCode;
+
+/**
+ * @brief History of a single cell
+ *
+ * @details The sums are used to update the slope of the least squares fit of the
+ * samples in constant time, the samples are indexed from 0 (oldest) to count - 1 (newest)
+ *
+ * @details The slope is stored as the numerator of the least squares formula
+ * N * sum(i * x) - sum(i) * sum(x) which is exact and can be accumulated without drift
+ *
+ * @param samples The ring buffer of samples in mV
+ * @param head The index of the oldest sample
+ * @param count The number of valid samples
+ * @param weak_count The counter of weak cell detections
+ * @param last_sample The time of the last sample in ticks
+ * @param sum The sum of the samples
+ * @param weighted_sum The sum of the samples multiplied by their index
+ * @param slope The numerator of the slope, valid only when the history is full
+ */
+typedef struct {
+    uint16_t samples[TREND_HISTORY_SIZE];
+    uint8_t head;
+    uint8_t count;
+    uint8_t weak_count;
+    ticks_t last_sample;
+    int32_t sum;
+    int32_t weighted_sum;
+    int32_t slope;
+} TrendCellHistory;
+
+/**
+ * @brief Trend handler structure
+ *
+ * @warning This structure should never be used outside of this file
+ *
+ * @param cells The history of each cell
+ * @param slope_sum The sum of the slope numerators of the cells with a full history
+ * @param slope_count The number of cells with a full history
+ * @param weak The bitmap of the weak cells of each segment
+ * @param cellboard_id The cellboard identifier of the next payload sent via CAN
+ * @param weak_cells_can_payload The canlib payload of the weak cells
+ */
+typedef struct {
+    TrendCellHistory cells[CELLBOARD_COUNT][CELLBOARD_SEGMENT_SERIES_COUNT];
+    int64_t slope_sum;
+    size_t slope_count;
+    bit_flag32_t weak[CELLBOARD_COUNT];
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    CellboardId cellboard_id;
+    primary_hv_weak_cells_converted_t weak_cells_can_payload;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+} _TrendHandler;
+
+#ifdef CONF_TREND_MODULE_ENABLE
+
+/**
+ * @brief Initialize the trend module
+ *
+ * @return TrendReturnCode
+ *     - TREND_OK
+ */
+TrendReturnCode trend_init(void);
+
+/**
+ * @brief Add a new voltage value to the history of a cell
+ *
+ * @details The value is discarded if less than TREND_SAMPLE_PERIOD_MS are elapsed
+ * since the last sample of the same cell
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ * @param value The voltage in V
+ * @param timestamp The time of reception of the value in ticks
+ *
+ * @return TrendReturnCode
+ *     - TREND_OUT_OF_BOUNDS the cellboard identifier or the offset are not valid
+ *     - TREND_OK otherwise
+ */
+TrendReturnCode trend_update(
+    const CellboardId id,
+    const size_t offset,
+    const volt_t value,
+    const ticks_t timestamp
+);
+
+/**
+ * @brief Get the rate of change of the voltage of a cell
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ * @param out[out] A pointer where the slope in mV/s is stored
+ *
+ * @return TrendReturnCode
+ *     - TREND_OUT_OF_BOUNDS the parameters are not valid
+ *     - TREND_NOT_READY the history of the cell is not full yet
+ *     - TREND_OK otherwise
+ */
+TrendReturnCode trend_get_slope(const CellboardId id, const size_t offset, float * const out);
+
+/**
+ * @brief Get the deviation of the last sample of a cell from the average voltage of the pack
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ * @param out[out] A pointer where the deviation in mV is stored
+ *
+ * @return TrendReturnCode
+ *     - TREND_OUT_OF_BOUNDS the parameters are not valid
+ *     - TREND_NOT_READY no sample of the cell is available
+ *     - TREND_OK otherwise
+ */
+TrendReturnCode trend_get_deviation(const CellboardId id, const size_t offset, float * const out);
+
+/**
+ * @brief Get the average rate of change of the voltage of the pack
+ *
+ * @return float The average slope in mV/s of the cells with a full history
+ */
+float trend_get_pack_slope(void);
+
+/**
+ * @brief Check if a cell has been flagged as weak
+ *
+ * @details A cell is weak if, while the pack is under load, its voltage changes
+ * in the same direction of the pack average but faster by more than TREND_WEAK_SLOPE_MARGIN_MV_S
+ * (i.e. it sags faster during discharge or rises faster during charge)
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ *
+ * @return bool True if the cell is weak, false otherwise or if the parameters are not valid
+ */
+bool trend_is_weak(const CellboardId id, const size_t offset);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Get a pointer to the CAN payload of the weak cells
+ *
+ * @details Every call returns the payload of the next cellboard
+ *
+ * @param byte_size[out] A pointer where the size of the payload in bytes is stored (can be NULL)
+ *
+ * @return primary_hv_weak_cells_converted_t* A pointer to the payload
+ */
+primary_hv_weak_cells_converted_t * trend_get_weak_cells_canlib_payload(size_t * const byte_size);
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#else  // CONF_TREND_MODULE_ENABLE
+
+#define trend_init() (TREND_OK)
+#define trend_update(id, offset, value, timestamp) (TREND_OK)
+#define trend_get_slope(id, offset, out) (TREND_NOT_READY)
+#define trend_get_deviation(id, offset, out) (TREND_NOT_READY)
+#define trend_get_pack_slope() (0.f)
+#define trend_is_weak(id, offset) (false)
+#define trend_get_weak_cells_canlib_payload(byte_size) (NULL)
+
+#endif  // CONF_TREND_MODULE_ENABLE
+
+#endif  // TREND_H
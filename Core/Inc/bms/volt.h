@@ -10,17 +10,24 @@
 #define VOLT_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 #include "mainboard-conf.h"
 #include "mainboard-def.h"
 
 #include "primary_network.h"
 #include "bms_network.h"
+#include "fixed-point.h"
+#include "freshness.h"
 
 /** @brief Minimum and maximum allowed cell voltage in V */
 #define VOLT_MIN_V (2.8f)
 #define VOLT_MAX_V (4.2f)
 
+/** @brief Number of words of the bitmaps used to store a flag for each cell of a segment */
+#define VOLT_BITMAP_WORD_COUNT (((CELLBOARD_SEGMENT_SERIES_COUNT) + 31U) / 32U)
+
 /**
  * @brief Return code for the voltage module functions
  *
@@ -36,12 +43,50 @@ typedef enum {
 } VoltReturnCode;
 
 /**
- * @brief Type definition for a the matrix of cells voltages in V
+ * @brief Type definition and conversion macros of a single stored cell voltage
+ *
+ * @details If the fixed-point storage is enabled the voltages are stored in mV
+ * otherwise they are stored in V
+ */
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+typedef uint16_t volt_cell_t;
+#define VOLT_CELL_FROM_VOLT(V) (FIXED_POINT_MILLIVOLT_FROM_VOLT(V))
+#define VOLT_CELL_TO_VOLT(C) (FIXED_POINT_VOLT_FROM_MILLIVOLT(C))
+#else  // CONF_CELLS_FIXED_POINT_ENABLE
+typedef volt_t volt_cell_t;
+#define VOLT_CELL_FROM_VOLT(V) ((volt_t)(V))
+#define VOLT_CELL_TO_VOLT(C) ((volt_t)(C))
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
+
+/**
+ * @brief Type definition for a the matrix of cells voltages
  *
  * @details The matrix contains a row for each cellboard and every column contains
  * the i-th voltage of each segment
+ *
+ * @details Use VOLT_CELL_TO_VOLT to convert the values to V
+ */
+typedef volt_cell_t cells_voltage_t[CELLBOARD_COUNT][CELLBOARD_SEGMENT_SERIES_COUNT];
+
+/**
+ * @brief Aggregated values of a group of cells voltages
+ *
+ * @details The indices are relative to the start of the pack, i.e.
+ * cellboard_id * CELLBOARD_SEGMENT_SERIES_COUNT + offset
+ *
+ * @param min The minimum voltage in V
+ * @param max The maximum voltage in V
+ * @param sum The sum of the voltages in V
+ * @param min_index The index of the cell with the minimum voltage
+ * @param max_index The index of the cell with the maximum voltage
  */
-typedef volt_t cells_voltage_t[CELLBOARD_COUNT][CELLBOARD_SEGMENT_SERIES_COUNT];
+typedef struct {
+    volt_t min;
+    volt_t max;
+    volt_t sum;
+    size_t min_index;
+    size_t max_index;
+} VoltAggregate;
 
 /**
  * @brief Voltages handler structure
@@ -49,12 +94,27 @@ typedef volt_t cells_voltage_t[CELLBOARD_COUNT][CELLBOARD_SEGMENT_SERIES_COUNT];
  * @warning This structure should never be used outside of this file
  *
  * @param voltages The array of cells voltages in V
+ * @param segments The aggregated values of each segment
+ * @param pack The aggregated values of the whole pack
+ * @param under Bitmap of the cells whose voltage is below the minimum allowed value
+ * @param over Bitmap of the cells whose voltage is above the maximum allowed value
+ * @param fresh Bitmap of the cells updated since the end of the last sweep
+ * @param last_update The time of the last update of each cell in ticks
+ * @param freshness The freshness and sweep tracking of the cells
  * @param volt_can_payload The canlib payload of the cells voltages
  * @param cellboard_id Cellboard identifier to set inside the payload
  * @param offset Cell offset to set inside the payload
  */
 typedef struct {
     cells_voltage_t voltages;
+    VoltAggregate segments[CELLBOARD_COUNT];
+    VoltAggregate pack;
+
+    bit_flag32_t under[CELLBOARD_COUNT][VOLT_BITMAP_WORD_COUNT];
+    bit_flag32_t over[CELLBOARD_COUNT][VOLT_BITMAP_WORD_COUNT];
+    bit_flag32_t fresh[FRESHNESS_WORD_COUNT(CELLBOARD_SERIES_COUNT)];
+    ticks_t last_update[CELLBOARD_COUNT][CELLBOARD_SEGMENT_SERIES_COUNT];
+    Freshness freshness;
 
     CellboardId cellboard_id;
     size_t offset;
@@ -82,6 +142,9 @@ const cells_voltage_t * volt_get_values(void);
 /**
  * @brief Get the minimum cell voltage in the pack
  *
+ * @details The aggregated values are updated every time new voltages are
+ * received so this function (and the other getters) runs in constant time
+ *
  * @return volt_t The minimum voltage in V
  */
 volt_t volt_get_min(void);
@@ -93,6 +156,60 @@ volt_t volt_get_min(void);
  */
 volt_t volt_get_max(void);
 
+/**
+ * @brief Get the standard deviation of the cells voltages of the pack
+ *
+ * @details Unlike the other aggregates the value is computed on request
+ *
+ * @return volt_t The sample standard deviation in V
+ */
+volt_t volt_get_std(void);
+
+/**
+ * @brief Get the index of the cell with the minimum voltage in the pack
+ *
+ * @return size_t The cell index (cellboard_id * CELLBOARD_SEGMENT_SERIES_COUNT + offset)
+ */
+size_t volt_get_min_index(void);
+
+/**
+ * @brief Get the index of the cell with the maximum voltage in the pack
+ *
+ * @return size_t The cell index (cellboard_id * CELLBOARD_SEGMENT_SERIES_COUNT + offset)
+ */
+size_t volt_get_max_index(void);
+
+/**
+ * @brief Count the number of cells whose voltage falls inside each bin of an histogram
+ *
+ * @details Voltages outside the histogram range are counted inside the first or last bin
+ *
+ * @param low The lower bound of the first bin in V
+ * @param width The width of each bin in V
+ * @param bins[out] The array of bins counters
+ * @param bin_count The number of bins
+ *
+ * @return VoltReturnCode
+ *     - VOLT_NULL_POINTER the bins array is NULL
+ *     - VOLT_OUT_OF_BOUNDS the number of bins or their width is not valid
+ *     - VOLT_OK otherwise
+ */
+VoltReturnCode volt_get_histogram(
+    const volt_t low,
+    const volt_t width,
+    uint16_t * const bins,
+    const size_t bin_count
+);
+
+/**
+ * @brief Get the aggregated voltages of a single segment
+ *
+ * @param id The cellboard identifier
+ *
+ * @return VoltAggregate* A pointer to the aggregated values or NULL if the id is not valid
+ */
+const VoltAggregate * volt_get_segment_aggregate(const CellboardId id);
+
 /**
  * @brief Get the average cell voltage of the pack
  *
@@ -107,6 +224,55 @@ volt_t volt_get_avg(void);
  */
 volt_t volt_get_sum(void);
 
+/**
+ * @brief Get the number of complete sweeps of the pack
+ *
+ * @details A sweep is completed once every cell of every cellboard
+ * has been updated at least once since the end of the previous sweep
+ * so the values can be considered as a coherent snapshot of the pack
+ *
+ * @details No callback is invoked at the end of a sweep, the counter has to be
+ * polled and compared with a previously stored value to run a computation
+ * exactly once per sweep
+ *
+ * @return uint32_t The number of completed sweeps
+ */
+uint32_t volt_get_sweep_count(void);
+
+/**
+ * @brief Get the time when the last sweep has been completed
+ *
+ * @return ticks_t The time in ticks
+ */
+ticks_t volt_get_sweep_time(void);
+
+/**
+ * @brief Check if a cell has been updated since the end of the last sweep
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ *
+ * @return bool True if the cell has been updated, false otherwise or if the parameters are not valid
+ */
+bool volt_is_cell_fresh(const CellboardId id, const size_t offset);
+
+/**
+ * @brief Get the time elapsed since the last update of a single cell
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ *
+ * @return ticks_t The age of the cell voltage in ticks or 0 if the parameters are not valid
+ */
+ticks_t volt_get_cell_age(const CellboardId id, const size_t offset);
+
+/**
+ * @brief Get the age of the oldest cell voltage in the pack
+ *
+ * @return ticks_t The age of the oldest value in ticks
+ */
+ticks_t volt_get_data_age(void);
+
 /**
  * @brief Handle the received cellboard cells voltage
  *
@@ -140,6 +306,16 @@ primary_hv_cells_voltage_stats_converted_t * volt_get_cells_voltage_stats_canlib
 #define volt_get_max() (VOLT_MAX_VALUE)
 #define volt_get_avg() (VOLT_MAX_VALUE)
 #define volt_get_sum() (VOLT_VALUE_TO_VOLT(VOLT_MAX_VALUE))
+#define volt_get_std() (0.f)
+#define volt_get_min_index() (0U)
+#define volt_get_max_index() (0U)
+#define volt_get_segment_aggregate(id) (NULL)
+#define volt_get_histogram(low, width, bins, bin_count) (VOLT_OK)
+#define volt_get_sweep_count() (0U)
+#define volt_get_sweep_time() (0U)
+#define volt_is_cell_fresh(id, offset) (false)
+#define volt_get_cell_age(id, offset) (0U)
+#define volt_get_data_age() (0U)
 #define volt_cells_voltage_handle(payload) MAINBOARD_NOPE()
 #define volt_get_cells_voltage_canlib_payload(byte_size) (NULL)
 #define volt_get_cells_voltage_stats_canlib_payload(byte_size) (NULL)
@@ -49,6 +49,37 @@
 #define CONF_FEEDBACK_MODULE_ENABLE
 #define CONF_ERROR_MODULE_ENABLE
 #define CONF_BALANCING_MODULE_ENABLE
+#define CONF_TDMA_MODULE_ENABLE
+#define CONF_TREND_MODULE_ENABLE
+#define CONF_RESISTANCE_MODULE_ENABLE
+#define CONF_SOC_MODULE_ENABLE
+#define CONF_SOP_MODULE_ENABLE
+#define CONF_STORAGE_MODULE_ENABLE
+#define CONF_SOH_MODULE_ENABLE
+#define CONF_EVENT_LOG_MODULE_ENABLE
+#define CONF_BLACK_BOX_MODULE_ENABLE
+
+/** @} */
+
+/*** ######################### MODULE OPTIONS ############################ ***/
+
+/**
+ * @defgroup options
+ * @brief Select optional features of the internal modules
+ * {@
+ */
+
+// Store cells voltages in mV and temperatures in tenths of °C as 16-bit fixed-point values
+// #define CONF_CELLS_FIXED_POINT_ENABLE
+
+// Use the CMSIS-DSP library for the statistics functions (ignored on non ARM builds)
+#define CONF_STATS_CMSIS_DSP_ENABLE
+
+/*
+ * Send and receive the messages of assets/can/networks that are missing from the
+ * pinned canlib, enable it only after the Core/Lib/can submodule has been updated
+ */
+// #define CONF_CANLIB_PENDING_MESSAGES_ENABLE
 
 /** @} */
 
@@ -77,6 +108,15 @@
 // #define CONF_FEEDBACK_STRINGS_ENABLE
 // #define CONF_ERROR_STRINGS_ENABLE
 // #define CONF_BALANCING_STRINGS_ENABLE
+// #define CONF_TDMA_STRINGS_ENABLE
+// #define CONF_TREND_STRINGS_ENABLE
+// #define CONF_RESISTANCE_STRINGS_ENABLE
+// #define CONF_SOC_STRINGS_ENABLE
+// #define CONF_SOP_STRINGS_ENABLE
+// #define CONF_STORAGE_STRINGS_ENABLE
+// #define CONF_SOH_STRINGS_ENABLE
+// #define CONF_EVENT_LOG_STRINGS_ENABLE
+// #define CONF_BLACK_BOX_STRINGS_ENABLE
 
 /** @} */
 
@@ -36,6 +36,8 @@ extern TIM_HandleTypeDef htim1;
 
 extern TIM_HandleTypeDef htim2;
 
+extern TIM_HandleTypeDef htim3;
+
 extern TIM_HandleTypeDef htim4;
 
 extern TIM_HandleTypeDef htim6;
@@ -45,6 +47,7 @@ extern TIM_HandleTypeDef htim7;
 /* USER CODE BEGIN Private defines */
 
 /** @brief Aliases for the timer handler */
+#define HTIM_ADC htim3
 #define HTIM_IMD htim4
 #define HTIM_TIMEBASE htim6
 #define HTIM_ERROR htim7
@@ -53,6 +56,7 @@ extern TIM_HandleTypeDef htim7;
 
 void MX_TIM1_Init(void);
 void MX_TIM2_Init(void);
+void MX_TIM3_Init(void);
 void MX_TIM4_Init(void);
 void MX_TIM6_Init(void);
 void MX_TIM7_Init(void);
@@ -79,6 +83,16 @@ void tim_update_error_timer(const uint32_t timestamp, const uint16_t timeout);
  */
 void tim_stop_error_timer(void);
 
+/**
+ * @brief Get the time elapsed since the start of the timebase
+ *
+ * @details The milliseconds of the timebase are extended with the counter of
+ * its timer which counts the microseconds inside the current millisecond
+ *
+ * @return uint32_t The elapsed time in us
+ */
+uint32_t tim_get_time_us(void);
+
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
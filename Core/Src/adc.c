@@ -23,6 +23,7 @@
 /* USER CODE BEGIN 0 */
 
 #include "mainboard-conf.h"
+#include "tim.h"
 
 #include "feedback.h"
 #include "cooling-temp.h"
@@ -56,11 +57,11 @@ void MX_ADC1_Init(void)
   hadc1.Init.ScanConvMode = ENABLE;
   hadc1.Init.ContinuousConvMode = DISABLE;
   hadc1.Init.DiscontinuousConvMode = DISABLE;
-  hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE;
-  hadc1.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+  hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+  hadc1.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T3_TRGO;
   hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
   hadc1.Init.NbrOfConversion = 15;
-  hadc1.Init.DMAContinuousRequests = DISABLE;
+  hadc1.Init.DMAContinuousRequests = ENABLE;
   hadc1.Init.EOCSelection = ADC_EOC_SEQ_CONV;
   if (HAL_ADC_Init(&hadc1) != HAL_OK)
   {
@@ -229,11 +230,11 @@ void MX_ADC3_Init(void)
   hadc3.Init.ScanConvMode = ENABLE;
   hadc3.Init.ContinuousConvMode = DISABLE;
   hadc3.Init.DiscontinuousConvMode = DISABLE;
-  hadc3.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE;
-  hadc3.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+  hadc3.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+  hadc3.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T3_TRGO;
   hadc3.Init.DataAlign = ADC_DATAALIGN_RIGHT;
   hadc3.Init.NbrOfConversion = 7;
-  hadc3.Init.DMAContinuousRequests = DISABLE;
+  hadc3.Init.DMAContinuousRequests = ENABLE;
   hadc3.Init.EOCSelection = ADC_EOC_SEQ_CONV;
   if (HAL_ADC_Init(&hadc3) != HAL_OK)
   {
@@ -377,6 +378,9 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef* adcHandle)
 
     __HAL_LINKDMA(adcHandle,DMA_Handle,hdma_adc1);
 
+    /* ADC1 interrupt Init */
+    HAL_NVIC_SetPriority(ADC_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(ADC_IRQn);
   /* USER CODE BEGIN ADC1_MspInit 1 */
 
   /* USER CODE END ADC1_MspInit 1 */
@@ -424,6 +428,9 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef* adcHandle)
 
     __HAL_LINKDMA(adcHandle,DMA_Handle,hdma_adc3);
 
+    /* ADC3 interrupt Init */
+    HAL_NVIC_SetPriority(ADC_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(ADC_IRQn);
   /* USER CODE BEGIN ADC3_MspInit 1 */
 
   /* USER CODE END ADC3_MspInit 1 */
@@ -468,6 +475,16 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef* adcHandle)
 
     /* ADC1 DMA DeInit */
     HAL_DMA_DeInit(adcHandle->DMA_Handle);
+
+    /* ADC1 interrupt Deinit */
+  /* USER CODE BEGIN ADC1:ADC_IRQn disable */
+    /**
+    * Uncomment the line below to disable the "ADC_IRQn" interrupt
+    * Be aware, disabling shared interrupt may affect other IPs
+    */
+    /* HAL_NVIC_DisableIRQ(ADC_IRQn); */
+  /* USER CODE END ADC1:ADC_IRQn disable */
+
   /* USER CODE BEGIN ADC1_MspDeInit 1 */
 
   /* USER CODE END ADC1_MspDeInit 1 */
@@ -494,6 +511,16 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef* adcHandle)
 
     /* ADC3 DMA DeInit */
     HAL_DMA_DeInit(adcHandle->DMA_Handle);
+
+    /* ADC3 interrupt Deinit */
+  /* USER CODE BEGIN ADC3:ADC_IRQn disable */
+    /**
+    * Uncomment the line below to disable the "ADC_IRQn" interrupt
+    * Be aware, disabling shared interrupt may affect other IPs
+    */
+    /* HAL_NVIC_DisableIRQ(ADC_IRQn); */
+  /* USER CODE END ADC3:ADC_IRQn disable */
+
   /* USER CODE BEGIN ADC3_MspDeInit 1 */
 
   /* USER CODE END ADC3_MspDeInit 1 */
@@ -502,8 +529,20 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef* adcHandle)
 
 /* USER CODE BEGIN 1 */
 
-_STATIC _VOLATILE raw_volt_t dma_data_1[ADC_1_CHANNEL_COUNT];
-_STATIC _VOLATILE raw_volt_t dma_data_2[ADC_2_CHANNEL_COUNT];
+_Static_assert(ADC_OVERSAMPLING_COUNT == FEEDBACK_OVERSAMPLING_MAX, "Each buffer must contain every sample needed by the feedbacks");
+
+/**
+ * @brief Buffers written by the DMA
+ *
+ * @details Each conversion sequence is started by the ADC timer and the DMA runs
+ * in circular mode over two buffers, so one buffer can be read while the other
+ * one is being written
+ */
+_STATIC _VOLATILE raw_volt_t dma_data_1[ADC_BUFFER_COUNT][ADC_OVERSAMPLING_COUNT][ADC_1_CHANNEL_COUNT];
+_STATIC _VOLATILE raw_volt_t dma_data_2[ADC_BUFFER_COUNT][ADC_OVERSAMPLING_COUNT][ADC_2_CHANNEL_COUNT];
+
+/** @brief Flags of the ADCs that completed the current conversion sequence */
+_STATIC _VOLATILE bit_flag8_t converted;
 
 /**
  * @brief Get the feedback analog index from the first ADC channel index
@@ -582,13 +621,31 @@ CoolingTempIndex _adc_get_cooling_temp_index_from_adc_1_channel(Adc1ChannelIndex
     }
 }
 
-void adc_start_feedback_conversion(void) {
-    HAL_ADC_Start_DMA(&HADC_1, (uint32_t *)dma_data_1, ADC_1_CHANNEL_COUNT);
-    HAL_ADC_Start_DMA(&HADC_2, (uint32_t *)dma_data_2, ADC_2_CHANNEL_COUNT);
+/**
+ * @brief Get the average of all the samples of a channel inside a buffer
+ *
+ * @param samples A pointer to the first sample of the channel
+ * @param stride The distance between two consecutive samples of the channel
+ *
+ * @return float The average raw value
+ */
+float _adc_average(const raw_volt_t * const samples, const size_t stride) {
+    uint32_t sum = 0U;
+    for (size_t i = 0U; i < ADC_OVERSAMPLING_COUNT; ++i)
+        sum += samples[i * stride];
+    return (float)sum / ADC_OVERSAMPLING_COUNT;
 }
 
-// TODO: Handle return codes
-void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef * hadc) {
+/**
+ * @brief Copy the converted values of a buffer to the modules
+ *
+ * @details The feedbacks are notified only when both ADCs have completed
+ * the same conversion sequence
+ *
+ * @param hadc A pointer to the ADC handler
+ * @param buffer The index of the buffer that has been filled by the DMA
+ */
+void _adc_conversion_complete(ADC_HandleTypeDef * hadc, const size_t buffer) {
     if (hadc->Instance == HADC_1.Instance) {
         const size_t fb_size = 4U;
         const Adc1ChannelIndex fb_channels[] = {
@@ -602,8 +659,11 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef * hadc) {
         for (size_t i = 0U; i < fb_size; ++i) {
             const FeedbackAnalogIndex index = _adc_get_feedback_index_from_adc_1_channel(fb_channels[i]);
             // if (index < 0) { // TODO: Handle error }
-            const volt_t volt = MAINBOARD_ADC_RAW_VALUE_TO_VOLT(dma_data_1[fb_channels[i]], ADC_VREF, ADC_RESOLUTION);
-            (void)feedback_update_analog_feedback(index, volt);
+            (void)feedback_update_analog_feedback(
+                index,
+                (const raw_volt_t *)&dma_data_1[buffer][0U][fb_channels[i]],
+                ADC_1_CHANNEL_COUNT
+            );
         }
 
         const size_t temp_size = 7U;
@@ -620,9 +680,11 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef * hadc) {
         for (size_t i = 0U; i < temp_size; ++i) {
             const CoolingTempIndex index = _adc_get_cooling_temp_index_from_adc_1_channel(temp_channels[i]);
             // if (index < 0) { // Handle error }
-            const volt_t volt = MAINBOARD_ADC_RAW_VALUE_TO_VOLT(dma_data_1[temp_channels[i]], ADC_VREF, ADC_RESOLUTION);
+            const float raw = _adc_average((const raw_volt_t *)&dma_data_1[buffer][0U][temp_channels[i]], ADC_1_CHANNEL_COUNT);
+            const volt_t volt = MAINBOARD_ADC_RAW_VALUE_TO_VOLT(raw, ADC_VREF, ADC_RESOLUTION);
             cooling_temp_notify_conversion_complete(index, volt);
         }
+        converted = MAINBOARD_BIT_SET(converted, 0U);
     }
     else if (hadc->Instance == HADC_2.Instance) {
         const size_t size = 6U;
@@ -639,10 +701,61 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef * hadc) {
         for (size_t i = 0U; i < size; ++i) {
             const FeedbackAnalogIndex index = _adc_get_feedback_index_from_adc_2_channel(channels[i]);
             // if (index < 0) { // TODO: Handle error }
-            const volt_t volt = MAINBOARD_ADC_RAW_VALUE_TO_VOLT(dma_data_2[channels[i]], ADC_VREF, ADC_RESOLUTION);
-            feedback_update_analog_feedback(index, volt);
+            (void)feedback_update_analog_feedback(
+                index,
+                (const raw_volt_t *)&dma_data_2[buffer][0U][channels[i]],
+                ADC_2_CHANNEL_COUNT
+            );
         }
+        converted = MAINBOARD_BIT_SET(converted, 1U);
     }
+
+    if (converted == 0x03U) {
+        converted = 0U;
+        feedback_notify_conversion_complete();
+    }
+}
+
+void adc_start_feedback_conversion(void) {
+    converted = 0U;
+    HAL_ADC_Start_DMA(&HADC_1, (uint32_t *)dma_data_1, ADC_BUFFER_COUNT * ADC_OVERSAMPLING_COUNT * ADC_1_CHANNEL_COUNT);
+    HAL_ADC_Start_DMA(&HADC_2, (uint32_t *)dma_data_2, ADC_BUFFER_COUNT * ADC_OVERSAMPLING_COUNT * ADC_2_CHANNEL_COUNT);
+    HAL_TIM_Base_Start(&HTIM_ADC);
+}
+
+/**
+ * @brief Restart the acquisition of both ADCs
+ *
+ * @details The trigger is stopped before the ADCs so that both start again
+ * from the first buffer and their conversion sequences stay paired
+ */
+void _adc_restart_feedback_conversion(void) {
+    HAL_TIM_Base_Stop(&HTIM_ADC);
+    HAL_ADC_Stop_DMA(&HADC_1);
+    HAL_ADC_Stop_DMA(&HADC_2);
+    adc_start_feedback_conversion();
+}
+
+// TODO: Handle return codes
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef * hadc) {
+    _adc_conversion_complete(hadc, 0U);
+}
+
+// TODO: Handle return codes
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef * hadc) {
+    _adc_conversion_complete(hadc, 1U);
+}
+
+/**
+ * @brief Called on an overrun or a DMA error of any ADC
+ *
+ * @details The ADC stops requesting transfers after an overrun, so the whole
+ * acquisition is restarted, the feedbacks are invalidated by the status update
+ * if the acquisitions do not start again
+ */
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef * hadc) {
+    if (hadc->Instance == HADC_1.Instance || hadc->Instance == HADC_2.Instance)
+        _adc_restart_feedback_conversion();
 }
 
 /* USER CODE END 1 */
@@ -12,6 +12,8 @@
 
 #include "timebase.h"
 #include "volt.h"
+#include "can-comm.h"
+#include "tdma.h"
 
 #ifdef CONF_BALANCING_MODULE_ENABLE
 
@@ -137,6 +139,8 @@ void bal_set_balancing_state_from_handcart_handle(primary_hv_set_balancing_statu
 void bal_cellboard_balancing_status_handle(bms_cellboard_balancing_status_converted_t * const payload) {
     if (payload == NULL)
         return;
+    (void)tdma_notify_reception((CellboardId)payload->cellboard_id, can_comm_get_rx_timestamp());
+
     // Forward balancing status info to the primary network
     hbal.status_can_payload.status = (primary_hv_balancing_status_status)payload->status;
     hbal.status_can_payload.cellboard_id = (primary_hv_balancing_status_cellboard_id)payload->cellboard_id;
@@ -0,0 +1,362 @@
+/**
+ * @file black-box.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Capture of the pack state before a fatal error
+ */
+
+#include "black-box.h"
+
+#include <string.h>
+
+#include "timebase.h"
+#include "tasks.h"
+#include "volt.h"
+#include "temp.h"
+#include "current.h"
+#include "internal-voltage.h"
+#include "feedback.h"
+#include "fsm.h"
+#include "error.h"
+
+#ifdef CONF_BLACK_BOX_MODULE_ENABLE
+
+_STATIC _BlackBoxHandler hblack_box;
+
+/**
+ * @brief Convert a value to an integer with the given resolution
+ *
+ * @param value The value to convert
+ * @param scale The number of integer steps for each unit of the value
+ * @param min The minimum integer value
+ * @param max The maximum integer value
+ *
+ * @return int32_t The converted value clamped between min and max
+ */
+_STATIC_INLINE int32_t _black_box_quantize(const float value, const float scale, const int32_t min, const int32_t max) {
+    const float scaled = value * scale;
+    if (!(scaled > (float)min))
+        return min;
+    if (scaled >= (float)max)
+        return max;
+    return (int32_t)(scaled + (scaled >= 0.f ? 0.5f : -0.5f));
+}
+
+/**
+ * @brief Map a signed value to an unsigned one so that small absolute values stay small
+ *
+ * @param value The signed value
+ *
+ * @return uint32_t The zigzag encoded value
+ */
+_STATIC_INLINE uint32_t _black_box_zigzag(const int32_t value) {
+    return ((uint32_t)value << 1U) ^ (uint32_t)(value >> 31U);
+}
+
+/**
+ * @brief Encode a value as a variable length integer
+ *
+ * @details Each byte contains 7 bits of the value and the most significant
+ * bit is set if another byte follows
+ *
+ * @param out[out] A pointer where the encoded bytes are written
+ * @param value The value to encode
+ *
+ * @return size_t The number of written bytes
+ */
+_STATIC_INLINE size_t _black_box_put_varint(uint8_t * const out, uint32_t value) {
+    size_t size = 0U;
+    while (value >= 0x80U) {
+        out[size++] = (uint8_t)(value | 0x80U);
+        value >>= 7U;
+    }
+    out[size++] = (uint8_t)value;
+    return size;
+}
+
+/**
+ * @brief Encode the header of the capture
+ *
+ * @param out[out] A pointer where the encoded bytes are written
+ *
+ * @return size_t The number of written bytes
+ */
+_STATIC size_t _black_box_encode_header(uint8_t * const out) {
+    const BlackBoxHeader * const header = &hblack_box.header;
+    size_t size = 0U;
+    size += _black_box_put_varint(&out[size], header->sample_count);
+    size += _black_box_put_varint(&out[size], header->interval);
+    size += _black_box_put_varint(&out[size], header->timestamp);
+    size += _black_box_put_varint(&out[size], header->group);
+    size += _black_box_put_varint(&out[size], header->instance);
+    size += _black_box_put_varint(&out[size], header->record_cycles_max);
+    return size;
+}
+
+/**
+ * @brief Encode a sample as the difference from the previous one
+ *
+ * @param sample A pointer to the sample to encode
+ * @param out[out] A pointer where the encoded bytes are written
+ *
+ * @return size_t The number of written bytes
+ */
+_STATIC size_t _black_box_encode_sample(const BlackBoxSample * const sample, uint8_t * const out) {
+    const BlackBoxSample * const prev = &hblack_box.previous;
+    size_t size = 0U;
+    size += _black_box_put_varint(&out[size], sample->feedback_high ^ prev->feedback_high);
+    size += _black_box_put_varint(&out[size], sample->feedback_error ^ prev->feedback_error);
+    size += _black_box_put_varint(&out[size], _black_box_zigzag((int32_t)sample->min_volt - prev->min_volt));
+    size += _black_box_put_varint(&out[size], _black_box_zigzag((int32_t)sample->max_volt - prev->max_volt));
+    size += _black_box_put_varint(&out[size], _black_box_zigzag((int32_t)sample->min_temp - prev->min_temp));
+    size += _black_box_put_varint(&out[size], _black_box_zigzag((int32_t)sample->max_temp - prev->max_temp));
+    size += _black_box_put_varint(&out[size], _black_box_zigzag((int32_t)sample->current - prev->current));
+    size += _black_box_put_varint(&out[size], _black_box_zigzag((int32_t)sample->ts_voltage - prev->ts_voltage));
+    size += _black_box_put_varint(&out[size], _black_box_zigzag((int32_t)sample->pack_voltage - prev->pack_voltage));
+    size += _black_box_put_varint(&out[size], _black_box_zigzag((int32_t)sample->fsm_state - prev->fsm_state));
+    memcpy(&hblack_box.previous, sample, sizeof(hblack_box.previous));
+    return size;
+}
+
+/**
+ * @brief Encode the next item of the stream
+ *
+ * @return bool True if a new item has been encoded, false if the stream is ended
+ */
+_STATIC bool _black_box_encode_next(void) {
+    if (hblack_box.encoded == 0U)
+        hblack_box.pending_size = _black_box_encode_header(hblack_box.pending);
+    else if (hblack_box.encoded <= hblack_box.count) {
+        const size_t index = (hblack_box.head + BLACK_BOX_SAMPLE_COUNT - hblack_box.count + hblack_box.encoded - 1U) % BLACK_BOX_SAMPLE_COUNT;
+        hblack_box.pending_size = _black_box_encode_sample(&hblack_box.samples[index], hblack_box.pending);
+    }
+    else
+        return false;
+    ++hblack_box.encoded;
+    hblack_box.pending_offset = 0U;
+    return true;
+}
+
+/** @brief Fill the next chunk with the bytes of the stream */
+_STATIC void _black_box_fill_chunk(void) {
+    BlackBoxChunk * const chunk = &hblack_box.chunk;
+    memset(chunk->data, 0U, sizeof(chunk->data));
+    size_t size = 0U;
+    bool ended = false;
+    while (!ended && size < BLACK_BOX_CHUNK_DATA_SIZE) {
+        if (hblack_box.pending_offset >= hblack_box.pending_size && !_black_box_encode_next()) {
+            ended = true;
+            continue;
+        }
+        const size_t count = MAINBOARD_MIN(
+            hblack_box.pending_size - hblack_box.pending_offset,
+            BLACK_BOX_CHUNK_DATA_SIZE - size
+        );
+        memcpy(&chunk->data[size], &hblack_box.pending[hblack_box.pending_offset], count);
+        hblack_box.pending_offset += count;
+        size += count;
+    }
+    // Check if the stream ends exactly with the chunk
+    if (!ended && hblack_box.pending_offset >= hblack_box.pending_size && !_black_box_encode_next())
+        ended = true;
+    chunk->size = (uint8_t)size;
+    chunk->last = ended;
+    hblack_box.chunk_ready = true;
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/** @brief Stop the dump of the capture */
+_STATIC_INLINE void _black_box_dump_stop(void) {
+    hblack_box.dumping = false;
+    (void)tasks_set_enable(TASKS_ID_SEND_BLACK_BOX, false);
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+BlackBoxReturnCode black_box_init(const black_box_get_cycles_callback_t get_cycles) {
+    if (get_cycles == NULL)
+        return BLACK_BOX_NULL_POINTER;
+    memset(&hblack_box, 0U, sizeof(hblack_box));
+    hblack_box.get_cycles = get_cycles;
+    return BLACK_BOX_OK;
+}
+
+BlackBoxReturnCode black_box_record(void) {
+    if (hblack_box.frozen)
+        return BLACK_BOX_FROZEN;
+    const uint32_t start = hblack_box.get_cycles();
+
+    BlackBoxSample * const sample = &hblack_box.samples[hblack_box.head];
+    sample->feedback_high = feedback_get_status_mask(FEEDBACK_STATUS_HIGH);
+    sample->feedback_error = feedback_get_status_mask(FEEDBACK_STATUS_ERROR);
+    sample->min_volt = (uint16_t)_black_box_quantize(volt_get_min(), BLACK_BOX_CELL_VOLTAGE_SCALE, 0, UINT16_MAX);
+    sample->max_volt = (uint16_t)_black_box_quantize(volt_get_max(), BLACK_BOX_CELL_VOLTAGE_SCALE, 0, UINT16_MAX);
+    sample->min_temp = (int16_t)_black_box_quantize(temp_get_min(), BLACK_BOX_TEMPERATURE_SCALE, INT16_MIN, INT16_MAX);
+    sample->max_temp = (int16_t)_black_box_quantize(temp_get_max(), BLACK_BOX_TEMPERATURE_SCALE, INT16_MIN, INT16_MAX);
+    sample->current = (int16_t)_black_box_quantize(current_get_current(), BLACK_BOX_CURRENT_SCALE, INT16_MIN, INT16_MAX);
+    sample->ts_voltage = (uint16_t)_black_box_quantize(internal_voltage_get_ts(), BLACK_BOX_VOLTAGE_SCALE, 0, UINT16_MAX);
+    sample->pack_voltage = (uint16_t)_black_box_quantize(internal_voltage_get_pack(), BLACK_BOX_VOLTAGE_SCALE, 0, UINT16_MAX);
+    sample->fsm_state = (uint8_t)fsm_get_status();
+
+    if (++hblack_box.head >= BLACK_BOX_SAMPLE_COUNT)
+        hblack_box.head = 0U;
+    if (hblack_box.count < BLACK_BOX_SAMPLE_COUNT)
+        ++hblack_box.count;
+
+    // Measure the recording cost
+    hblack_box.record_cycles = hblack_box.get_cycles() - start;
+    hblack_box.record_cycles_max = MAINBOARD_MAX(hblack_box.record_cycles_max, hblack_box.record_cycles);
+    return BLACK_BOX_OK;
+}
+
+void black_box_trigger(void) {
+    if (hblack_box.get_cycles == NULL || hblack_box.frozen)
+        return;
+    (void)black_box_record();
+    hblack_box.frozen = true;
+
+    const ErrorInfo info = error_get_expired_info();
+    hblack_box.header.sample_count = hblack_box.count;
+    hblack_box.header.interval = BLACK_BOX_SAMPLE_INTERVAL_MS;
+    hblack_box.header.timestamp = timebase_get_time();
+    hblack_box.header.group = info.group;
+    hblack_box.header.instance = info.instance;
+    hblack_box.header.record_cycles_max = hblack_box.record_cycles_max;
+
+    // The capture is identified by the sequence number of its first chunk
+    memset(&hblack_box.previous, 0U, sizeof(hblack_box.previous));
+    hblack_box.encoded = 0U;
+    hblack_box.pending_size = 0U;
+    hblack_box.pending_offset = 0U;
+    hblack_box.chunk.capture = (uint16_t)(storage_get_sequence(STORAGE_REGION_BLACK_BOX) + 1U);
+    hblack_box.chunk.index = 0U;
+    hblack_box.chunk_ready = false;
+    hblack_box.flushing = true;
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    // The region is going to be overwritten
+    if (hblack_box.dumping)
+        _black_box_dump_stop();
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+}
+
+void black_box_routine(void) {
+    if (!hblack_box.flushing || storage_is_busy())
+        return;
+    if (!hblack_box.chunk_ready)
+        _black_box_fill_chunk();
+    if (storage_save(STORAGE_REGION_BLACK_BOX, &hblack_box.chunk, sizeof(hblack_box.chunk)) != STORAGE_OK)
+        return;
+
+    hblack_box.chunk_ready = false;
+    if (hblack_box.chunk.last) {
+        // The capture is stored so the recording can start again for the next error
+        hblack_box.flushing = false;
+        hblack_box.frozen = false;
+    }
+    else
+        ++hblack_box.chunk.index;
+}
+
+uint32_t black_box_get_record_cycles_max(void) {
+    return hblack_box.record_cycles_max;
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+void black_box_dump_request_handle(primary_hv_black_box_dump_request_converted_t * const payload) {
+    if (payload == NULL || hblack_box.flushing)
+        return;
+    const uint32_t sequence = storage_get_sequence(STORAGE_REGION_BLACK_BOX);
+    if (sequence == 0U)
+        return;
+
+    // Start from the newest chunk to find the first one of its capture
+    hblack_box.dumping = true;
+    hblack_box.locating = true;
+    hblack_box.dump_loaded = false;
+    hblack_box.dump_sequence = sequence;
+    hblack_box.dump_stream_offset = 0U;
+    (void)tasks_set_enable(TASKS_ID_SEND_BLACK_BOX, true);
+}
+
+primary_hv_black_box_converted_t * black_box_get_black_box_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(hblack_box.black_box_can_payload);
+    if (!hblack_box.dumping)
+        return NULL;
+
+    // Read the next chunk checking that it belongs to the same capture
+    BlackBoxChunk * const chunk = &hblack_box.dump_chunk;
+    if (!hblack_box.dump_loaded) {
+        const StorageReturnCode code = storage_read(
+            STORAGE_REGION_BLACK_BOX,
+            hblack_box.dump_sequence,
+            chunk,
+            sizeof(*chunk)
+        );
+        if (code == STORAGE_BUSY)
+            return NULL;
+        if (code != STORAGE_OK ||
+            chunk->size > BLACK_BOX_CHUNK_DATA_SIZE ||
+            (uint16_t)(hblack_box.dump_sequence - chunk->index) != chunk->capture) {
+            _black_box_dump_stop();
+            return NULL;
+        }
+        if (hblack_box.locating) {
+            hblack_box.locating = false;
+            hblack_box.dump_sequence -= chunk->index;
+            return NULL;
+        }
+        hblack_box.dump_loaded = true;
+        hblack_box.dump_offset = 0U;
+    }
+
+    uint8_t data[BLACK_BOX_DUMP_DATA_SIZE] = { 0U };
+    const size_t size = MAINBOARD_MIN(BLACK_BOX_DUMP_DATA_SIZE, chunk->size - hblack_box.dump_offset);
+    memcpy(data, &chunk->data[hblack_box.dump_offset], size);
+    hblack_box.black_box_can_payload.offset = hblack_box.dump_stream_offset;
+    hblack_box.black_box_can_payload.size = (uint8_t)size;
+    hblack_box.black_box_can_payload.data_0 = data[0U];
+    hblack_box.black_box_can_payload.data_1 = data[1U];
+    hblack_box.black_box_can_payload.data_2 = data[2U];
+    hblack_box.black_box_can_payload.data_3 = data[3U];
+    hblack_box.black_box_can_payload.data_4 = data[4U];
+    hblack_box.dump_offset += size;
+    hblack_box.dump_stream_offset += size;
+
+    // Move to the next chunk or stop after the last one
+    if (hblack_box.dump_offset >= chunk->size) {
+        if (chunk->last)
+            _black_box_dump_stop();
+        else {
+            ++hblack_box.dump_sequence;
+            hblack_box.dump_loaded = false;
+        }
+    }
+    return &hblack_box.black_box_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#ifdef CONF_BLACK_BOX_STRINGS_ENABLE
+
+_STATIC char * black_box_module_name = "black box";
+
+_STATIC char * black_box_return_code_name[] = {
+    [BLACK_BOX_OK] = "ok",
+    [BLACK_BOX_NULL_POINTER] = "null pointer",
+    [BLACK_BOX_FROZEN] = "frozen"
+};
+
+_STATIC char * black_box_return_code_description[] = {
+    [BLACK_BOX_OK] = "executed successfully",
+    [BLACK_BOX_NULL_POINTER] = "attempt to dereference a null pointer",
+    [BLACK_BOX_FROZEN] = "the buffer is frozen and no sample is recorded"
+};
+
+#endif // CONF_BLACK_BOX_STRINGS_ENABLE
+
+#endif // CONF_BLACK_BOX_MODULE_ENABLE
@@ -21,6 +21,8 @@
 #include "temp.h"
 #include "bal.h"
 #include "error.h"
+#include "event-log.h"
+#include "black-box.h"
 
 #include "canlib_device.h"
 
@@ -64,16 +66,12 @@ can_comm_canlib_payload_handle_callback_t _can_comm_bms_payload_handle(const can
             return (can_comm_canlib_payload_handle_callback_t)temp_cells_temperature_handle;
         case BMS_CELLBOARD_FLASH_RESPONSE_INDEX:
             return (can_comm_canlib_payload_handle_callback_t)programmer_cellboard_flash_response_handle;
-        case BMS_CELLBOARD_STATUS_INDEX:
-            return (can_comm_canlib_payload_handle_callback_t)fsm_cellboard_state_handle;
         case BMS_CELLBOARD_VERSION_INDEX:
             return (can_comm_canlib_payload_handle_callback_t)identity_cellboard_version_handle;
         case BMS_CELLBOARD_BALANCING_STATUS_INDEX:
             return (can_comm_canlib_payload_handle_callback_t)bal_cellboard_balancing_status_handle;
         case BMS_IVT_MSG_RESULT_I_INDEX:
-            return (can_comm_canlib_payload_handle_callback_t)current_handle;
-        case BMS_CELLBOARD_ERROR_INDEX:
-            return (can_comm_canlib_payload_handle_callback_t)error_cellboard_handle;
+            return (can_comm_canlib_payload_handle_callback_t)current_sensor_communication_handle;
         default:
             return NULL;
     }
@@ -94,14 +92,18 @@ can_comm_canlib_payload_handle_callback_t _can_comm_primary_payload_handle(const
             return (can_comm_canlib_payload_handle_callback_t)programmer_flash_request_handle;
         case PRIMARY_HV_FLASH_INDEX:
             return (can_comm_canlib_payload_handle_callback_t)programmer_flash_handle;
-        case PRIMARY_HV_SET_STATUS_ECU_INDEX:
-            return (can_comm_canlib_payload_handle_callback_t)pcu_set_state_from_ecu_handle;
         case PRIMARY_HV_SET_STATUS_HANDCART_INDEX:
             return (can_comm_canlib_payload_handle_callback_t)pcu_set_state_from_handcart_handle;
         case PRIMARY_HV_SET_BALANCING_STATUS_STEERING_WHEEL_INDEX:
             return (can_comm_canlib_payload_handle_callback_t)bal_set_balancing_state_from_steering_wheel_handle;
         case PRIMARY_HV_SET_BALANCING_STATUS_HANDCART_INDEX:
             return (can_comm_canlib_payload_handle_callback_t)bal_set_balancing_state_from_handcart_handle;
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+        case PRIMARY_HV_EVENT_LOG_DUMP_REQUEST_INDEX:
+            return (can_comm_canlib_payload_handle_callback_t)event_log_dump_request_handle;
+        case PRIMARY_HV_BLACK_BOX_DUMP_REQUEST_INDEX:
+            return (can_comm_canlib_payload_handle_callback_t)black_box_dump_request_handle;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
         default:
             return NULL;
     }
@@ -126,17 +128,165 @@ can_comm_canlib_payload_handle_callback_t _can_comm_payload_handle(const CanNetw
     }
 }
 
-CanCommReturnCode can_comm_init(const can_comm_transmit_callback_t send) {
-    if (send == NULL)
+/**
+ * @brief Handle the safety-critical message payload received from the BMS internal CAN network
+ *
+ * @details The returned callbacks are executed by the fast routine
+ *
+ * @param index The canlib index of the message
+ * 
+ * @return can_comm_canlib_payload_handle_callback_t A pointer to the function callback used to handle the canlib payload
+ * or NULL if the message is not part of the fast path
+ */
+can_comm_canlib_payload_handle_callback_t _can_comm_bms_fast_payload_handle(const can_index_t index) {
+    switch (index) {
+        case BMS_IVT_MSG_RESULT_I_INDEX:
+            return (can_comm_canlib_payload_handle_callback_t)current_handle;
+        case BMS_CELLBOARD_STATUS_INDEX:
+            return (can_comm_canlib_payload_handle_callback_t)fsm_cellboard_state_handle;
+        case BMS_CELLBOARD_ERROR_INDEX:
+            return (can_comm_canlib_payload_handle_callback_t)error_cellboard_handle;
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Handle the safety-critical message payload received from the primary CAN network of the car
+ *
+ * @details The returned callbacks are executed by the fast routine
+ *
+ * @param index The canlib index of the message
+ * 
+ * @return can_comm_canlib_payload_handle_callback_t A pointer to the function callback used to handle the canlib payload
+ * or NULL if the message is not part of the fast path
+ */
+can_comm_canlib_payload_handle_callback_t _can_comm_primary_fast_payload_handle(const can_index_t index) {
+    switch (index) {
+        case PRIMARY_HV_SET_STATUS_ECU_INDEX:
+            return (can_comm_canlib_payload_handle_callback_t)pcu_set_state_from_ecu_handle;
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Handle the safety-critical message payload received from a CAN network
+ *
+ * @details The fast path is used for messages that can't wait for the routine
+ * to be executed (e.g. TS off requests, over-current and cellboard fatal errors),
+ * the messages are queued by the reception interrupt and handled by the fast routine
+ *
+ * @param index The canlib index of the message
+ * 
+ * @return can_comm_canlib_payload_handle_callback_t A pointer to the function callback used to handle the canlib payload
+ * or NULL if the message is not part of the fast path
+ */
+can_comm_canlib_payload_handle_callback_t _can_comm_fast_payload_handle(const CanNetwork network, const can_index_t index) {
+    switch (network) {
+        case CAN_NETWORK_BMS:
+            return _can_comm_bms_fast_payload_handle(index);
+        case CAN_NETWORK_PRIMARY:
+            return _can_comm_primary_fast_payload_handle(index);
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Get the latency histogram bin of a given time
+ *
+ * @param latency The latency in ticks
+ *
+ * @return size_t The index of the histogram bin
+ */
+_STATIC_INLINE size_t _can_comm_latency_bin(const ticks_t latency) {
+    if (latency == 0U)
+        return 0U;
+    const size_t bin = 32U - __builtin_clz(latency);
+    return MAINBOARD_MIN(bin, CAN_COMM_LATENCY_HISTOGRAM_SIZE - 1U);
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Forward a raw frame received from the BMS network to the primary network
+ *
+ * @details The frame is added to the gateway buffer and sent afterwards inside the routine
+ * without any conversion, frames that exceed the route rate are discarded
+ *
+ * @param index The canlib index of the BMS message
+ * @param data The raw payload of the message
+ * @param size The payload size in bytes
+ */
+void _can_comm_gateway_forward(const can_index_t index, const uint8_t * const data, const size_t size) {
+    const CanCommGatewayId id = hcan_comm.gateway_route[index];
+    if (id >= CAN_COMM_GATEWAY_ID_COUNT || !hcan_comm.gateway[id].enabled)
+        return;
+
+    // Limit the rate of the forwarded frames
+    CanCommGatewayRoute * const route = &hcan_comm.gateway[id];
+    const ticks_t t = timebase_get_tick();
+    if (route->interval > 0U && t - route->last < route->interval)
+        return;
+    route->last = t;
+
+    CanCommRawFrame frame = {
+        .route = id,
+        .id = route->id,
+        .size = size
+    };
+    memcpy(frame.data, data, size);
+    (void)ring_buffer_push_back(&hcan_comm.gateway_buf, &frame);
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+CanCommReturnCode can_comm_init(
+    const can_comm_transmit_callback_t send,
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit)
+{
+    if (send == NULL || cs_enter == NULL || cs_exit == NULL)
         return CAN_COMM_NULL_POINTER;
 
     CAN_COMM_DISABLE_ALL(hcan_comm.enabled);
     hcan_comm.send = send;
+    hcan_comm.cs_enter = cs_enter;
+    hcan_comm.cs_exit = cs_exit;
 
     // Return values are ignored becuase the buffer addresses are always not NULL
     (void)ring_buffer_init(&hcan_comm.tx_buf, CanMessage, CAN_COMM_TX_BUFFER_BYTE_SIZE, NULL, NULL);
-    // TODO: Add callbacks to stop CAN reception interrupt during ring buffer operations?
-    (void)ring_buffer_init(&hcan_comm.rx_buf, CanMessage, CAN_COMM_RX_BUFFER_BYTE_SIZE, NULL, NULL);
+    /*
+     * The reception buffers are filled from the reception interrupt and emptied
+     * by the routines, so the interrupt is stopped during their operations
+     */
+    (void)ring_buffer_init(&hcan_comm.rx_buf, CanMessage, CAN_COMM_RX_BUFFER_BYTE_SIZE, cs_enter, cs_exit);
+    (void)ring_buffer_init(&hcan_comm.rx_fast_buf, CanMessage, CAN_COMM_RX_FAST_BUFFER_SIZE, cs_enter, cs_exit);
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    (void)ring_buffer_init(&hcan_comm.gateway_buf, CanCommRawFrame, CAN_COMM_GATEWAY_BUFFER_SIZE, cs_enter, cs_exit);
+    hcan_comm.gateway_pending = false;
+
+    // Initialize the gateway routes with the X macro
+    for (can_index_t i = 0; i < bms_MESSAGE_COUNT; ++i)
+        hcan_comm.gateway_route[i] = CAN_COMM_GATEWAY_ID_COUNT;
+    const milliseconds_t resolution = timebase_get_resolution();
+#define CAN_COMM_GATEWAY_X(NAME, ENABLED, INDEX, ID, INTERVAL) \
+    do { \
+        hcan_comm.gateway[CAN_COMM_GATEWAY_ID_##NAME].enabled = (ENABLED); \
+        hcan_comm.gateway[CAN_COMM_GATEWAY_ID_##NAME].index = (INDEX); \
+        hcan_comm.gateway[CAN_COMM_GATEWAY_ID_##NAME].id = (ID); \
+        hcan_comm.gateway[CAN_COMM_GATEWAY_ID_##NAME].interval = TIMEBASE_TIME_TO_TICKS(INTERVAL, resolution); \
+        hcan_comm.gateway[CAN_COMM_GATEWAY_ID_##NAME].last = 0U; \
+        hcan_comm.gateway[CAN_COMM_GATEWAY_ID_##NAME].sent = 0U; \
+        hcan_comm.gateway[CAN_COMM_GATEWAY_ID_##NAME].failed = 0U; \
+        hcan_comm.gateway_route[(INDEX)] = CAN_COMM_GATEWAY_ID_##NAME; \
+    } while(0U);
+
+    CAN_COMM_GATEWAY_X_LIST
+#undef CAN_COMM_GATEWAY_X
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
 
     // Initialize the canlib device
     device_init(&hcan_comm.rx_device);
@@ -147,6 +297,14 @@ CanCommReturnCode can_comm_init(const can_comm_transmit_callback_t send) {
         &hcan_comm.rx_conv,
         bms_MAX_STRUCT_SIZE_CONVERSION
     );
+    device_init(&hcan_comm.rx_fast_device);
+    device_set_address(
+        &hcan_comm.rx_fast_device,
+        &hcan_comm.rx_fast_raw,
+        bms_MAX_STRUCT_SIZE_RAW,
+        &hcan_comm.rx_fast_conv,
+        bms_MAX_STRUCT_SIZE_CONVERSION
+    );
     return CAN_COMM_OK;
 }
 
@@ -193,6 +351,8 @@ CanCommReturnCode can_comm_send_immediate(
     // Check parameters validity
     if (network >= CAN_NETWORK_COUNT)
         return CAN_COMM_INVALID_NETWORK;
+    if (index < 0)
+        return CAN_COMM_INVALID_INDEX;
     if (network == CAN_NETWORK_BMS && index >= bms_MESSAGE_COUNT)
         return CAN_COMM_INVALID_INDEX;
     if (network == CAN_NETWORK_PRIMARY && index >= primary_MESSAGE_COUNT)
@@ -210,7 +370,8 @@ CanCommReturnCode can_comm_send_immediate(
     CanMessage msg = {
         .network = network,
         .index = index,
-        .frame_type = frame_type
+        .frame_type = frame_type,
+        .timestamp = timebase_get_tick()
     };
     if (frame_type != CAN_FRAME_TYPE_REMOTE)
         memcpy(msg.payload.tx, data, size);
@@ -220,8 +381,14 @@ CanCommReturnCode can_comm_send_immediate(
         (void)can_comm_routine();
 
     // Add and send the new message
-    if (ring_buffer_push_front(&hcan_comm.tx_buf, &msg) == RING_BUFFER_OK)
+    CanCommMessageStats * const stats = &hcan_comm.stats.messages[network][index];
+    if (ring_buffer_push_front(&hcan_comm.tx_buf, &msg) == RING_BUFFER_OK) {
+        const size_t count = ring_buffer_size(&hcan_comm.tx_buf);
+        hcan_comm.stats.tx_high_water = MAINBOARD_MAX(hcan_comm.stats.tx_high_water, count);
+        ++stats->enqueued;
         return can_comm_routine();
+    }
+    ++stats->dropped_overrun;
     return CAN_COMM_OVERRUN;
 }
 
@@ -253,21 +420,30 @@ CanCommReturnCode can_comm_tx_add(
         return CAN_COMM_NULL_POINTER;
 
     // Return if a message with the same index is still inside the buffer
-    if (hcan_comm.tx_busy[network][index])
+    CanCommMessageStats * const stats = &hcan_comm.stats.messages[network][index];
+    if (hcan_comm.tx_busy[network][index]) {
+        ++stats->dropped_busy;
         return CAN_COMM_OK;
+    }
 
     // Prepare and push message to the buffer
     CanMessage msg = {
         .network = network,
         .index = index,
-        .frame_type = frame_type
+        .frame_type = frame_type,
+        .timestamp = timebase_get_tick()
     };
     if (frame_type != CAN_FRAME_TYPE_REMOTE)
         memcpy(msg.payload.tx, data, size);
 
-    if (ring_buffer_push_back(&hcan_comm.tx_buf, &msg) == RING_BUFFER_FULL)
+    if (ring_buffer_push_back(&hcan_comm.tx_buf, &msg) == RING_BUFFER_FULL) {
+        ++stats->dropped_overrun;
         return CAN_COMM_OVERRUN;
+    }
     hcan_comm.tx_busy[network][index] = true;
+    const size_t count = ring_buffer_size(&hcan_comm.tx_buf);
+    hcan_comm.stats.tx_high_water = MAINBOARD_MAX(hcan_comm.stats.tx_high_water, count);
+    ++stats->enqueued;
     return CAN_COMM_OK;
 }
 
@@ -297,18 +473,77 @@ CanCommReturnCode can_comm_rx_add(
     if (frame_type >= CAN_FRAME_TYPE_COUNT)
         return CAN_COMM_INVALID_FRAME_TYPE;
 
+    CanCommMessageStats * const stats = &hcan_comm.stats.messages[network][index];
+    ++stats->received;
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    // Forward the raw frame to the primary network if needed
+    if (network == CAN_NETWORK_BMS && frame_type != CAN_FRAME_TYPE_REMOTE)
+        _can_comm_gateway_forward(index, data, size);
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
     // Prepare and push message to the buffer
     CanMessage msg = {
         .network = network,
         .index = index,
-        .frame_type = frame_type
+        .frame_type = frame_type,
+        .timestamp = timebase_get_tick()
     };
     if (frame_type != CAN_FRAME_TYPE_REMOTE)
         memcpy(msg.payload.rx, data, size);
 
-    if (ring_buffer_push_back(&hcan_comm.rx_buf, &msg) == RING_BUFFER_FULL)
+    /*
+     * Safety-critical messages are only queued here, the fast routine handles
+     * them outside of the interrupt before any other work of the main loop
+     */
+    if (frame_type != CAN_FRAME_TYPE_REMOTE && _can_comm_fast_payload_handle(network, index) != NULL) {
+        if (ring_buffer_push_back(&hcan_comm.rx_fast_buf, &msg) == RING_BUFFER_FULL) {
+            ++stats->rx_dropped_overrun;
+            return CAN_COMM_OVERRUN;
+        }
+        // Skip the buffer if the message does not need any other handling
+        if (_can_comm_payload_handle(network, index) == NULL)
+            return CAN_COMM_OK;
+    }
+
+    if (ring_buffer_push_back(&hcan_comm.rx_buf, &msg) == RING_BUFFER_FULL) {
+        ++stats->rx_dropped_overrun;
         return CAN_COMM_OVERRUN;
+    }
     hcan_comm.rx_busy[network][index] = true;
+    const size_t count = ring_buffer_size(&hcan_comm.rx_buf);
+    hcan_comm.stats.rx_high_water = MAINBOARD_MAX(hcan_comm.stats.rx_high_water, count);
+    return CAN_COMM_OK;
+}
+
+CanCommReturnCode can_comm_fast_routine(void) {
+    if (!CAN_COMM_IS_ENABLED(hcan_comm.enabled, CAN_COMM_RX_ENABLE_BIT))
+        return CAN_COMM_DISABLED;
+
+    CanMessage msg;
+    while (ring_buffer_pop_front(&hcan_comm.rx_fast_buf, &msg) == RING_BUFFER_OK) {
+        id_from_index_t id_from_index = bms_id_from_index;
+        deserialize_from_id_t deserialize_from_id = bms_devices_deserialize_from_id;
+
+        if (msg.network == CAN_NETWORK_PRIMARY) {
+            id_from_index = primary_id_from_index;
+            deserialize_from_id = primary_devices_deserialize_from_id;
+        }
+        deserialize_from_id(&hcan_comm.rx_fast_device, id_from_index(msg.index), msg.payload.rx);
+
+        can_comm_canlib_payload_handle_callback_t handle_fast_payload = _can_comm_fast_payload_handle(msg.network, msg.index);
+        if (handle_fast_payload != NULL)
+            handle_fast_payload(hcan_comm.rx_fast_device.message);
+
+        // Update the time needed to handle the message after its reception
+        const ticks_t latency = timebase_get_tick() - msg.timestamp;
+        hcan_comm.rx_fast_latency_max = MAINBOARD_MAX(hcan_comm.rx_fast_latency_max, latency);
+        ++hcan_comm.stats.rx_latency[_can_comm_latency_bin(latency)];
+
+        // Messages that are handled by the routine as well are counted only once
+        if (_can_comm_payload_handle(msg.network, msg.index) == NULL)
+            ++hcan_comm.stats.messages[msg.network][msg.index].handled;
+    }
     return CAN_COMM_OK;
 }
 
@@ -316,6 +551,9 @@ CanCommReturnCode can_comm_routine(void) {
     if (!CAN_COMM_IS_ENABLED_ALL(hcan_comm.enabled))
         return CAN_COMM_DISABLED;
 
+    // Safety-critical messages are handled before anything else
+    (void)can_comm_fast_routine();
+
     // Handler transmit and receive data
     CanCommReturnCode ret = CAN_COMM_OK;
     CanMessage tx_msg, rx_msg;
@@ -376,7 +614,55 @@ CanCommReturnCode can_comm_routine(void) {
                 // (void)error_set(ERROR_GROUP_CAN_COMMUNICATION, _can_comm_get_error_instance_from_network(tx_msg.network));
                 break;
         }
+
+        // Update statistics
+        if (ret == CAN_COMM_OK) {
+            ++hcan_comm.stats.messages[tx_msg.network][tx_msg.index].sent;
+            ++hcan_comm.stats.tx_latency[_can_comm_latency_bin(timebase_get_tick() - tx_msg.timestamp)];
+        }
+        else
+            ++hcan_comm.stats.messages[tx_msg.network][tx_msg.index].failed;
+
+        // Do not let the safety-critical messages wait for the whole buffer to be sent
+        (void)can_comm_fast_routine();
     }
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    /*
+     * Send the frames forwarded by the gateway as they are
+     * A frame is kept until it is sent and the forwarding stops at the first failure
+     * to retry it in the next routine without changing the order of the frames
+     */
+    while (CAN_COMM_IS_ENABLED(hcan_comm.enabled, CAN_COMM_TX_ENABLE_BIT)) {
+        if (!hcan_comm.gateway_pending) {
+            if (ring_buffer_pop_front(&hcan_comm.gateway_buf, &hcan_comm.gateway_frame) != RING_BUFFER_OK)
+                break;
+            hcan_comm.gateway_pending = true;
+        }
+
+        const CanCommReturnCode code = hcan_comm.send(
+            CAN_NETWORK_PRIMARY,
+            hcan_comm.gateway_frame.id,
+            CAN_FRAME_TYPE_DATA,
+            hcan_comm.gateway_frame.data,
+            hcan_comm.gateway_frame.size
+        );
+        CanCommGatewayRoute * const route = &hcan_comm.gateway[hcan_comm.gateway_frame.route];
+        if (code == CAN_COMM_OK) {
+            ++route->sent;
+            (void)error_reset(ERROR_GROUP_CAN_COMMUNICATION, _can_comm_get_error_instance_from_network(CAN_NETWORK_PRIMARY));
+        }
+        else {
+            ++route->failed;
+            // Invalid frames are discarded because they can never be sent
+            if (code != CAN_COMM_INVALID_INDEX &&
+                code != CAN_COMM_INVALID_PAYLOAD_SIZE &&
+                code != CAN_COMM_INVALID_FRAME_TYPE)
+                break;
+        }
+        hcan_comm.gateway_pending = false;
+    }
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
     while (CAN_COMM_IS_ENABLED(hcan_comm.enabled, CAN_COMM_RX_ENABLE_BIT) &&
         ring_buffer_pop_front(&hcan_comm.rx_buf, &rx_msg) == RING_BUFFER_OK)
     {
@@ -402,17 +688,120 @@ CanCommReturnCode can_comm_routine(void) {
             deserialize_from_id(&hcan_comm.rx_device, can_id, rx_msg.payload.rx);
 
             can_comm_canlib_payload_handle_callback_t handle_payload = _can_comm_payload_handle(rx_msg.network, rx_msg.index);
+            hcan_comm.rx_timestamp = rx_msg.timestamp;
             if (handle_payload != NULL)
                 handle_payload(hcan_comm.rx_device.message);
+
+            // Update the time needed to handle the message after its reception
+            const ticks_t latency = timebase_get_tick() - rx_msg.timestamp;
+            hcan_comm.rx_latency_max = MAINBOARD_MAX(hcan_comm.rx_latency_max, latency);
+            ++hcan_comm.stats.rx_latency[_can_comm_latency_bin(latency)];
+            ++hcan_comm.stats.messages[rx_msg.network][rx_msg.index].handled;
         }
         else { 
             // TODO: Handler remote requests
         }
+
+        (void)can_comm_fast_routine();
     }
 
     return ret;
 }
 
+const CanCommStats * can_comm_get_stats(void) {
+    return &hcan_comm.stats;
+}
+
+const CanCommMessageStats * can_comm_get_message_stats(const CanNetwork network, const can_index_t index) {
+    if (network >= CAN_NETWORK_COUNT || index < 0 || index >= CAN_COMM_MESSAGE_COUNT)
+        return NULL;
+    return &hcan_comm.stats.messages[network][index];
+}
+
+void can_comm_reset_stats(void) {
+    // The reception counters are written by the interrupt
+    hcan_comm.cs_enter();
+    memset(&hcan_comm.stats, 0U, sizeof(hcan_comm.stats));
+    hcan_comm.cs_exit();
+    hcan_comm.rx_latency_max = 0U;
+    hcan_comm.rx_fast_latency_max = 0U;
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+primary_hv_debug_can_stats_converted_t * can_comm_get_stats_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(hcan_comm.stats_can_payload);
+
+    // Look for the next message that has been used at least once
+    for (size_t i = 0U; i < CAN_NETWORK_COUNT * CAN_COMM_MESSAGE_COUNT; ++i) {
+        if (++hcan_comm.stats_index >= CAN_COMM_MESSAGE_COUNT) {
+            hcan_comm.stats_index = 0;
+            if (++hcan_comm.stats_network >= CAN_NETWORK_COUNT)
+                hcan_comm.stats_network = 0U;
+        }
+        const CanCommMessageStats * const stats = &hcan_comm.stats.messages[hcan_comm.stats_network][hcan_comm.stats_index];
+        if (stats->enqueued > 0U || stats->received > 0U)
+            break;
+    }
+
+    const CanCommMessageStats * const stats = &hcan_comm.stats.messages[hcan_comm.stats_network][hcan_comm.stats_index];
+    hcan_comm.stats_can_payload.network = hcan_comm.stats_network;
+    hcan_comm.stats_can_payload.index = hcan_comm.stats_index;
+    hcan_comm.stats_can_payload.sent = stats->sent;
+    hcan_comm.stats_can_payload.received = stats->received;
+    hcan_comm.stats_can_payload.dropped = stats->failed + stats->dropped_busy + stats->dropped_overrun + stats->rx_dropped_overrun;
+    return &hcan_comm.stats_can_payload;
+}
+
+primary_hv_debug_can_buffers_converted_t * can_comm_get_buffers_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(hcan_comm.buffers_can_payload);
+
+    hcan_comm.buffers_can_payload.tx_high_water = hcan_comm.stats.tx_high_water;
+    hcan_comm.buffers_can_payload.rx_high_water = hcan_comm.stats.rx_high_water;
+    hcan_comm.buffers_can_payload.bin = hcan_comm.stats_bin;
+    hcan_comm.buffers_can_payload.tx_latency = hcan_comm.stats.tx_latency[hcan_comm.stats_bin];
+    hcan_comm.buffers_can_payload.rx_latency = hcan_comm.stats.rx_latency[hcan_comm.stats_bin];
+
+    if (++hcan_comm.stats_bin >= CAN_COMM_LATENCY_HISTOGRAM_SIZE)
+        hcan_comm.stats_bin = 0U;
+    return &hcan_comm.buffers_can_payload;
+}
+
+CanCommReturnCode can_comm_gateway_set_enable(const CanCommGatewayId id, const bool enabled) {
+    if (id >= CAN_COMM_GATEWAY_ID_COUNT)
+        return CAN_COMM_INVALID_INDEX;
+    hcan_comm.gateway[id].enabled = enabled;
+    return CAN_COMM_OK;
+}
+
+bool can_comm_gateway_is_enabled(const CanCommGatewayId id) {
+    if (id >= CAN_COMM_GATEWAY_ID_COUNT)
+        return false;
+    return hcan_comm.gateway[id].enabled;
+}
+
+uint32_t can_comm_gateway_get_failed(const CanCommGatewayId id) {
+    if (id >= CAN_COMM_GATEWAY_ID_COUNT)
+        return 0U;
+    return hcan_comm.gateway[id].failed;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+ticks_t can_comm_get_rx_latency_max(void) {
+    return hcan_comm.rx_latency_max;
+}
+
+ticks_t can_comm_get_rx_fast_latency_max(void) {
+    return hcan_comm.rx_fast_latency_max;
+}
+
+ticks_t can_comm_get_rx_timestamp(void) {
+    return hcan_comm.rx_timestamp;
+}
+
 #ifdef CONF_CAN_COMM_STRINGS_ENABLE
 
 _STATIC char * can_comm_module_name = "can communication";
@@ -11,34 +11,50 @@
 #include <string.h>
 
 #include "error.h"
+#include "stats.h"
 
 #ifdef CONF_COOLING_TEMPERATURE_MODULE_ENABLE
 
+/** @brief Value of the lookup table at the given index in °C */
+#define COOLING_TEMP_LUT_VALUE(INDEX) \
+    ((celsius_t)COOLING_TEMP_POLYNOMIAL((double)COOLING_TEMP_MIN_LIMIT_V + (double)(INDEX) * (double)COOLING_TEMP_LUT_STEP_V))
+
+/** @brief Initializers of consecutive values of the lookup table starting from the given index */
+#define COOLING_TEMP_LUT_VALUES_2(INDEX) COOLING_TEMP_LUT_VALUE(INDEX), COOLING_TEMP_LUT_VALUE((INDEX) + 1U)
+#define COOLING_TEMP_LUT_VALUES_4(INDEX) COOLING_TEMP_LUT_VALUES_2(INDEX), COOLING_TEMP_LUT_VALUES_2((INDEX) + 2U)
+#define COOLING_TEMP_LUT_VALUES_8(INDEX) COOLING_TEMP_LUT_VALUES_4(INDEX), COOLING_TEMP_LUT_VALUES_4((INDEX) + 4U)
+#define COOLING_TEMP_LUT_VALUES_16(INDEX) COOLING_TEMP_LUT_VALUES_8(INDEX), COOLING_TEMP_LUT_VALUES_8((INDEX) + 8U)
+#define COOLING_TEMP_LUT_VALUES_32(INDEX) COOLING_TEMP_LUT_VALUES_16(INDEX), COOLING_TEMP_LUT_VALUES_16((INDEX) + 16U)
+#define COOLING_TEMP_LUT_VALUES_64(INDEX) COOLING_TEMP_LUT_VALUES_32(INDEX), COOLING_TEMP_LUT_VALUES_32((INDEX) + 32U)
+
+_Static_assert(COOLING_TEMP_LUT_SEGMENT_COUNT == 64U, "The lookup table initializer must match the number of segments");
+
+/**
+ * @brief Temperatures in °C at the edges of each segment of the lookup table
+ *
+ * @details The polynomial is evaluated by the compiler so the table can't drift from the coefficients
+ */
+_STATIC const celsius_t cooling_temp_lut[COOLING_TEMP_LUT_SEGMENT_COUNT + 1U] = {
+    COOLING_TEMP_LUT_VALUES_64(0U),
+    COOLING_TEMP_LUT_VALUE(COOLING_TEMP_LUT_SEGMENT_COUNT)
+};
+
 _STATIC _CoolingTempHandler hcoolingtemp;
 
 /**
- * @brief Convert a voltage into a temperature using a polynomial conversion
+ * @brief Convert a voltage into a temperature interpolating the lookup table
  *
  * @param value The voltage value in V
  *
  * @return celsius_t The converted value in °C
  */
 celsius_t _cooling_temp_volt_to_celsius(volt_t value) {
-    // Value is converted in V and limited to fit the polynomial range
+    // Value is limited to fit the polynomial range
     value = MAINBOARD_CLAMP(value, COOLING_TEMP_MIN_LIMIT_V, COOLING_TEMP_MAX_LIMIT_V);
-    const double v = value;
-    const double v2 = v * v;
-    const double v3 = v2 * v;
-    const double v4 = v2 * v2;
-    const double v5 = v4 * v;
-    const double v6 = v3 * v3;
-    return COOLING_TEMP_COEFF_0 + 
-        COOLING_TEMP_COEFF_1 * v + 
-        COOLING_TEMP_COEFF_2 * v2 + 
-        COOLING_TEMP_COEFF_3 * v3 + 
-        COOLING_TEMP_COEFF_4 * v4 + 
-        COOLING_TEMP_COEFF_5 * v5 +
-        COOLING_TEMP_COEFF_6 * v6;
+    const float position = (value - COOLING_TEMP_MIN_LIMIT_V) * (1.f / COOLING_TEMP_LUT_STEP_V);
+    const size_t index = MAINBOARD_MIN((size_t)position, COOLING_TEMP_LUT_SEGMENT_COUNT - 1U);
+    const float fraction = position - (float)index;
+    return cooling_temp_lut[index] + (cooling_temp_lut[index + 1U] - cooling_temp_lut[index]) * fraction;
 }
 
 /**
@@ -83,31 +99,27 @@ const cooling_temp_t * cooling_temp_get_values(void) {
 
 
 celsius_t cooling_temp_get_min(void) {
-    celsius_t min = COOLING_TEMP_MAX_C;
-    for (size_t i = 0U; i < COOLING_TEMP_COUNT; ++i) {
-        min = MAINBOARD_MIN(min, hcoolingtemp.temperatures[i]);
-    }
-    return min;
+    // The minimum is never greater than the maximum allowed temperature
+    const celsius_t min = stats_min_f32(hcoolingtemp.temperatures, COOLING_TEMP_COUNT, NULL);
+    return MAINBOARD_MIN(COOLING_TEMP_MAX_C, min);
 }
 
 celsius_t cooling_temp_get_max(void) {
-    celsius_t max = 0U;
-    for (size_t i = 0U; i < COOLING_TEMP_COUNT; ++i) {
-        max = MAINBOARD_MAX(max, hcoolingtemp.temperatures[i]);
-    }
-    return max;
+    // The maximum is never less than zero
+    const celsius_t max = stats_max_f32(hcoolingtemp.temperatures, COOLING_TEMP_COUNT, NULL);
+    return MAINBOARD_MAX(0.f, max);
 }
 
 celsius_t cooling_temp_get_sum(void) {
-    celsius_t sum = 0U;
-    for (size_t i = 0U; i < COOLING_TEMP_COUNT; ++i) {
-        sum += hcoolingtemp.temperatures[i];
-    }
-    return sum;
+    return stats_sum_f32(hcoolingtemp.temperatures, COOLING_TEMP_COUNT);
 }
 
 celsius_t cooling_temp_get_avg(void) {
-    return cooling_temp_get_sum() / COOLING_TEMP_COUNT;
+    return stats_mean_f32(hcoolingtemp.temperatures, COOLING_TEMP_COUNT);
+}
+
+celsius_t cooling_temp_get_std(void) {
+    return stats_std_f32(hcoolingtemp.temperatures, COOLING_TEMP_COUNT);
 }
 
 primary_hv_cooling_temperature_converted_t * cooling_temp_get_temperatures_canlib_payload(size_t * const byte_size) {
@@ -15,6 +15,7 @@
 #include "error.h"
 #include "internal-voltage.h"
 #include "volt.h"
+#include "soc.h"
 
 #ifdef CONF_CURRENT_MODULE_ENABLE
 
@@ -45,8 +46,15 @@ _STATIC_INLINE void _current_check_value(const ampere_t value) {
         error_reset(ERROR_GROUP_OVER_POWER, 0U);
 }
 
-CurrentReturnCode current_init(void) {
+CurrentReturnCode current_init(
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit)
+{
+    if (cs_enter == NULL || cs_exit == NULL)
+        return CURRENT_NULL_POINTER;
     memset(&hcurrent, 0U, sizeof(hcurrent));
+    hcurrent.cs_enter = cs_enter;
+    hcurrent.cs_exit = cs_exit;
     (void)watchdog_init(
         &hcurrent.sensor_wdg,
         CURRENT_SENSOR_COMMUNICATION_TIMEOUT_MS,
@@ -59,6 +67,41 @@ ampere_t current_get_current(void) {
     return hcurrent.current;
 }
 
+ampere_t current_get_current_at(const ticks_t timestamp) {
+    /*
+     * The history is written by the fast CAN routine which can run in the middle
+     * of any other handler, the values needed for the interpolation are copied
+     * inside a critical section so that they always belong to the same history
+     */
+    hcurrent.cs_enter();
+    const ampere_t current = hcurrent.current;
+    const size_t count = hcurrent.history_count;
+
+    // Search the first value older than the given time starting from the newest
+    size_t newer = (hcurrent.history_head + CURRENT_HISTORY_SIZE - 1U) % CURRENT_HISTORY_SIZE;
+    size_t older = newer;
+    for (size_t i = 1U; i < count && (int32_t)(timestamp - hcurrent.history_time[older]) < 0; ++i) {
+        newer = older;
+        older = (older + CURRENT_HISTORY_SIZE - 1U) % CURRENT_HISTORY_SIZE;
+    }
+    const ampere_t i_newer = hcurrent.history[newer];
+    const ampere_t i_older = hcurrent.history[older];
+    const ticks_t t_newer = hcurrent.history_time[newer];
+    const ticks_t t_older = hcurrent.history_time[older];
+    hcurrent.cs_exit();
+
+    if (count == 0U)
+        return current;
+    // Return the newest value or the oldest if the time is outside of the history
+    if (older == newer || (int32_t)(timestamp - t_older) < 0)
+        return i_older;
+    const ticks_t dt = t_newer - t_older;
+    if (dt == 0U)
+        return i_newer;
+    const float k = (float)(timestamp - t_older) / dt;
+    return i_older + (i_newer - i_older) * k;
+}
+
 kilowatt_t current_get_power(void) {
     return hcurrent.current * internal_voltage_get_ts() * 0.001;
 }
@@ -68,14 +111,29 @@ WatchdogReturnCode current_start_sensor_communication_watchdog(void) {
 }
 
 void current_handle(bms_ivt_msg_result_i_t * const payload) {
-    watchdog_reset(&hcurrent.sensor_wdg);
     if (payload == NULL)
         return;
     hcurrent.current = payload->ivt_result_i * 0.001f;
-    hcurrent.current = hcurrent.current;
+
+    // Add the value to the history
+    const size_t head = hcurrent.history_head;
+    const ticks_t timestamp = timebase_get_tick();
+    hcurrent.history[head] = hcurrent.current;
+    hcurrent.history_time[head] = timestamp;
+    hcurrent.history_head = (head + 1U) % CURRENT_HISTORY_SIZE;
+    if (hcurrent.history_count < CURRENT_HISTORY_SIZE)
+        ++hcurrent.history_count;
+
+    soc_integrate_current(hcurrent.current, timestamp);
+
     _current_check_value(hcurrent.current);
 }
 
+void current_sensor_communication_handle(bms_ivt_msg_result_i_t * const payload) {
+    MAINBOARD_UNUSED(payload);
+    watchdog_reset(&hcurrent.sensor_wdg);
+}
+
 primary_hv_current_converted_t * current_get_current_canlib_payload(size_t * const byte_size) {
     if (byte_size != NULL)
         *byte_size = sizeof(hcurrent.current_can_payload);
@@ -95,11 +153,13 @@ primary_hv_power_converted_t * current_get_power_canlib_payload(size_t * const b
 _STATIC char * current_module_name = "current";
 
 _STATIC char * current_return_code_name[] = {
-    [CURRENT_OK] = "ok"
+    [CURRENT_OK] = "ok",
+    [CURRENT_NULL_POINTER] = "null pointer"
 };
 
 _STATIC char * current_return_code_description[] = {
-    [CURRENT_OK] = "executed succesfully"
+    [CURRENT_OK] = "executed succesfully",
+    [CURRENT_NULL_POINTER] = "attempt to dereference a null pointer"
 };
 
 #endif // CONF_CURRENT_STRINGS_ENABLE
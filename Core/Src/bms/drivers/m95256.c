@@ -0,0 +1,96 @@
+/**
+ * @file m95256.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief M95256 256-Kbit SPI EEPROM driver
+ */
+
+#include "m95256.h"
+
+#include <string.h>
+
+/**
+ * @brief Send a single byte instruction
+ *
+ * @param handler A pointer to the handler structure
+ * @param instruction The instruction to send
+ */
+void _m95256_send_instruction(M95256Handler * const handler, const M95256Instruction instruction) {
+    uint8_t cmd = instruction;
+    handler->send(SPI_NETWORK_EEPROM, &cmd, 1U);
+}
+
+M95256ReturnCode m95256_init(
+    M95256Handler * const handler,
+    const spi_send_callback_t send,
+    const spi_send_receive_callback_t send_receive)
+{
+    if (handler == NULL ||
+        send == NULL ||
+        send_receive == NULL)
+        return M95256_NULL_POINTER;
+    memset(handler, 0U, sizeof(*handler));
+    handler->send = send;
+    handler->send_receive = send_receive;
+
+    // Make sure that a write can not be started by an incomplete instruction
+    _m95256_send_instruction(handler, M95256_INSTRUCTION_WRDI);
+    return M95256_OK;
+}
+
+bool m95256_is_busy(M95256Handler * const handler) {
+    if (handler == NULL)
+        return true;
+    uint8_t cmd[2U] = { M95256_INSTRUCTION_RDSR, 0U };
+    handler->send_receive(SPI_NETWORK_EEPROM, cmd, &cmd[1U], 1U, 1U);
+    return MAINBOARD_BIT_GET(cmd[1U], M95256_STATUS_WIP);
+}
+
+M95256ReturnCode m95256_read(
+    M95256Handler * const handler,
+    const m95256_address_t address,
+    uint8_t * const out,
+    const size_t size)
+{
+    if (handler == NULL || out == NULL)
+        return M95256_NULL_POINTER;
+    if ((size_t)address + size > M95256_SIZE)
+        return M95256_OUT_OF_BOUNDS;
+    if (m95256_is_busy(handler))
+        return M95256_BUSY;
+
+    uint8_t cmd[M95256_COMMAND_BYTE_SIZE] = {
+        M95256_INSTRUCTION_READ,
+        (address & 0xff00U) >> 8U,
+        address & 0x00ffU
+    };
+    handler->send_receive(SPI_NETWORK_EEPROM, cmd, out, M95256_COMMAND_BYTE_SIZE, size);
+    return M95256_OK;
+}
+
+M95256ReturnCode m95256_write_page(
+    M95256Handler * const handler,
+    const m95256_address_t address,
+    const uint8_t * const data,
+    const size_t size)
+{
+    if (handler == NULL || data == NULL)
+        return M95256_NULL_POINTER;
+    if (size == 0U ||
+        (size_t)address + size > M95256_SIZE ||
+        (address % M95256_PAGE_SIZE) + size > M95256_PAGE_SIZE)
+        return M95256_OUT_OF_BOUNDS;
+    if (m95256_is_busy(handler))
+        return M95256_BUSY;
+
+    // The write enable latch is reset at the end of every write cycle
+    _m95256_send_instruction(handler, M95256_INSTRUCTION_WREN);
+
+    handler->buffer[0U] = M95256_INSTRUCTION_WRITE;
+    handler->buffer[1U] = (address & 0xff00U) >> 8U;
+    handler->buffer[2U] = address & 0x00ffU;
+    memcpy(&handler->buffer[M95256_COMMAND_BYTE_SIZE], data, size);
+    handler->send(SPI_NETWORK_EEPROM, handler->buffer, M95256_COMMAND_BYTE_SIZE + size);
+    return M95256_OK;
+}
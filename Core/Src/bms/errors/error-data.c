@@ -0,0 +1,124 @@
+/**
+ * @file error-data.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Error groups and their constant properties
+ *
+ * @attention This file is generated from errors.json by the
+ * generate-error-handler.py script, do not modify it manually
+ */
+
+#include "error-data.h"
+
+#include "mainboard-conf.h"
+
+#ifdef CONF_ERROR_MODULE_ENABLE
+
+_Static_assert(ERROR_GROUP_COUNT <= 32U, "The running groups must fit a 32-bit flag");
+_Static_assert(ERROR_BITSET_TOTAL_SIZE <= UINT16_MAX, "The instances flags must be indexed by a 16-bit offset");
+_Static_assert(ERROR_COUNTER_TOTAL_COUNT <= UINT16_MAX, "The set counters must be indexed by a 16-bit offset");
+_Static_assert(ERROR_POST_INSTANCE_COUNT > 0U && ERROR_POST_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the POST group");
+_Static_assert(ERROR_OVER_CURRENT_INSTANCE_COUNT > 0U && ERROR_OVER_CURRENT_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the OVER_CURRENT group");
+_Static_assert(ERROR_OVER_POWER_INSTANCE_COUNT > 0U && ERROR_OVER_POWER_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the OVER_POWER group");
+_Static_assert(ERROR_UNDER_VOLTAGE_INSTANCE_COUNT > 0U && ERROR_UNDER_VOLTAGE_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the UNDER_VOLTAGE group");
+_Static_assert(ERROR_OVER_VOLTAGE_INSTANCE_COUNT > 0U && ERROR_OVER_VOLTAGE_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the OVER_VOLTAGE group");
+_Static_assert(ERROR_UNDER_TEMPERATURE_INSTANCE_COUNT > 0U && ERROR_UNDER_TEMPERATURE_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the UNDER_TEMPERATURE group");
+_Static_assert(ERROR_OVER_TEMPERATURE_INSTANCE_COUNT > 0U && ERROR_OVER_TEMPERATURE_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the OVER_TEMPERATURE group");
+_Static_assert(ERROR_CAN_COMMUNICATION_INSTANCE_COUNT > 0U && ERROR_CAN_COMMUNICATION_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the CAN_COMMUNICATION group");
+_Static_assert(ERROR_CURRENT_SENSOR_COMMUNICATION_INSTANCE_COUNT > 0U && ERROR_CURRENT_SENSOR_COMMUNICATION_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the CURRENT_SENSOR_COMMUNICATION group");
+_Static_assert(ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT > 0U && ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the COOLING_UNDER_TEMPERATURE group");
+_Static_assert(ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT > 0U && ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the COOLING_OVER_TEMPERATURE group");
+_Static_assert(ERROR_CELLBOARD_ERROR_INSTANCE_COUNT > 0U && ERROR_CELLBOARD_ERROR_INSTANCE_COUNT <= UINT16_MAX, "Invalid number of instances of the CELLBOARD_ERROR group");
+
+const uint16_t error_instances[ERROR_GROUP_COUNT] = {
+    [ERROR_GROUP_POST] = ERROR_POST_INSTANCE_COUNT,
+    [ERROR_GROUP_OVER_CURRENT] = ERROR_OVER_CURRENT_INSTANCE_COUNT,
+    [ERROR_GROUP_OVER_POWER] = ERROR_OVER_POWER_INSTANCE_COUNT,
+    [ERROR_GROUP_UNDER_VOLTAGE] = ERROR_UNDER_VOLTAGE_INSTANCE_COUNT,
+    [ERROR_GROUP_OVER_VOLTAGE] = ERROR_OVER_VOLTAGE_INSTANCE_COUNT,
+    [ERROR_GROUP_UNDER_TEMPERATURE] = ERROR_UNDER_TEMPERATURE_INSTANCE_COUNT,
+    [ERROR_GROUP_OVER_TEMPERATURE] = ERROR_OVER_TEMPERATURE_INSTANCE_COUNT,
+    [ERROR_GROUP_CAN_COMMUNICATION] = ERROR_CAN_COMMUNICATION_INSTANCE_COUNT,
+    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = ERROR_CURRENT_SENSOR_COMMUNICATION_INSTANCE_COUNT,
+    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT,
+    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT,
+    [ERROR_GROUP_CELLBOARD_ERROR] = ERROR_CELLBOARD_ERROR_INSTANCE_COUNT
+};
+
+const uint16_t error_timeouts[ERROR_GROUP_COUNT] = {
+    [ERROR_GROUP_POST] = 0U,
+    [ERROR_GROUP_OVER_CURRENT] = 20U,
+    [ERROR_GROUP_OVER_POWER] = 100U,
+    [ERROR_GROUP_UNDER_VOLTAGE] = 400U,
+    [ERROR_GROUP_OVER_VOLTAGE] = 400U,
+    [ERROR_GROUP_UNDER_TEMPERATURE] = 800U,
+    [ERROR_GROUP_OVER_TEMPERATURE] = 800U,
+    [ERROR_GROUP_CAN_COMMUNICATION] = 1000U,
+    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = 0U,
+    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = 1000U,
+    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = 1000U,
+    [ERROR_GROUP_CELLBOARD_ERROR] = 0U
+};
+
+const uint8_t error_thresholds[ERROR_GROUP_COUNT] = {
+    [ERROR_GROUP_POST] = 1U,
+    [ERROR_GROUP_OVER_CURRENT] = 2U,
+    [ERROR_GROUP_OVER_POWER] = 2U,
+    [ERROR_GROUP_UNDER_VOLTAGE] = 1U,
+    [ERROR_GROUP_OVER_VOLTAGE] = 1U,
+    [ERROR_GROUP_UNDER_TEMPERATURE] = 1U,
+    [ERROR_GROUP_OVER_TEMPERATURE] = 1U,
+    [ERROR_GROUP_CAN_COMMUNICATION] = 50U,
+    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = 1U,
+    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = 5U,
+    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = 5U,
+    [ERROR_GROUP_CELLBOARD_ERROR] = 2U
+};
+
+const uint16_t error_bitset_offsets[ERROR_GROUP_COUNT] = {
+    [ERROR_GROUP_POST] = ERROR_POST_BITSET_OFFSET,
+    [ERROR_GROUP_OVER_CURRENT] = ERROR_OVER_CURRENT_BITSET_OFFSET,
+    [ERROR_GROUP_OVER_POWER] = ERROR_OVER_POWER_BITSET_OFFSET,
+    [ERROR_GROUP_UNDER_VOLTAGE] = ERROR_UNDER_VOLTAGE_BITSET_OFFSET,
+    [ERROR_GROUP_OVER_VOLTAGE] = ERROR_OVER_VOLTAGE_BITSET_OFFSET,
+    [ERROR_GROUP_UNDER_TEMPERATURE] = ERROR_UNDER_TEMPERATURE_BITSET_OFFSET,
+    [ERROR_GROUP_OVER_TEMPERATURE] = ERROR_OVER_TEMPERATURE_BITSET_OFFSET,
+    [ERROR_GROUP_CAN_COMMUNICATION] = ERROR_CAN_COMMUNICATION_BITSET_OFFSET,
+    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = ERROR_CURRENT_SENSOR_COMMUNICATION_BITSET_OFFSET,
+    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = ERROR_COOLING_UNDER_TEMPERATURE_BITSET_OFFSET,
+    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = ERROR_COOLING_OVER_TEMPERATURE_BITSET_OFFSET,
+    [ERROR_GROUP_CELLBOARD_ERROR] = ERROR_CELLBOARD_ERROR_BITSET_OFFSET
+};
+
+const uint16_t error_counter_offsets[ERROR_GROUP_COUNT] = {
+    [ERROR_GROUP_POST] = ERROR_POST_COUNTER_OFFSET,
+    [ERROR_GROUP_OVER_CURRENT] = ERROR_OVER_CURRENT_COUNTER_OFFSET,
+    [ERROR_GROUP_OVER_POWER] = ERROR_OVER_POWER_COUNTER_OFFSET,
+    [ERROR_GROUP_UNDER_VOLTAGE] = ERROR_UNDER_VOLTAGE_COUNTER_OFFSET,
+    [ERROR_GROUP_OVER_VOLTAGE] = ERROR_OVER_VOLTAGE_COUNTER_OFFSET,
+    [ERROR_GROUP_UNDER_TEMPERATURE] = ERROR_UNDER_TEMPERATURE_COUNTER_OFFSET,
+    [ERROR_GROUP_OVER_TEMPERATURE] = ERROR_OVER_TEMPERATURE_COUNTER_OFFSET,
+    [ERROR_GROUP_CAN_COMMUNICATION] = ERROR_CAN_COMMUNICATION_COUNTER_OFFSET,
+    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = ERROR_CURRENT_SENSOR_COMMUNICATION_COUNTER_OFFSET,
+    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = ERROR_COOLING_UNDER_TEMPERATURE_COUNTER_OFFSET,
+    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = ERROR_COOLING_OVER_TEMPERATURE_COUNTER_OFFSET,
+    [ERROR_GROUP_CELLBOARD_ERROR] = ERROR_CELLBOARD_ERROR_COUNTER_OFFSET
+};
+
+const char * const error_group_names[ERROR_GROUP_COUNT] = {
+    [ERROR_GROUP_POST] = "post",
+    [ERROR_GROUP_OVER_CURRENT] = "over current",
+    [ERROR_GROUP_OVER_POWER] = "over power",
+    [ERROR_GROUP_UNDER_VOLTAGE] = "under voltage",
+    [ERROR_GROUP_OVER_VOLTAGE] = "over voltage",
+    [ERROR_GROUP_UNDER_TEMPERATURE] = "under temperature",
+    [ERROR_GROUP_OVER_TEMPERATURE] = "over temperature",
+    [ERROR_GROUP_CAN_COMMUNICATION] = "can communication",
+    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = "current sensor communication",
+    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = "cooling under temperature",
+    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = "cooling over temperature",
+    [ERROR_GROUP_CELLBOARD_ERROR] = "cellboard error"
+};
+
+#endif  // CONF_ERROR_MODULE_ENABLE
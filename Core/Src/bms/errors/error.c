@@ -3,169 +3,417 @@
  * @date 2024-07-12
  * @author Antonio Gelain [antonio.gelain2@gmail.com]
  *
- * @brief Simple wrapper for the error handler generated code
+ * @brief Error handling with timeouts based on a hardware timer
  */
 
 #include "error.h"
 
+#include <string.h>
+
 #include "tasks.h"
+#include "timebase.h"
+#include "event-log.h"
 #include "primary_network.h"
 
-#include <string.h>
-
 #ifdef CONF_ERROR_MODULE_ENABLE
 
-_STATIC ErrorLibHandler herror;
-_STATIC primary_hv_error_converted_t error_can_payload;
-
-/** @brief Total number of instances for each group */
-const size_t instances[] = {
-    [ERROR_GROUP_POST] = ERROR_POST_INSTANCE_COUNT,
-    [ERROR_GROUP_OVER_CURRENT] = ERROR_OVER_CURRENT_INSTANCE_COUNT,
-    [ERROR_GROUP_OVER_POWER] = ERROR_OVER_POWER_INSTANCE_COUNT,
-    [ERROR_GROUP_UNDER_VOLTAGE] = ERROR_UNDER_VOLTAGE_INSTANCE_COUNT,
-    [ERROR_GROUP_OVER_VOLTAGE] = ERROR_OVER_VOLTAGE_INSTANCE_COUNT,
-    [ERROR_GROUP_UNDER_TEMPERATURE] = ERROR_UNDER_TEMPERATURE_INSTANCE_COUNT,
-    [ERROR_GROUP_OVER_TEMPERATURE] = ERROR_OVER_TEMPERATURE_INSTANCE_COUNT,
-    [ERROR_GROUP_CAN_COMMUNICATION] = ERROR_CAN_COMMUNICATION_INSTANCE_COUNT,
-    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = ERROR_CURRENT_SENSOR_COMMUNICATION_INSTANCE_COUNT,
-    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT,
-    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT,
-    [ERROR_GROUP_CELLBOARD_ERROR] = ERROR_CELLBOARD_ERROR_INSTANCE_COUNT
-};
+_STATIC _ErrorHandler herror;
 
 /**
- * @brief Error thresholds for each group
- * 
- * @details The values are arbitrary and shuold not be too much high 
+ * @brief Get the first active instance of a group
+ *
+ * @param group The error group
+ *
+ * @return error_instance_t The first active instance or 0 if none is active
  */
-const size_t thresholds[] = {
-    [ERROR_GROUP_POST] = 1U,
-    [ERROR_GROUP_OVER_CURRENT] = 2U,
-    [ERROR_GROUP_OVER_POWER] = 2U,
-    [ERROR_GROUP_UNDER_VOLTAGE] = 3U,
-    [ERROR_GROUP_OVER_VOLTAGE] = 3U,
-    [ERROR_GROUP_UNDER_TEMPERATURE] = 5U,
-    [ERROR_GROUP_OVER_TEMPERATURE] = 5U,
-    [ERROR_GROUP_CAN_COMMUNICATION] = 50U,
-    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = 1U,
-    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = 5U,
-    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = 5U,
-    [ERROR_GROUP_CELLBOARD_ERROR] = 2U,
-};
+_STATIC_INLINE error_instance_t _error_get_first_instance(const ErrorGroup group) {
+    const bit_flag32_t * const flags = &herror.instances[error_bitset_offsets[group]];
+    for (size_t i = 0U; i < ERROR_BITSET_SIZE(error_instances[group]); ++i) {
+        if (flags[i] != 0U)
+            return i * 32U + __builtin_ctz(flags[i]);
+    }
+    return 0U;
+}
 
-int32_t error_post_instances[ERROR_POST_INSTANCE_COUNT];
-int32_t error_over_current_instances[ERROR_OVER_CURRENT_INSTANCE_COUNT];
-int32_t error_over_power_instances[ERROR_OVER_POWER_INSTANCE_COUNT];
-int32_t error_under_voltage_instances[ERROR_UNDER_VOLTAGE_INSTANCE_COUNT];
-int32_t error_over_voltage_instances[ERROR_OVER_VOLTAGE_INSTANCE_COUNT];
-int32_t error_under_temperature_instances[ERROR_UNDER_TEMPERATURE_INSTANCE_COUNT];
-int32_t error_over_temperature_instances[ERROR_OVER_TEMPERATURE_INSTANCE_COUNT];
-int32_t error_can_communication_instances[ERROR_CAN_COMMUNICATION_INSTANCE_COUNT];
-int32_t error_current_sensor_communication_instances[ERROR_CURRENT_SENSOR_COMMUNICATION_INSTANCE_COUNT];
-int32_t error_cooling_under_temperature_instances[ERROR_COOLING_UNDER_TEMPERATURE_INSTANCE_COUNT];
-int32_t error_cooling_over_temperature_instances[ERROR_COOLING_OVER_TEMPERATURE_INSTANCE_COUNT];
-int32_t error_cellboard_error_instances[ERROR_CELLBOARD_ERROR_INSTANCE_COUNT];
-int32_t * error[] = {
-    [ERROR_GROUP_POST] = error_post_instances,
-    [ERROR_GROUP_OVER_CURRENT] = error_over_current_instances,
-    [ERROR_GROUP_OVER_POWER] = error_over_power_instances,
-    [ERROR_GROUP_UNDER_VOLTAGE] = error_under_voltage_instances,
-    [ERROR_GROUP_OVER_VOLTAGE] = error_over_voltage_instances,
-    [ERROR_GROUP_UNDER_TEMPERATURE] = error_under_temperature_instances,
-    [ERROR_GROUP_OVER_TEMPERATURE] = error_over_temperature_instances,
-    [ERROR_GROUP_CAN_COMMUNICATION] = error_can_communication_instances,
-    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = error_current_sensor_communication_instances,
-    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = error_cooling_under_temperature_instances,
-    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = error_cooling_over_temperature_instances,
-    [ERROR_GROUP_CELLBOARD_ERROR] = error_cellboard_error_instances,
-};
+/**
+ * @brief Count a set of an inactive instance and check if it reached the group threshold
+ *
+ * @param group The error group
+ * @param instance The error instance
+ *
+ * @return bool True if the instance has to become active, false otherwise
+ */
+_STATIC_INLINE bool _error_is_confirmed(const ErrorGroup group, const error_instance_t instance) {
+    if (error_thresholds[group] <= 1U)
+        return true;
+    uint8_t * const counter = &herror.counters[error_counter_offsets[group] + instance];
+    return ++(*counter) >= error_thresholds[group];
+}
+
+/**
+ * @brief Restart the timeout of a group from the current time
+ *
+ * @details The first active instance is reported if the group expires
+ *
+ * @attention The group must have at least one active instance
+ *
+ * @param group The error group
+ */
+_STATIC_INLINE void _error_rearm(const ErrorGroup group) {
+    herror.oldest[group] = _error_get_first_instance(group);
+    herror.timestamp[group] = timebase_get_time();
+}
+
+/**
+ * @brief Check if the timeout of a group is elapsed
+ *
+ * @param group The error group
+ * @param now The current time in ms
+ *
+ * @return bool True if the timeout is elapsed, false otherwise
+ */
+_STATIC_INLINE bool _error_is_elapsed(const ErrorGroup group, const milliseconds_t now) {
+    return (int32_t)(now - herror.timestamp[group]) >= (int32_t)error_timeouts[group];
+}
+
+/**
+ * @brief Set the timer to the nearest timeout of the active groups
+ */
+_STATIC void _error_schedule(void) {
+    const milliseconds_t now = timebase_get_time();
+    ErrorGroup next = ERROR_GROUP_COUNT;
+    int32_t next_left = INT32_MAX;
+
+    bit_flag32_t running = herror.running;
+    while (running != 0U) {
+        const ErrorGroup group = (ErrorGroup)__builtin_ctz(running);
+        const int32_t left = (int32_t)(herror.timestamp[group] + error_timeouts[group] - now);
+        if (left < next_left) {
+            next = group;
+            next_left = left;
+        }
+        running &= running - 1U;
+    }
+
+    if (next == herror.scheduled)
+        return;
+    herror.scheduled = next;
+    if (next == ERROR_GROUP_COUNT)
+        herror.stop_timer();
+    else
+        herror.update_timer(herror.timestamp[next], error_timeouts[next]);
+}
+
+/**
+ * @brief Mark a group as expired
+ *
+ * @details Only the first expired group is stored and no other timeout is scheduled
+ *
+ * @param group The error group
+ */
+_STATIC void _error_expire_group(const ErrorGroup group) {
+    if (herror.expired)
+        return;
+    herror.expired_info.group = group;
+    herror.expired_info.instance = herror.oldest[group];
+    herror.expired_info.timestamp = herror.timestamp[group];
+    herror.can_payload.group = group;
+    herror.can_payload.instance = herror.expired_info.instance;
+    herror.expired = true;
+    ++herror.version;
+
+    herror.running = 0U;
+    herror.scheduled = ERROR_GROUP_COUNT;
+    herror.stop_timer();
+    tasks_set_enable(TASKS_ID_SEND_ERRORS, true);
+}
+
+/**
+ * @brief Log the expiration of a group
+ *
+ * @attention The event log uses its own critical sections, so this function
+ * must be called outside of the error critical section
+ *
+ * @param was_expired True if an error was already expired before the last update
+ */
+_STATIC_INLINE void _error_log_expired(const bool was_expired) {
+    if (!was_expired && herror.expired)
+        (void)event_log_push(EVENT_LOG_TYPE_ERROR_EXPIRED, herror.expired_info.group, herror.expired_info.instance);
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Find the next run of consecutive active instances of the report
+ *
+ * @param group[in,out] The group from which the run is searched, updated with the group of the run
+ * @param start[in,out] The instance from which the run is searched, updated with the first instance of the run
+ * @param length[out] The number of instances of the run
+ *
+ * @return bool True if a run is found, false otherwise
+ */
+_STATIC bool _error_report_find_run(ErrorGroup * const group, error_instance_t * const start, error_instance_t * const length) {
+    for (; *group < ERROR_GROUP_COUNT; ++(*group), *start = 0U) {
+        const bit_flag32_t * const flags = &herror.report_flags[error_bitset_offsets[*group]];
+        const error_instance_t count = error_instances[*group];
+
+        // Jump to the next active instance skipping the empty words
+        error_instance_t first = *start;
+        while (first < count && !MAINBOARD_BIT_GET(flags[first / 32U], first % 32U)) {
+            const bit_flag32_t left = flags[first / 32U] >> (first % 32U);
+            if (left == 0U)
+                first = (first / 32U + 1U) * 32U;
+            else
+                first += __builtin_ctz(left);
+        }
+        if (first >= count)
+            continue;
 
-ErrorReturnCode error_init(void) {
-    if (errorlib_init(&herror,
-        error,
-        instances,
-        thresholds,
-        ERROR_GROUP_COUNT
-    ) != ERRORLIB_OK)
-        return ERROR_UNKNOWN;
+        error_instance_t last = first;
+        while (last < count && MAINBOARD_BIT_GET(flags[last / 32U], last % 32U))
+            ++last;
+        *start = first;
+        *length = last - first;
+        return true;
+    }
+    return false;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+ErrorReturnCode error_init(
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit,
+    const error_update_timer_callback_t update_timer,
+    const error_stop_timer_callback_t stop_timer)
+{
+    if (cs_enter == NULL || cs_exit == NULL || update_timer == NULL || stop_timer == NULL)
+        return ERROR_NULL_POINTER;
+    memset(&herror, 0U, sizeof(herror));
+
+    herror.cs_enter = cs_enter;
+    herror.cs_exit = cs_exit;
+    herror.update_timer = update_timer;
+    herror.stop_timer = stop_timer;
+    herror.scheduled = ERROR_GROUP_COUNT;
     return ERROR_OK;
 }
 
 ErrorReturnCode error_set(const ErrorGroup group, const error_instance_t instance) {
-    ErrorLibReturnCode rt = errorlib_error_set(&herror, (errorlib_error_group_t)group, instance);
+    if (group >= ERROR_GROUP_COUNT || instance >= error_instances[group])
+        return ERROR_OUT_OF_BOUNDS;
+    bit_flag32_t * const word = &herror.instances[error_bitset_offsets[group] + instance / 32U];
+    const bit_pos_t bit = instance % 32U;
+    bool activated = false;
 
-    if (errorlib_get_expired(&herror) > 0U) {
-        ErrorInfo error = errorlib_get_expired_info(&herror);
-        error_can_payload.group = error.group;
-        error_can_payload.instance = error.instance;
+    herror.cs_enter();
+    const bool was_expired = herror.expired;
+    if (!MAINBOARD_BIT_GET(*word, bit) && _error_is_confirmed(group, instance)) {
+        const milliseconds_t now = timebase_get_time();
+        *word = MAINBOARD_BIT_SET(*word, bit);
+        ++herror.version;
 
-        tasks_set_enable(TASKS_ID_SEND_ERRORS, true);
+        // Start the timeout when the group becomes active
+        if (herror.count[group]++ == 0U) {
+            activated = true;
+            herror.oldest[group] = instance;
+            herror.timestamp[group] = now;
+            if (error_timeouts[group] == 0U)
+                _error_expire_group(group);
+            else if (!herror.expired) {
+                herror.running = MAINBOARD_BIT_SET(herror.running, group);
+                _error_schedule();
+            }
+        }
     }
+    herror.cs_exit();
 
-    return rt != ERRORLIB_OK ? ERROR_UNKNOWN : ERROR_OK;
+    if (activated)
+        (void)event_log_push(EVENT_LOG_TYPE_ERROR_SET, group, instance);
+    _error_log_expired(was_expired);
+    return ERROR_OK;
 }
 
 ErrorReturnCode error_reset(const ErrorGroup group, const error_instance_t instance) {
-    if (errorlib_error_reset(&herror, (errorlib_error_group_t)group, instance) != ERRORLIB_OK)
-        return ERROR_UNKNOWN;
+    if (group >= ERROR_GROUP_COUNT || instance >= error_instances[group])
+        return ERROR_OUT_OF_BOUNDS;
+    bit_flag32_t * const word = &herror.instances[error_bitset_offsets[group] + instance / 32U];
+    const bit_pos_t bit = instance % 32U;
+
+    herror.cs_enter();
+    if (error_thresholds[group] > 1U)
+        herror.counters[error_counter_offsets[group] + instance] = 0U;
+    if (MAINBOARD_BIT_GET(*word, bit)) {
+        *word = MAINBOARD_BIT_RESET(*word, bit);
+        ++herror.version;
+
+        // Stop the timeout when the group becomes inactive
+        if (--herror.count[group] == 0U) {
+            if (MAINBOARD_BIT_GET(herror.running, group)) {
+                herror.running = MAINBOARD_BIT_RESET(herror.running, group);
+                _error_schedule();
+            }
+        }
+        // Restart the timeout for the instances that are still active
+        else if (instance == herror.oldest[group]) {
+            _error_rearm(group);
+            if (MAINBOARD_BIT_GET(herror.running, group)) {
+                if (herror.scheduled == group)
+                    herror.scheduled = ERROR_GROUP_COUNT;
+                _error_schedule();
+            }
+        }
+    }
+    herror.cs_exit();
     return ERROR_OK;
 }
 
-size_t error_get_expired(void) {
-    return errorlib_get_expired(&herror);
+bool error_is_active(const ErrorGroup group, const error_instance_t instance) {
+    if (group >= ERROR_GROUP_COUNT || instance >= error_instances[group])
+        return false;
+    return MAINBOARD_BIT_GET(herror.instances[error_bitset_offsets[group] + instance / 32U], instance % 32U);
+}
+
+size_t error_get_active_count(const ErrorGroup group) {
+    if (group >= ERROR_GROUP_COUNT)
+        return 0U;
+    return herror.count[group];
+}
+
+bool error_is_expired(void) {
+    return herror.expired;
 }
 
 ErrorInfo error_get_expired_info(void) {
-    return errorlib_get_expired_info(&herror);
+    herror.cs_enter();
+    ErrorInfo info = herror.expired_info;
+    herror.cs_exit();
+    return info;
+}
+
+void error_expire(void) {
+    herror.cs_enter();
+    const bool was_expired = herror.expired;
+    const milliseconds_t now = timebase_get_time();
+    bit_flag32_t running = herror.running;
+    while (running != 0U) {
+        const ErrorGroup group = (ErrorGroup)__builtin_ctz(running);
+        if (_error_is_elapsed(group, now))
+            _error_expire_group(group);
+        running &= running - 1U;
+    }
+
+    // The timer can elapse slightly before the timebase, in that case it is set again
+    if (!herror.expired) {
+        herror.scheduled = ERROR_GROUP_COUNT;
+        _error_schedule();
+    }
+    herror.cs_exit();
+
+    _error_log_expired(was_expired);
 }
 
 void error_cellboard_handle(bms_cellboard_error_t * const payload) {
     // BUG: Open wire during charge
     if (payload->group == bms_cellboard_error_group_open_wire)
         return;
-    error_can_payload.cellboard_group = payload->group;
-    error_can_payload.cellboard_id = payload->cellboard_id;
+    herror.can_payload.cellboard_group = payload->group;
+    herror.can_payload.cellboard_id = payload->cellboard_id;
     error_set(ERROR_GROUP_CELLBOARD_ERROR, payload->cellboard_id);
 }
 
 primary_hv_error_converted_t * error_get_error_canlib_payload(size_t * const byte_size) {
-    *byte_size = sizeof(error_can_payload);
-    return &error_can_payload;
+    *byte_size = sizeof(herror.can_payload);
+    return &herror.can_payload;
 }
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+primary_hv_error_report_converted_t * error_get_error_report_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(herror.report_can_payload);
+
+    // Start a new report only if something changed since the last one and enough time passed, or if it is too old
+    if (!herror.reporting) {
+        const milliseconds_t now = timebase_get_time();
+        const milliseconds_t elapsed = now - herror.report_timestamp;
+        if (elapsed < ERROR_REPORT_MIN_INTERVAL_MS ||
+            (herror.version == herror.report_version && elapsed < ERROR_REPORT_KEEP_ALIVE_MS))
+            return NULL;
+
+        herror.cs_enter();
+        memcpy(herror.report_flags, herror.instances, sizeof(herror.report_flags));
+        herror.report_version = herror.version;
+        herror.report_expired_group = herror.expired ? herror.expired_info.group : ERROR_GROUP_COUNT;
+        herror.cs_exit();
+
+        herror.reporting = true;
+        herror.report_timestamp = now;
+        herror.report_group = ERROR_GROUP_POST;
+        herror.report_instance = 0U;
+        herror.report_can_payload.version = herror.report_version;
+        herror.report_can_payload.page = 0U;
+        herror.report_can_payload.expired_group = herror.report_expired_group;
+    }
+    else
+        ++herror.report_can_payload.page;
+
+    // Fill the message with up to two runs of the same group
+    error_instance_t start = herror.report_instance;
+    error_instance_t length = 0U;
+    ErrorGroup group = herror.report_group;
+    herror.report_can_payload.group = ERROR_GROUP_COUNT;
+    herror.report_can_payload.start_0 = 0U;
+    herror.report_can_payload.length_0 = 0U;
+    herror.report_can_payload.start_1 = 0U;
+    herror.report_can_payload.length_1 = 0U;
+    if (_error_report_find_run(&group, &start, &length)) {
+        herror.report_can_payload.group = group;
+        herror.report_can_payload.start_0 = start;
+        herror.report_can_payload.length_0 = length;
+        herror.report_group = group;
+        herror.report_instance = start + length;
+
+        start = herror.report_instance;
+        if (_error_report_find_run(&group, &start, &length) && group == herror.report_group) {
+            herror.report_can_payload.start_1 = start;
+            herror.report_can_payload.length_1 = length;
+            herror.report_instance = start + length;
+        }
+    }
+
+    // Check if any other run is left to send
+    group = herror.report_group;
+    start = herror.report_instance;
+    herror.reporting = herror.report_can_payload.length_0 != 0U && _error_report_find_run(&group, &start, &length);
+    herror.report_can_payload.last = !herror.reporting;
+    return &herror.report_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 #ifdef CONF_ERROR_STRINGS_ENABLE
 
 _STATIC char * error_module_name = "error";
 
 _STATIC char * error_return_code_name[] = {
     [ERROR_OK] = "ok",
-    [ERROR_NULL_POINTER] = "null pointer"
+    [ERROR_NULL_POINTER] = "null pointer",
+    [ERROR_OUT_OF_BOUNDS] = "out of bounds",
+    [ERROR_UNKNOWN] = "unknown"
 };
 
 _STATIC char * error_return_code_description[] = {
     [ERROR_OK] = "executed succesfully",
-    [ERROR_NULL_POINTER] = "attempt to dereference a null pointer"
-};
-
-_STATIC char * error_group_name[] = {
-    [ERROR_GROUP_POST] = "post",
-    [ERROR_GROUP_OVER_CURRENT] = "over current",
-    [ERROR_GROUP_OVER_POWER] = "over power",
-    [ERROR_GROUP_UNDER_VOLTAGE] = "under voltage",
-    [ERROR_GROUP_OVER_VOLTAGE] = "over voltage",
-    [ERROR_GROUP_UNDER_TEMPERATURE] = "under temperature",
-    [ERROR_GROUP_OVER_TEMPERATURE] = "over temperature",
-    [ERROR_GROUP_CAN_COMMUNICATION] = "can communication",
-    [ERROR_GROUP_CURRENT_SENSOR_COMMUNICATION] = "current sensor communication",
-    [ERROR_GROUP_COOLING_UNDER_TEMPERATURE] = "cooling under temperature",
-    [ERROR_GROUP_COOLING_OVER_TEMPERATURE] = "cooling over temperature"
+    [ERROR_NULL_POINTER] = "attempt to dereference a null pointer",
+    [ERROR_OUT_OF_BOUNDS] = "attempt to access an invalid error group or instance",
+    [ERROR_UNKNOWN] = "unknown error"
 };
 
-char * error_get_group_name_string(const ErrorGroup group) {
+const char * error_get_group_name_string(const ErrorGroup group) {
     if (group >= ERROR_GROUP_COUNT)
         return "";
-    return error_group_name[group];
+    return error_group_names[group];
 }
 
 #endif // CONF_ERROR_STRINGS_ENABLE
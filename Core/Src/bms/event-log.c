@@ -0,0 +1,140 @@
+/**
+ * @file event-log.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Persistent log of the system events
+ */
+
+#include "event-log.h"
+
+#include <string.h>
+
+#include "timebase.h"
+#include "storage.h"
+#include "tasks.h"
+
+#ifdef CONF_EVENT_LOG_MODULE_ENABLE
+
+_STATIC _EventLogHandler hevent_log;
+
+EventLogReturnCode event_log_init(
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit)
+{
+    if (cs_enter == NULL || cs_exit == NULL)
+        return EVENT_LOG_NULL_POINTER;
+    memset(&hevent_log, 0U, sizeof(hevent_log));
+    hevent_log.cs_enter = cs_enter;
+    hevent_log.cs_exit = cs_exit;
+    (void)ring_buffer_init(&hevent_log.queue, EventLogRecord, EVENT_LOG_QUEUE_SIZE, cs_enter, cs_exit);
+    return EVENT_LOG_OK;
+}
+
+EventLogReturnCode event_log_push(const EventLogType type, const uint8_t data_0, const uint16_t data_1) {
+    // Events raised before the initialization are ignored
+    if (hevent_log.cs_enter == NULL)
+        return EVENT_LOG_NULL_POINTER;
+    const EventLogRecord record = {
+        .timestamp = timebase_get_time(),
+        .type = (uint8_t)type,
+        .data_0 = data_0,
+        .data_1 = data_1
+    };
+    if (ring_buffer_push_back(&hevent_log.queue, &record) == RING_BUFFER_FULL) {
+        hevent_log.cs_enter();
+        if (hevent_log.dropped < UINT16_MAX)
+            ++hevent_log.dropped;
+        hevent_log.cs_exit();
+        return EVENT_LOG_FULL;
+    }
+    return EVENT_LOG_OK;
+}
+
+void event_log_routine(void) {
+    if (storage_is_busy())
+        return;
+
+    // Log the discarded events first so that the space freed in the queue is not lost again
+    hevent_log.cs_enter();
+    const uint16_t dropped = hevent_log.dropped;
+    hevent_log.dropped = 0U;
+    hevent_log.cs_exit();
+
+    EventLogRecord record = {
+        .timestamp = timebase_get_time(),
+        .type = EVENT_LOG_TYPE_DROPPED,
+        .data_1 = dropped
+    };
+    if (dropped == 0U && ring_buffer_pop_front(&hevent_log.queue, &record) != RING_BUFFER_OK)
+        return;
+    (void)storage_save(STORAGE_REGION_EVENT_LOG, &record, sizeof(record));
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+void event_log_dump_request_handle(primary_hv_event_log_dump_request_converted_t * const payload) {
+    if (payload == NULL)
+        return;
+    const uint32_t count = storage_get_count(STORAGE_REGION_EVENT_LOG);
+    const uint32_t requested = (payload->count == 0U) ? count : MAINBOARD_MIN((uint32_t)payload->count, count);
+    if (requested == 0U)
+        return;
+    hevent_log.dump_end = storage_get_sequence(STORAGE_REGION_EVENT_LOG);
+    hevent_log.dump_sequence = hevent_log.dump_end - requested + 1U;
+    (void)tasks_set_enable(TASKS_ID_SEND_EVENT_LOG, true);
+}
+
+primary_hv_event_log_converted_t * event_log_get_event_log_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(hevent_log.event_log_can_payload);
+
+    // Skip the events that are overwritten or corrupted
+    EventLogRecord record;
+    StorageReturnCode code = STORAGE_EMPTY;
+    while (hevent_log.dump_sequence <= hevent_log.dump_end) {
+        code = storage_read(STORAGE_REGION_EVENT_LOG, hevent_log.dump_sequence, &record, sizeof(record));
+        if (code == STORAGE_BUSY)
+            return NULL;
+        if (code == STORAGE_OK)
+            break;
+        ++hevent_log.dump_sequence;
+    }
+    if (code != STORAGE_OK) {
+        (void)tasks_set_enable(TASKS_ID_SEND_EVENT_LOG, false);
+        return NULL;
+    }
+
+    hevent_log.event_log_can_payload.sequence = hevent_log.dump_sequence;
+    hevent_log.event_log_can_payload.timestamp = record.timestamp;
+    hevent_log.event_log_can_payload.type = record.type;
+    hevent_log.event_log_can_payload.data_0 = record.data_0;
+    hevent_log.event_log_can_payload.data_1 = record.data_1;
+
+    // Stop the dump after the last event
+    if (hevent_log.dump_sequence++ >= hevent_log.dump_end)
+        (void)tasks_set_enable(TASKS_ID_SEND_EVENT_LOG, false);
+    return &hevent_log.event_log_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#ifdef CONF_EVENT_LOG_STRINGS_ENABLE
+
+_STATIC char * event_log_module_name = "event log";
+
+_STATIC char * event_log_return_code_name[] = {
+    [EVENT_LOG_OK] = "ok",
+    [EVENT_LOG_NULL_POINTER] = "null pointer",
+    [EVENT_LOG_FULL] = "full"
+};
+
+_STATIC char * event_log_return_code_description[] = {
+    [EVENT_LOG_OK] = "executed successfully",
+    [EVENT_LOG_NULL_POINTER] = "attempt to dereference a null pointer",
+    [EVENT_LOG_FULL] = "the queue is full and the event has been discarded"
+};
+
+#endif // CONF_EVENT_LOG_STRINGS_ENABLE
+
+#endif // CONF_EVENT_LOG_MODULE_ENABLE
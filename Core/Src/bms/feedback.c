@@ -12,6 +12,75 @@
 
 #ifdef CONF_FEEDBACK_MODULE_ENABLE
 
+#define FEEDBACK_ANALOG_CONFIG_X(INDEX, OVERSAMPLING, SHIFT, LOW, HIGH, HYSTERESIS, WINDOW) \
+    _Static_assert( \
+        (OVERSAMPLING) > 0U && (OVERSAMPLING) <= FEEDBACK_OVERSAMPLING_MAX && ((OVERSAMPLING) & ((OVERSAMPLING) - 1U)) == 0U, \
+        "The oversampling of the " #INDEX " feedback must be a power of two up to FEEDBACK_OVERSAMPLING_MAX" \
+    );
+    FEEDBACK_ANALOG_CONFIG_X_LIST
+#undef FEEDBACK_ANALOG_CONFIG_X
+
+_STATIC const FeedbackAnalogConfig feedback_analog_config[FEEDBACK_ANALOG_INDEX_COUNT] = {
+#define FEEDBACK_ANALOG_CONFIG_X(INDEX, OVERSAMPLING, SHIFT, LOW, HIGH, HYSTERESIS, WINDOW) \
+    [FEEDBACK_ANALOG_INDEX_##INDEX] = { \
+        .oversampling = (OVERSAMPLING), \
+        .shift = (SHIFT), \
+        .low = FEEDBACK_VOLT_TO_RAW_VALUE(LOW), \
+        .high = FEEDBACK_VOLT_TO_RAW_VALUE(HIGH), \
+        .hysteresis = FEEDBACK_VOLT_TO_RAW_VALUE(HYSTERESIS), \
+        .window = (WINDOW) \
+    },
+    FEEDBACK_ANALOG_CONFIG_X_LIST
+#undef FEEDBACK_ANALOG_CONFIG_X
+};
+
+_Static_assert(FEEDBACK_COUNT <= 32U, "The status of every feedback must fit a 32-bit flag");
+
+/** @brief Mask of all the valid bits of the feedbacks status flags */
+#define FEEDBACK_STATUS_MASK ((bit_flag32_t)((1ULL << FEEDBACK_COUNT) - 1U))
+
+/**
+ * @brief List of the fields of the feedbacks status payload
+ *
+ * @param FIELD The name of the field of the payload
+ * @param ID The name of the corresponding feedback identifier
+ */
+#define FEEDBACK_STATUS_PAYLOAD_X_LIST \
+    FEEDBACK_STATUS_PAYLOAD_X(airn_open_com, AIRN_OPEN_COM) \
+    FEEDBACK_STATUS_PAYLOAD_X(precharge_open_com, PRECHARGE_OPEN_COM) \
+    FEEDBACK_STATUS_PAYLOAD_X(airp_open_com, AIRP_OPEN_COM) \
+    FEEDBACK_STATUS_PAYLOAD_X(airn_open_mec, AIRN_OPEN_MEC) \
+    FEEDBACK_STATUS_PAYLOAD_X(precharge_open_mec, PRECHARGE_OPEN_MEC) \
+    FEEDBACK_STATUS_PAYLOAD_X(airp_open_mec, AIRP_OPEN_MEC) \
+    FEEDBACK_STATUS_PAYLOAD_X(sd_imd_fb, SD_IMD_FB) \
+    FEEDBACK_STATUS_PAYLOAD_X(sd_bms_fb, SD_BMS_FB) \
+    FEEDBACK_STATUS_PAYLOAD_X(ts_less_than_60v, TS_LESS_THAN_60V) \
+    FEEDBACK_STATUS_PAYLOAD_X(plausible_state_persisted, PLAUSIBLE_STATE_PERSISTED) \
+    FEEDBACK_STATUS_PAYLOAD_X(plausible_state, PLAUSIBLE_STATE) \
+    FEEDBACK_STATUS_PAYLOAD_X(not_bms_fault_cockpit_led, BMS_FAULT_COCKPIT_LED) \
+    FEEDBACK_STATUS_PAYLOAD_X(not_imd_fault_cockpit_led, IMD_FAULT_COCKPIT_LED) \
+    FEEDBACK_STATUS_PAYLOAD_X(indicator_connected, INDICATOR_CONNECTED) \
+    FEEDBACK_STATUS_PAYLOAD_X(not_latch_reset, LATCH_RESET) \
+    FEEDBACK_STATUS_PAYLOAD_X(plausible_state_latched, PLAUSIBLE_STATE_LATCHED) \
+    FEEDBACK_STATUS_PAYLOAD_X(not_bms_fault_latched, BMS_FAULT_LATCHED) \
+    FEEDBACK_STATUS_PAYLOAD_X(not_imd_fault_latched, IMD_FAULT_LATCHED) \
+    FEEDBACK_STATUS_PAYLOAD_X(not_ext_fault_latched, EXT_FAULT_LATCHED) \
+    FEEDBACK_STATUS_PAYLOAD_X(imd_ok, IMD_OK) \
+    FEEDBACK_STATUS_PAYLOAD_X(plausible_state_rc, PLAUSIBLE_STATE_RC) \
+    FEEDBACK_STATUS_PAYLOAD_X(tsal_green, TSAL_GREEN) \
+    FEEDBACK_STATUS_PAYLOAD_X(probing_3v3, PROBING_3V3) \
+    FEEDBACK_STATUS_PAYLOAD_X(sd_out, SD_OUT) \
+    FEEDBACK_STATUS_PAYLOAD_X(sd_in, SD_IN) \
+    FEEDBACK_STATUS_PAYLOAD_X(sd_end, SD_END) \
+    FEEDBACK_STATUS_PAYLOAD_X(v5_mcu, V5_MCU)
+
+/** @brief Identifier of the mechanical feedback of each contactor */
+_STATIC const FeedbackId feedback_contactor_id[FEEDBACK_CONTACTOR_COUNT] = {
+    [FEEDBACK_CONTACTOR_AIRN] = FEEDBACK_ID_AIRN_OPEN_MEC,
+    [FEEDBACK_CONTACTOR_PRECHARGE] = FEEDBACK_ID_PRECHARGE_OPEN_MEC,
+    [FEEDBACK_CONTACTOR_AIRP] = FEEDBACK_ID_AIRP_OPEN_MEC
+};
+
 _STATIC _FeedbackHandler hfeedback;
 
 /**
@@ -97,51 +166,118 @@ FeedbackId _feedback_get_id_from_analog_index(const FeedbackAnalogIndex index) {
 }
 
 /**
- * @brief Get the status from an raw analog feedback value
+ * @brief Get the status of an analog feedback from its filtered value
  *
- * @details The 3V3 feedback is the only feedback considered high if between
- * the two thresholds, otherwise it is considered in the error state
+ * @details The thresholds are moved by the hysteresis in the direction that
+ * keeps the feedback in its current status
  *
- * @param index The index of the analog feedback
+ * @param config A pointer to the configuration of the feedback
+ * @param value The filtered raw value of the feedback
+ * @param status The current status of the feedback
  *
- * @return FeedbackStatus The status of the feedback
+ * @return FeedbackStatus The new status of the feedback
  */
-FeedbackStatus _feedback_get_analog_status(const FeedbackAnalogIndex index) {
-    // 3V3 probing is handled differently from the other feedbacks
-    if (index == FEEDBACK_ANALOG_INDEX_PROBING_3V3) {
-        if (hfeedback.analog[index] >= FEEDBACK_THRESHOLD_LOW_V &&
-            hfeedback.analog[index] <= FEEDBACK_THRESHOLD_HIGH_V)
-            return FEEDBACK_STATUS_HIGH;
-        return FEEDBACK_STATUS_ERROR;
-    }
-
-    volt_t thr_high = FEEDBACK_THRESHOLD_HIGH_V;
-    volt_t thr_low = FEEDBACK_THRESHOLD_LOW_V;
+_STATIC_INLINE FeedbackStatus _feedback_get_analog_status(
+    const FeedbackAnalogConfig * const config,
+    const raw_volt_t value,
+    const FeedbackStatus status)
+{
+    const raw_volt_t hysteresis = (status == FEEDBACK_STATUS_ERROR) ? 0U : config->hysteresis;
 
-    // BUG: Feedback voltage is too high
-    if (index == FEEDBACK_ANALOG_INDEX_IMD_OK ||
-        index == FEEDBACK_ANALOG_INDEX_AIRN_OPEN_MEC ||
-        index == FEEDBACK_ANALOG_INDEX_AIRP_OPEN_MEC)
-        thr_low = 1.6f;
+    // A window feedback widens its range while it is high
+    if (config->window) {
+        const int32_t low = (int32_t)config->low - hysteresis;
+        const int32_t high = (int32_t)config->high + hysteresis;
+        return (value >= low && value <= high) ? FEEDBACK_STATUS_HIGH : FEEDBACK_STATUS_ERROR;
+    }
 
-    if (hfeedback.analog[index] >= thr_high)
+    if (status == FEEDBACK_STATUS_HIGH && value + hysteresis >= config->high)
         return FEEDBACK_STATUS_HIGH;
-    if (hfeedback.analog[index] <= thr_low)
+    if (status == FEEDBACK_STATUS_LOW && value <= config->low + hysteresis)
+        return FEEDBACK_STATUS_LOW;
+    if (value >= config->high)
+        return FEEDBACK_STATUS_HIGH;
+    if (value <= config->low)
         return FEEDBACK_STATUS_LOW;
     return FEEDBACK_STATUS_ERROR;
 }
 
-FeedbackReturnCode feedback_init(const feedback_read_digital_all_callback_t read_all, const feedback_start_analog_conversion_callback_t start_conversion) {
-    if (read_all == NULL || start_conversion == NULL)
+/**
+ * @brief Record a status transition inside the edge log overwriting the oldest one
+ *
+ * @param timestamp The time of the acquisition where the transition is detected in us
+ * @param id The identifier of the feedback
+ * @param status The new status of the feedback
+ */
+_STATIC_INLINE void _feedback_push_edge(const microseconds_t timestamp, const FeedbackId id, const FeedbackStatus status) {
+    hfeedback.edges[hfeedback.edge_head] = (FeedbackEdge){
+        .timestamp = timestamp,
+        .id = (uint8_t)id,
+        .status = (uint8_t)status
+    };
+    hfeedback.edge_head = (hfeedback.edge_head + 1U) % FEEDBACK_EDGE_LOG_SIZE;
+    if (hfeedback.edge_count < FEEDBACK_EDGE_LOG_SIZE)
+        ++hfeedback.edge_count;
+}
+
+/**
+ * @brief Update the latency of a contactor after a transition of its mechanical feedback
+ *
+ * @param contactor The contactor
+ * @param timestamp The time of the acquisition where the transition is detected in us
+ * @param status The new status of the feedback
+ */
+_STATIC_INLINE void _feedback_update_latency(
+    const FeedbackContactor contactor,
+    const microseconds_t timestamp,
+    const FeedbackStatus status)
+{
+    FeedbackContactorLatency * const latency = &hfeedback.latency[contactor];
+    if (!latency->pending || status != latency->expected)
+        return;
+
+    // Ignore the acquisitions completed before the command
+    const int32_t elapsed = (int32_t)(timestamp - latency->command);
+    if (elapsed < 0)
+        return;
+    latency->pending = false;
+
+    const microseconds_t value = (microseconds_t)elapsed;
+    latency->last = value;
+    if (latency->count == 0U) {
+        latency->min = value;
+        latency->max = value;
+        latency->ewma = (float)value;
+    }
+    else {
+        latency->min = MAINBOARD_MIN(latency->min, value);
+        latency->max = MAINBOARD_MAX(latency->max, value);
+        latency->ewma += FEEDBACK_CONTACTOR_LATENCY_EWMA_ALPHA * ((float)value - latency->ewma);
+    }
+    ++latency->count;
+}
+
+FeedbackReturnCode feedback_init(
+    const feedback_read_digital_all_callback_t read_all,
+    const feedback_start_analog_conversion_callback_t start_conversion,
+    const feedback_get_time_us_callback_t get_time_us,
+    const interrupt_critical_section_enter_t cs_enter,
+    const interrupt_critical_section_exit_t cs_exit)
+{
+    if (read_all == NULL || start_conversion == NULL || get_time_us == NULL || cs_enter == NULL || cs_exit == NULL)
         return FEEDBACK_NULL_POINTER;
     memset(&hfeedback, 0U, sizeof(hfeedback)); 
     hfeedback.read_digital = read_all;
     hfeedback.start_conversion = start_conversion;
+    hfeedback.get_time_us = get_time_us;
+    hfeedback.cs_enter = cs_enter;
+    hfeedback.cs_exit = cs_exit;
     return FEEDBACK_OK;
 }
 
 FeedbackReturnCode feedback_update_digital_feedback_all(void) {
-    hfeedback.digital = hfeedback.read_digital();
+    const uint32_t next = hfeedback.sequence + 1U;
+    hfeedback.acquisitions[next % FEEDBACK_ACQUISITION_QUEUE_SIZE].digital = hfeedback.read_digital();
     return FEEDBACK_OK;
 }
 
@@ -150,13 +286,58 @@ FeedbackReturnCode feedback_start_analog_conversion_all(void) {
     return FEEDBACK_OK;
 }
 
-FeedbackReturnCode feedback_update_analog_feedback(const FeedbackAnalogIndex index, const volt_t value) {
-    if (index >=FEEDBACK_ANALOG_INDEX_COUNT)
+FeedbackReturnCode feedback_update_analog_feedback(
+    const FeedbackAnalogIndex index,
+    const raw_volt_t * const samples,
+    const size_t stride)
+{
+    if (samples == NULL)
+        return FEEDBACK_NULL_POINTER;
+    if (index >= FEEDBACK_ANALOG_INDEX_COUNT)
         return FEEDBACK_INVALID_INDEX;
-    hfeedback.analog[index] = value; 
+    const FeedbackAnalogConfig * const config = &feedback_analog_config[index];
+
+    // Average the newest samples
+    uint32_t sum = 0U;
+    for (size_t i = FEEDBACK_OVERSAMPLING_MAX - config->oversampling; i < FEEDBACK_OVERSAMPLING_MAX; ++i)
+        sum += samples[i * stride];
+    const uint32_t value = (sum << FEEDBACK_FILTER_FRACTION_BITS) / config->oversampling;
+
+    // The first value initialize the filter to avoid a slow start from zero
+    if (MAINBOARD_BIT_GET(hfeedback.primed, index) == 0U) {
+        hfeedback.primed = MAINBOARD_BIT_SET(hfeedback.primed, index);
+        hfeedback.filtered[index] = value;
+    }
+    else {
+        const int32_t delta = (int32_t)value - (int32_t)hfeedback.filtered[index];
+        hfeedback.filtered[index] = (uint32_t)((int32_t)hfeedback.filtered[index] + delta / (1 << config->shift));
+    }
+
+    // Update the status flags of the analog feedback
+    const FeedbackId id = _feedback_get_id_from_analog_index(index);
+    const raw_volt_t filtered = (raw_volt_t)(hfeedback.filtered[index] >> FEEDBACK_FILTER_FRACTION_BITS);
+    FeedbackStatus status = FEEDBACK_STATUS_ERROR;
+    if (MAINBOARD_BIT_GET(hfeedback.analog_high, id))
+        status = FEEDBACK_STATUS_HIGH;
+    else if (MAINBOARD_BIT_GET(hfeedback.analog_low, id))
+        status = FEEDBACK_STATUS_LOW;
+    status = _feedback_get_analog_status(config, filtered, status);
+    hfeedback.analog_high = MAINBOARD_BIT_TOGGLE_IF(hfeedback.analog_high, status == FEEDBACK_STATUS_HIGH, id);
+    hfeedback.analog_low = MAINBOARD_BIT_TOGGLE_IF(hfeedback.analog_low, status == FEEDBACK_STATUS_LOW, id);
     return FEEDBACK_OK;
 }
 
+void feedback_notify_conversion_complete(void) {
+    // The acquisition is published only after it is completely written
+    const uint32_t next = hfeedback.sequence + 1U;
+    _VOLATILE FeedbackAcquisition * const acquisition = &hfeedback.acquisitions[next % FEEDBACK_ACQUISITION_QUEUE_SIZE];
+    acquisition->timestamp = hfeedback.get_time_us();
+    (void)feedback_update_digital_feedback_all();
+    acquisition->analog_high = hfeedback.analog_high;
+    acquisition->analog_low = hfeedback.analog_low;
+    hfeedback.sequence = next;
+}
+
 bool feedback_get_digital(const FeedbackDigitalBit bit) {
     if (bit >= FEEDBACK_DIGITAL_BIT_COUNT)
         return false;
@@ -166,35 +347,104 @@ bool feedback_get_digital(const FeedbackDigitalBit bit) {
 volt_t feedback_get_analog(const FeedbackAnalogIndex index) {
     if (index >= FEEDBACK_ANALOG_INDEX_COUNT)
         return 0U;
-    return hfeedback.analog[index];
+    const float raw = (float)hfeedback.filtered[index] / (1U << FEEDBACK_FILTER_FRACTION_BITS);
+    return MAINBOARD_ADC_RAW_VALUE_TO_VOLT(raw, FEEDBACK_VREF, FEEDBACK_ADC_RESOLUTION);
 }
 
-uint32_t debug_cnt = 0U;
-FeedbackReturnCode feedback_update_status(void) {
-    // Update the status of the digital feedbacks
+/**
+ * @brief Update the status of all the feedbacks from a single acquisition
+ *
+ * @param acquisition A pointer to the copy of the acquisition
+ */
+_STATIC void _feedback_update_status_from(const FeedbackAcquisition * const acquisition) {
+    hfeedback.digital = acquisition->digital;
+    const microseconds_t timestamp = acquisition->timestamp;
+
+    // Update the status of the digital feedbacks, which can only be high or low
+    bit_flag32_t high = 0U;
+    bit_flag32_t low = 0U;
     for (FeedbackDigitalBit bit = 0U; bit < FEEDBACK_DIGITAL_BIT_COUNT; ++bit) {
         const FeedbackId id = _feedback_get_id_from_digital_bit(bit);
-        hfeedback.status[id] = MAINBOARD_BIT_GET(hfeedback.digital, bit) ?
-            FEEDBACK_STATUS_HIGH :
-            FEEDBACK_STATUS_LOW;
+        if (MAINBOARD_BIT_GET(acquisition->digital, bit))
+            high = MAINBOARD_BIT_SET(high, id);
+        else
+            low = MAINBOARD_BIT_SET(low, id);
     }
 
-    // Update the status of the analog feedback
-    for (FeedbackAnalogIndex i = 0U; i < FEEDBACK_ANALOG_INDEX_COUNT; ++i) {
-        const FeedbackId id = _feedback_get_id_from_analog_index(i);
-        // hfeedback.status[id] = _feedback_get_analog_status(i);
-        FeedbackStatus status = _feedback_get_analog_status(i);
-        // BUG: Noise cause AIR feedbacks voltage to change too much
-        if (i == FEEDBACK_ANALOG_INDEX_AIRN_OPEN_MEC || i == FEEDBACK_ANALOG_INDEX_AIRP_OPEN_MEC) {
-            if (status == FEEDBACK_STATUS_ERROR) {
-                ++debug_cnt;
-                status = hfeedback.analog[i] >= FEEDBACK_THRESHOLD_HIGH_V ? FEEDBACK_STATUS_HIGH : FEEDBACK_STATUS_LOW;
-            }
-            else {
-                debug_cnt = 0U;
-            }
+    // Merge the status of the analog feedbacks updated during the acquisition
+    high |= acquisition->analog_high;
+    low |= acquisition->analog_low;
+    bit_flag32_t changed = ((hfeedback.status_high ^ high) | (hfeedback.status_low ^ low)) & FEEDBACK_STATUS_MASK;
+    hfeedback.status_high = high;
+    hfeedback.status_low = low;
+
+    // Record the transitions, the latencies are shared with the contactor commands
+    hfeedback.cs_enter();
+    while (changed != 0U) {
+        const FeedbackId id = (FeedbackId)__builtin_ctz(changed);
+        changed &= changed - 1U;
+        const FeedbackStatus status = feedback_get_status(id);
+        _feedback_push_edge(timestamp, id, status);
+        for (FeedbackContactor contactor = 0U; contactor < FEEDBACK_CONTACTOR_COUNT; ++contactor)
+            if (feedback_contactor_id[contactor] == id)
+                _feedback_update_latency(contactor, timestamp, status);
+    }
+
+    // Give up the measurement if the contactor does not respond in time
+    for (FeedbackContactor contactor = 0U; contactor < FEEDBACK_CONTACTOR_COUNT; ++contactor) {
+        FeedbackContactorLatency * const latency = &hfeedback.latency[contactor];
+        if (latency->pending && (int32_t)(timestamp - latency->command) > (int32_t)FEEDBACK_CONTACTOR_LATENCY_TIMEOUT_US)
+            latency->pending = false;
+    }
+    hfeedback.cs_exit();
+}
+
+/**
+ * @brief Set the status of every feedback to error
+ *
+ * @details Used when the acquisitions stop, so that the checks do not pass on a frozen status
+ *
+ * @param timestamp The current time in us
+ */
+_STATIC void _feedback_invalidate_status(const microseconds_t timestamp) {
+    bit_flag32_t changed = (hfeedback.status_high | hfeedback.status_low) & FEEDBACK_STATUS_MASK;
+    hfeedback.status_high = 0U;
+    hfeedback.status_low = 0U;
+    hfeedback.stale = true;
+    while (changed != 0U) {
+        const FeedbackId id = (FeedbackId)__builtin_ctz(changed);
+        changed &= changed - 1U;
+        _feedback_push_edge(timestamp, id, FEEDBACK_STATUS_ERROR);
+    }
+}
+
+FeedbackReturnCode feedback_update_status(void) {
+    const uint32_t sequence = hfeedback.sequence;
+    const microseconds_t now = hfeedback.get_time_us();
+    if (sequence == hfeedback.last_sequence) {
+        if (!hfeedback.stale && now - hfeedback.last_acquisition > FEEDBACK_ACQUISITION_TIMEOUT_US)
+            _feedback_invalidate_status(now);
+        return FEEDBACK_OK;
+    }
+    hfeedback.last_acquisition = now;
+    hfeedback.stale = false;
+
+    // Skip the acquisitions whose slot has already been reused
+    if (sequence - hfeedback.last_sequence >= FEEDBACK_ACQUISITION_QUEUE_SIZE) {
+        hfeedback.lost += sequence - hfeedback.last_sequence - (FEEDBACK_ACQUISITION_QUEUE_SIZE - 1U);
+        hfeedback.last_sequence = sequence - (FEEDBACK_ACQUISITION_QUEUE_SIZE - 1U);
+    }
+
+    // Use every acquisition in order, dropping the ones overwritten during the copy
+    while (hfeedback.last_sequence != sequence) {
+        const uint32_t next = hfeedback.last_sequence + 1U;
+        const FeedbackAcquisition acquisition = hfeedback.acquisitions[next % FEEDBACK_ACQUISITION_QUEUE_SIZE];
+        hfeedback.last_sequence = next;
+        if (hfeedback.sequence - next >= FEEDBACK_ACQUISITION_QUEUE_SIZE - 1U) {
+            ++hfeedback.lost;
+            continue;
         }
-        hfeedback.status[id] = status;
+        _feedback_update_status_from(&acquisition);
     }
     return FEEDBACK_OK;
 }
@@ -202,7 +452,22 @@ FeedbackReturnCode feedback_update_status(void) {
 FeedbackStatus feedback_get_status(const FeedbackId id) {
     if (id >= FEEDBACK_ID_COUNT)
         return FEEDBACK_STATUS_ERROR;
-    return hfeedback.status[id];
+    if (MAINBOARD_BIT_GET(hfeedback.status_high, id))
+        return FEEDBACK_STATUS_HIGH;
+    if (MAINBOARD_BIT_GET(hfeedback.status_low, id))
+        return FEEDBACK_STATUS_LOW;
+    return FEEDBACK_STATUS_ERROR;
+}
+
+bit_flag32_t feedback_get_status_mask(const FeedbackStatus status) {
+    switch (status) {
+        case FEEDBACK_STATUS_HIGH:
+            return hfeedback.status_high;
+        case FEEDBACK_STATUS_LOW:
+            return hfeedback.status_low;
+        default:
+            return ~(hfeedback.status_high | hfeedback.status_low) & FEEDBACK_STATUS_MASK;
+    }
 }
 
 bool feedback_check_values(
@@ -210,26 +475,47 @@ bool feedback_check_values(
     const bit_flag32_t value,
     FeedbackId * const out)
 {
-    for (FeedbackId i = 0U; i < FEEDBACK_ID_COUNT; ++i) {
-        // Skip feedback not present inside the bitmask
-        if (MAINBOARD_BIT_GET(mask, i) == 0U)
-            continue;
+    /*
+     * A feedback matches if it is high and expected high or if it is low and expected low,
+     * every feedback in the error state never matches
+     */
+    const bit_flag32_t match = (value & hfeedback.status_high) | (~value & hfeedback.status_low);
+    const bit_flag32_t mismatch = mask & ~match & FEEDBACK_STATUS_MASK;
+    if (out != NULL)
+        *out = (mismatch == 0U) ? FEEDBACK_ID_UNKNOWN : (FeedbackId)__builtin_ctz(mismatch);
+    return mismatch == 0U;
+}
 
-        // Check if expected value does not match the current value
-        const bool expected_value = MAINBOARD_BIT_GET(value, i);
-        if ((hfeedback.status[i] != FEEDBACK_STATUS_LOW || expected_value) &&
-            (hfeedback.status[i] != FEEDBACK_STATUS_HIGH || !expected_value))
-        {
-            // Save the identifier of the feedback with the unexpected values
-            if (out != NULL)
-                *out = i;
-            return false;
-        }
+void feedback_notify_contactor_command(const FeedbackContactor contactor, const bool closed) {
+    if (contactor >= FEEDBACK_CONTACTOR_COUNT)
+        return;
+    FeedbackContactorLatency * const latency = &hfeedback.latency[contactor];
+
+    // The mechanical feedbacks are high when the contactor is open
+    const FeedbackStatus expected = closed ? FEEDBACK_STATUS_LOW : FEEDBACK_STATUS_HIGH;
+
+    // The FSM repeats the command issued by the ECU handler, keep the time of the first one
+    hfeedback.cs_enter();
+    if (!latency->pending || latency->expected != expected) {
+        latency->expected = expected;
+        latency->command = hfeedback.get_time_us();
+        latency->pending = feedback_get_status(feedback_contactor_id[contactor]) != expected;
     }
-    // If this point is reached every checked feedback match the expected value
-    if (out != NULL)
-        *out = FEEDBACK_ID_UNKNOWN;
-    return true;
+    hfeedback.cs_exit();
+}
+
+size_t feedback_get_edge_count(void) {
+    return hfeedback.edge_count;
+}
+
+FeedbackReturnCode feedback_get_edge(const size_t index, FeedbackEdge * const out) {
+    if (out == NULL)
+        return FEEDBACK_NULL_POINTER;
+    if (index >= hfeedback.edge_count)
+        return FEEDBACK_INVALID_INDEX;
+    const size_t oldest = (hfeedback.edge_head + FEEDBACK_EDGE_LOG_SIZE - hfeedback.edge_count) % FEEDBACK_EDGE_LOG_SIZE;
+    *out = hfeedback.edges[(oldest + index) % FEEDBACK_EDGE_LOG_SIZE];
+    return FEEDBACK_OK;
 }
 
 bool feedback_is_digital(const FeedbackId id) {
@@ -328,33 +614,10 @@ FeedbackAnalogIndex feedback_get_analog_index_from_id(const FeedbackId id) {
 primary_hv_feedback_status_converted_t * feedback_get_status_payload(size_t * const byte_size) {
     if (byte_size != NULL)
         *byte_size = sizeof(hfeedback.status_can_payload);
-    hfeedback.status_can_payload.airn_open_com = (primary_hv_feedback_status_airn_open_com)hfeedback.status[FEEDBACK_ID_AIRN_OPEN_COM];
-    hfeedback.status_can_payload.precharge_open_com = (primary_hv_feedback_status_precharge_open_com)hfeedback.status[FEEDBACK_ID_PRECHARGE_OPEN_COM];
-    hfeedback.status_can_payload.airp_open_com = (primary_hv_feedback_status_airp_open_com)hfeedback.status[FEEDBACK_ID_AIRP_OPEN_COM];
-    hfeedback.status_can_payload.airn_open_mec = (primary_hv_feedback_status_airn_open_mec)hfeedback.status[FEEDBACK_ID_AIRN_OPEN_MEC];
-    hfeedback.status_can_payload.precharge_open_mec = (primary_hv_feedback_status_precharge_open_mec)hfeedback.status[FEEDBACK_ID_PRECHARGE_OPEN_MEC];
-    hfeedback.status_can_payload.airp_open_mec = (primary_hv_feedback_status_airp_open_mec)hfeedback.status[FEEDBACK_ID_AIRP_OPEN_MEC];
-    hfeedback.status_can_payload.sd_imd_fb = (primary_hv_feedback_status_sd_imd_fb)hfeedback.status[FEEDBACK_ID_SD_IMD_FB];
-    hfeedback.status_can_payload.sd_bms_fb = (primary_hv_feedback_status_sd_bms_fb)hfeedback.status[FEEDBACK_ID_SD_BMS_FB];
-    hfeedback.status_can_payload.ts_less_than_60v = (primary_hv_feedback_status_ts_less_than_60v)hfeedback.status[FEEDBACK_ID_TS_LESS_THAN_60V];
-    hfeedback.status_can_payload.plausible_state_persisted = (primary_hv_feedback_status_plausible_state_persisted)hfeedback.status[FEEDBACK_ID_PLAUSIBLE_STATE_PERSISTED];
-    hfeedback.status_can_payload.plausible_state = (primary_hv_feedback_status_plausible_state)hfeedback.status[FEEDBACK_ID_PLAUSIBLE_STATE];
-    hfeedback.status_can_payload.not_bms_fault_cockpit_led = (primary_hv_feedback_status_not_bms_fault_cockpit_led)hfeedback.status[FEEDBACK_ID_BMS_FAULT_COCKPIT_LED];
-    hfeedback.status_can_payload.not_imd_fault_cockpit_led = (primary_hv_feedback_status_not_imd_fault_cockpit_led)hfeedback.status[FEEDBACK_ID_IMD_FAULT_COCKPIT_LED];
-    hfeedback.status_can_payload.indicator_connected = (primary_hv_feedback_status_indicator_connected)hfeedback.status[FEEDBACK_ID_INDICATOR_CONNECTED];
-    hfeedback.status_can_payload.not_latch_reset = (primary_hv_feedback_status_not_latch_reset)hfeedback.status[FEEDBACK_ID_LATCH_RESET];
-    hfeedback.status_can_payload.plausible_state_latched = (primary_hv_feedback_status_plausible_state_latched)hfeedback.status[FEEDBACK_ID_PLAUSIBLE_STATE_LATCHED];
-    hfeedback.status_can_payload.not_bms_fault_latched = (primary_hv_feedback_status_not_bms_fault_latched)hfeedback.status[FEEDBACK_ID_BMS_FAULT_LATCHED];
-    hfeedback.status_can_payload.not_imd_fault_latched = (primary_hv_feedback_status_not_imd_fault_latched)hfeedback.status[FEEDBACK_ID_IMD_FAULT_LATCHED];
-    hfeedback.status_can_payload.not_ext_fault_latched = (primary_hv_feedback_status_not_ext_fault_latched)hfeedback.status[FEEDBACK_ID_EXT_FAULT_LATCHED];
-    hfeedback.status_can_payload.imd_ok = (primary_hv_feedback_status_imd_ok)hfeedback.status[FEEDBACK_ID_IMD_OK];
-    hfeedback.status_can_payload.plausible_state_rc = (primary_hv_feedback_status_plausible_state_rc)hfeedback.status[FEEDBACK_ID_PLAUSIBLE_STATE_RC];
-    hfeedback.status_can_payload.tsal_green = (primary_hv_feedback_status_tsal_green)hfeedback.status[FEEDBACK_ID_TSAL_GREEN];
-    hfeedback.status_can_payload.probing_3v3 = (primary_hv_feedback_status_probing_3v3)hfeedback.status[FEEDBACK_ID_PROBING_3V3];
-    hfeedback.status_can_payload.sd_out = (primary_hv_feedback_status_sd_out)hfeedback.status[FEEDBACK_ID_SD_OUT];
-    hfeedback.status_can_payload.sd_in = (primary_hv_feedback_status_sd_in)hfeedback.status[FEEDBACK_ID_SD_IN];
-    hfeedback.status_can_payload.sd_end = (primary_hv_feedback_status_sd_end)hfeedback.status[FEEDBACK_ID_SD_END];
-    hfeedback.status_can_payload.v5_mcu = (primary_hv_feedback_status_v5_mcu)hfeedback.status[FEEDBACK_ID_V5_MCU];
+#define FEEDBACK_STATUS_PAYLOAD_X(FIELD, ID) \
+    hfeedback.status_can_payload.FIELD = (primary_hv_feedback_status_##FIELD)feedback_get_status(FEEDBACK_ID_##ID);
+    FEEDBACK_STATUS_PAYLOAD_X_LIST
+#undef FEEDBACK_STATUS_PAYLOAD_X
     return &hfeedback.status_can_payload; 
 }
 
@@ -384,22 +647,22 @@ primary_hv_feedback_digital_converted_t * feedback_get_digital_payload(size_t *
 primary_hv_feedback_analog_converted_t * feedback_get_analog_payload(size_t * const byte_size) {
     if (byte_size != NULL)
         *byte_size = sizeof(hfeedback.analog_can_payload);
-    hfeedback.analog_can_payload.analog_airn_open_mec = hfeedback.analog[FEEDBACK_ANALOG_INDEX_AIRN_OPEN_MEC];
-    hfeedback.analog_can_payload.analog_airp_open_mec = hfeedback.analog[FEEDBACK_ANALOG_INDEX_AIRP_OPEN_MEC];
-    hfeedback.analog_can_payload.analog_imd_ok = hfeedback.analog[FEEDBACK_ANALOG_INDEX_IMD_OK];
-    hfeedback.analog_can_payload.analog_plausible_state_rc = hfeedback.analog[FEEDBACK_ANALOG_INDEX_PLAUSIBLE_STATE_RC];
-    hfeedback.analog_can_payload.analog_tsal_green = hfeedback.analog[FEEDBACK_ANALOG_INDEX_TSAL_GREEN];
-    hfeedback.analog_can_payload.analog_probing_3v3 = hfeedback.analog[FEEDBACK_ANALOG_INDEX_PROBING_3V3];
-    hfeedback.analog_can_payload.analog_v5_mcu = FEEDBACK_VOLTAGE_TO_5V_VOLT(hfeedback.analog[FEEDBACK_ANALOG_INDEX_V5_MCU]);
+    hfeedback.analog_can_payload.analog_airn_open_mec = feedback_get_analog(FEEDBACK_ANALOG_INDEX_AIRN_OPEN_MEC);
+    hfeedback.analog_can_payload.analog_airp_open_mec = feedback_get_analog(FEEDBACK_ANALOG_INDEX_AIRP_OPEN_MEC);
+    hfeedback.analog_can_payload.analog_imd_ok = feedback_get_analog(FEEDBACK_ANALOG_INDEX_IMD_OK);
+    hfeedback.analog_can_payload.analog_plausible_state_rc = feedback_get_analog(FEEDBACK_ANALOG_INDEX_PLAUSIBLE_STATE_RC);
+    hfeedback.analog_can_payload.analog_tsal_green = feedback_get_analog(FEEDBACK_ANALOG_INDEX_TSAL_GREEN);
+    hfeedback.analog_can_payload.analog_probing_3v3 = feedback_get_analog(FEEDBACK_ANALOG_INDEX_PROBING_3V3);
+    hfeedback.analog_can_payload.analog_v5_mcu = FEEDBACK_VOLTAGE_TO_5V_VOLT(feedback_get_analog(FEEDBACK_ANALOG_INDEX_V5_MCU));
     return &hfeedback.analog_can_payload; 
 }
 
 primary_hv_feedback_analog_sd_converted_t * feedback_get_analog_sd_payload(size_t * const byte_size) {
     if (byte_size != NULL)
         *byte_size = sizeof(hfeedback.analog_sd_can_payload);
-    hfeedback.analog_sd_can_payload.sd_out = FEEDBACK_VOLTAGE_TO_SD_VOLT(hfeedback.analog[FEEDBACK_ANALOG_INDEX_SD_OUT]);
-    hfeedback.analog_sd_can_payload.sd_in = FEEDBACK_VOLTAGE_TO_SD_VOLT(hfeedback.analog[FEEDBACK_ANALOG_INDEX_SD_IN]);
-    hfeedback.analog_sd_can_payload.sd_end = FEEDBACK_VOLTAGE_TO_SD_VOLT(hfeedback.analog[FEEDBACK_ANALOG_INDEX_SD_END]);
+    hfeedback.analog_sd_can_payload.sd_out = FEEDBACK_VOLTAGE_TO_SD_VOLT(feedback_get_analog(FEEDBACK_ANALOG_INDEX_SD_OUT));
+    hfeedback.analog_sd_can_payload.sd_in = FEEDBACK_VOLTAGE_TO_SD_VOLT(feedback_get_analog(FEEDBACK_ANALOG_INDEX_SD_IN));
+    hfeedback.analog_sd_can_payload.sd_end = FEEDBACK_VOLTAGE_TO_SD_VOLT(feedback_get_analog(FEEDBACK_ANALOG_INDEX_SD_END));
     return &hfeedback.analog_sd_can_payload; 
 }
 
@@ -422,6 +685,31 @@ primary_hv_feedback_enzomma_converted_t * feedback_get_enzomma_payload(const Fee
     return &hfeedback.enzomma_can_payload;
 }
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+primary_hv_contactor_latency_converted_t * feedback_get_contactor_latency_payload(size_t * const byte_size) {
+    // Send the next contactor with at least one measured latency
+    for (size_t i = 0U; i < FEEDBACK_CONTACTOR_COUNT; ++i) {
+        const FeedbackContactor contactor = hfeedback.latency_contactor;
+        hfeedback.latency_contactor = (contactor + 1U) % FEEDBACK_CONTACTOR_COUNT;
+        const FeedbackContactorLatency * const latency = &hfeedback.latency[contactor];
+        if (latency->count == 0U)
+            continue;
+
+        if (byte_size != NULL)
+            *byte_size = sizeof(hfeedback.contactor_latency_can_payload);
+        hfeedback.contactor_latency_can_payload.contactor = (primary_hv_contactor_latency_contactor)contactor;
+        hfeedback.contactor_latency_can_payload.last = latency->last * 0.001f;
+        hfeedback.contactor_latency_can_payload.min = latency->min * 0.001f;
+        hfeedback.contactor_latency_can_payload.max = latency->max * 0.001f;
+        hfeedback.contactor_latency_can_payload.average = latency->ewma * 0.001f;
+        return &hfeedback.contactor_latency_can_payload;
+    }
+    return NULL;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 #ifdef CONF_FEEDBACK_STRINGS_ENABLE
 
 _STATIC char * feedback_module_name = "feedback";
@@ -0,0 +1,228 @@
+/**
+ * @file fixed-point.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Fixed-point representation of the cells data and aggregate kernels
+ */
+
+#include "fixed-point.h"
+
+#include <string.h>
+
+#include "cmsis_compiler.h"
+
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define FIXED_POINT_SIMD_ENABLE
+#endif  // __ARM_FEATURE_DSP
+
+#ifdef FIXED_POINT_SIMD_ENABLE
+
+/**
+ * @brief Load two consecutive 16-bit values as a single word
+ *
+ * @details The copy avoids unaligned double word loads that the compiler
+ * could generate when dereferencing the casted pointer directly
+ *
+ * @param data A pointer to the first value
+ *
+ * @return uint32_t The two values packed inside a word
+ */
+_STATIC_INLINE uint32_t _fixed_point_load_pair(const void * const data) {
+    uint32_t word;
+    memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+/*
+ * SEL reads the GE flags written by the parallel subtraction, both instructions
+ * are inside the same asm block so the compiler can not schedule anything that
+ * changes the flags between them, the lanes where a >= b take the first operand
+ * of SEL and the others take the second one
+ */
+
+/** @brief Get the unsigned minimum of each 16-bit lane of two words */
+_STATIC_INLINE uint32_t _fixed_point_u16_min2(const uint32_t a, const uint32_t b) {
+    uint32_t result;
+    __ASM volatile (
+        "usub16 %0, %1, %2\n\t"
+        "sel %0, %2, %1"
+        : "=&r" (result)
+        : "r" (a), "r" (b)
+        : "cc"
+    );
+    return result;
+}
+
+/** @brief Get the unsigned maximum of each 16-bit lane of two words */
+_STATIC_INLINE uint32_t _fixed_point_u16_max2(const uint32_t a, const uint32_t b) {
+    uint32_t result;
+    __ASM volatile (
+        "usub16 %0, %1, %2\n\t"
+        "sel %0, %1, %2"
+        : "=&r" (result)
+        : "r" (a), "r" (b)
+        : "cc"
+    );
+    return result;
+}
+
+/** @brief Get the signed minimum of each 16-bit lane of two words */
+_STATIC_INLINE uint32_t _fixed_point_i16_min2(const uint32_t a, const uint32_t b) {
+    uint32_t result;
+    __ASM volatile (
+        "ssub16 %0, %1, %2\n\t"
+        "sel %0, %2, %1"
+        : "=&r" (result)
+        : "r" (a), "r" (b)
+        : "cc"
+    );
+    return result;
+}
+
+/** @brief Get the signed maximum of each 16-bit lane of two words */
+_STATIC_INLINE uint32_t _fixed_point_i16_max2(const uint32_t a, const uint32_t b) {
+    uint32_t result;
+    __ASM volatile (
+        "ssub16 %0, %1, %2\n\t"
+        "sel %0, %1, %2"
+        : "=&r" (result)
+        : "r" (a), "r" (b)
+        : "cc"
+    );
+    return result;
+}
+
+#endif  // FIXED_POINT_SIMD_ENABLE
+
+void fixed_point_u16_aggregate(
+    const uint16_t * const data,
+    const size_t count,
+    uint16_t * const min,
+    uint16_t * const max,
+    uint32_t * const sum)
+{
+    uint16_t lo = data[0U];
+    uint16_t hi = data[0U];
+    uint32_t acc = 0U;
+    size_t i = 0U;
+
+#ifdef FIXED_POINT_SIMD_ENABLE
+    if (count >= 2U) {
+        uint32_t vmin = _fixed_point_load_pair(data);
+        uint32_t vmax = vmin;
+        for (; i + 1U < count; i += 2U) {
+            const uint32_t word = _fixed_point_load_pair(&data[i]);
+            vmin = _fixed_point_u16_min2(vmin, word);
+            vmax = _fixed_point_u16_max2(vmax, word);
+            // SMLAD would treat the lanes as signed values
+            acc += (uint16_t)word + (word >> 16U);
+        }
+        lo = MAINBOARD_MIN((uint16_t)vmin, (uint16_t)(vmin >> 16U));
+        hi = MAINBOARD_MAX((uint16_t)vmax, (uint16_t)(vmax >> 16U));
+    }
+#endif  // FIXED_POINT_SIMD_ENABLE
+
+    for (; i < count; ++i) {
+        lo = MAINBOARD_MIN(lo, data[i]);
+        hi = MAINBOARD_MAX(hi, data[i]);
+        acc += data[i];
+    }
+
+    if (min != NULL)
+        *min = lo;
+    if (max != NULL)
+        *max = hi;
+    if (sum != NULL)
+        *sum = acc;
+}
+
+void fixed_point_i16_aggregate(
+    const int16_t * const data,
+    const size_t count,
+    int16_t * const min,
+    int16_t * const max,
+    int32_t * const sum)
+{
+    int16_t lo = data[0U];
+    int16_t hi = data[0U];
+    int32_t acc = 0;
+    size_t i = 0U;
+
+#ifdef FIXED_POINT_SIMD_ENABLE
+    if (count >= 2U) {
+        uint32_t vmin = _fixed_point_load_pair(data);
+        uint32_t vmax = vmin;
+        for (; i + 1U < count; i += 2U) {
+            const uint32_t word = _fixed_point_load_pair(&data[i]);
+            vmin = _fixed_point_i16_min2(vmin, word);
+            vmax = _fixed_point_i16_max2(vmax, word);
+            acc = (int32_t)__SMLAD(word, 0x00010001U, (uint32_t)acc);
+        }
+        lo = MAINBOARD_MIN((int16_t)vmin, (int16_t)(vmin >> 16U));
+        hi = MAINBOARD_MAX((int16_t)vmax, (int16_t)(vmax >> 16U));
+    }
+#endif  // FIXED_POINT_SIMD_ENABLE
+
+    for (; i < count; ++i) {
+        lo = MAINBOARD_MIN(lo, data[i]);
+        hi = MAINBOARD_MAX(hi, data[i]);
+        acc += data[i];
+    }
+
+    if (min != NULL)
+        *min = lo;
+    if (max != NULL)
+        *max = hi;
+    if (sum != NULL)
+        *sum = acc;
+}
+
+int64_t fixed_point_i16_sum_squares(const int16_t * const data, const size_t count) {
+    int64_t acc = 0;
+    size_t i = 0U;
+
+#ifdef FIXED_POINT_SIMD_ENABLE
+    for (; i + 1U < count; i += 2U) {
+        const uint32_t word = _fixed_point_load_pair(&data[i]);
+        acc = (int64_t)__SMLALD(word, word, (uint64_t)acc);
+    }
+#endif  // FIXED_POINT_SIMD_ENABLE
+
+    for (; i < count; ++i)
+        acc += (int32_t)data[i] * data[i];
+    return acc;
+}
+
+void fixed_point_u16_histogram(
+    const uint16_t * const data,
+    const size_t count,
+    const uint16_t low,
+    const uint16_t width,
+    uint16_t * const bins,
+    const size_t bin_count)
+{
+    if (data == NULL || bins == NULL || bin_count == 0U || width == 0U)
+        return;
+    memset(bins, 0U, bin_count * sizeof(*bins));
+
+    size_t i = 0U;
+#ifdef FIXED_POINT_SIMD_ENABLE
+    // Remove the offset from two values at once saturating the ones below the lower bound
+    const uint32_t offset = ((uint32_t)low << 16U) | low;
+    for (; i + 1U < count; i += 2U) {
+        const uint32_t word = __UQSUB16(_fixed_point_load_pair(&data[i]), offset);
+        ++bins[MAINBOARD_MIN((size_t)((uint16_t)word / width), bin_count - 1U)];
+        ++bins[MAINBOARD_MIN((size_t)((uint16_t)(word >> 16U) / width), bin_count - 1U)];
+    }
+#endif  // FIXED_POINT_SIMD_ENABLE
+
+    for (; i < count; ++i) {
+        const uint16_t value = (data[i] > low) ? (uint16_t)(data[i] - low) : 0U;
+        ++bins[MAINBOARD_MIN((size_t)(value / width), bin_count - 1U)];
+    }
+}
+
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
@@ -0,0 +1,97 @@
+/**
+ * @file freshness.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Freshness and sweep tracking of a group of measured values
+ */
+
+#include "freshness.h"
+
+#include <string.h>
+
+/**
+ * @brief Search the value with the oldest update time
+ *
+ * @details The ages are compared with respect to the newest update time
+ * so that the result is correct even if the tick counter overflows
+ *
+ * @param freshness A pointer to the freshness structure
+ * @param newest The time of the newest update in ticks
+ */
+_STATIC_INLINE void _freshness_find_oldest(Freshness * const freshness, const ticks_t newest) {
+    size_t oldest = 0U;
+    ticks_t age = 0U;
+    for (size_t i = 0U; i < freshness->count; ++i) {
+        const ticks_t value_age = newest - freshness->last_update[i];
+        if (value_age > age) {
+            age = value_age;
+            oldest = i;
+        }
+    }
+    freshness->oldest = oldest;
+}
+
+void freshness_init(
+    Freshness * const freshness,
+    bit_flag32_t * const fresh,
+    ticks_t * const last_update,
+    const size_t count)
+{
+    memset(freshness, 0U, sizeof(*freshness));
+    freshness->fresh = fresh;
+    freshness->last_update = last_update;
+    freshness->count = count;
+    memset(fresh, 0U, FRESHNESS_WORD_COUNT(count) * sizeof(*fresh));
+    memset(last_update, 0U, count * sizeof(*last_update));
+}
+
+bool freshness_update(
+    Freshness * const freshness,
+    const size_t start,
+    const size_t size,
+    const ticks_t timestamp)
+{
+    if (start + size > freshness->count)
+        return false;
+
+    bool refresh_oldest = false;
+    for (size_t i = start; i < start + size; ++i) {
+        freshness->last_update[i] = timestamp;
+        refresh_oldest |= (i == freshness->oldest);
+
+        bit_flag32_t * const word = &freshness->fresh[i / 32U];
+        const bit_pos_t bit = i % 32U;
+        if (!MAINBOARD_BIT_GET(*word, bit)) {
+            *word = MAINBOARD_BIT_SET(*word, bit);
+            ++freshness->fresh_count;
+        }
+    }
+    if (refresh_oldest)
+        _freshness_find_oldest(freshness, timestamp);
+
+    // Start a new sweep when every value has been updated
+    if (freshness->fresh_count < freshness->count)
+        return false;
+    memset(freshness->fresh, 0U, FRESHNESS_WORD_COUNT(freshness->count) * sizeof(*freshness->fresh));
+    freshness->fresh_count = 0U;
+    freshness->sweep_time = timestamp;
+    ++freshness->sweep;
+    return true;
+}
+
+bool freshness_is_fresh(const Freshness * const freshness, const size_t index) {
+    if (index >= freshness->count)
+        return false;
+    return MAINBOARD_BIT_GET(freshness->fresh[index / 32U], index % 32U);
+}
+
+ticks_t freshness_get_age(const Freshness * const freshness, const size_t index, const ticks_t now) {
+    if (index >= freshness->count)
+        return 0U;
+    return now - freshness->last_update[index];
+}
+
+ticks_t freshness_get_oldest_age(const Freshness * const freshness, const ticks_t now) {
+    return now - freshness->last_update[freshness->oldest];
+}
@@ -28,6 +28,8 @@ Functions and types have been generated with prefix "fsm_"
 #include "feedback.h"
 #include "bal.h"
 #include "error.h"
+#include "event-log.h"
+#include "black-box.h"
 /*** USER CODE END MACROS ***/
 
 
@@ -183,6 +185,7 @@ fsm_state_t fsm_do_idle(fsm_state_data_t *data) {
   /*** USER CODE BEGIN DO_IDLE ***/
   MAINBOARD_UNUSED(data);
 
+  (void)can_comm_fast_routine();
   (void)timebase_routine();
   (void)can_comm_routine();
   (void)display_run_animation(
@@ -193,7 +196,7 @@ fsm_state_t fsm_do_idle(fsm_state_data_t *data) {
   );
 
   // Check for errors
-  if (error_get_expired() > 0)
+  if (error_is_expired())
       next_state = FSM_STATE_FATAL;
   // Check for events
   else if (fsm_is_event_triggered()) {
@@ -201,7 +204,7 @@ fsm_state_t fsm_do_idle(fsm_state_data_t *data) {
             next_state = FSM_STATE_FATAL;
       else if (fsm_fired_event->type == FSM_EVENT_TYPE_FLASH_REQUEST)
           next_state = FSM_STATE_FLASH;
-      else if (fsm_fired_event->type == FSM_EVENT_TYPE_TS_ON) {
+      else if (fsm_fired_event->type == FSM_EVENT_TYPE_TS_ON && !pcu_is_ts_off_requested()) {
           FeedbackId id = FEEDBACK_ID_UNKNOWN;
           if (feedback_check_values(
                   FEEDBACK_IDLE_TO_AIRN_CHECK_MASK,
@@ -226,6 +229,9 @@ fsm_state_t fsm_do_idle(fsm_state_data_t *data) {
       else if (fsm_fired_event->type == FSM_EVENT_TYPE_BALANCING_START)
           next_state = FSM_STATE_BALANCING;
   }
+  // Consume a TS off request received while the TS is already off
+  if (pcu_is_ts_off_requested())
+      pcu_reset_all();
   /*** USER CODE END DO_IDLE ***/
   
   switch (next_state) {
@@ -253,6 +259,7 @@ fsm_state_t fsm_do_fatal(fsm_state_data_t *data) {
   /*** USER CODE BEGIN DO_FATAL ***/
   MAINBOARD_UNUSED(data); 
 
+  (void)can_comm_fast_routine();
   (void)timebase_routine();
   (void)can_comm_routine();
 
@@ -299,7 +306,7 @@ fsm_state_t fsm_do_flash(fsm_state_data_t *data) {
   const ProgrammerReturnCode code = programmer_routine();
 
   // Check for errors 
-  if (error_get_expired() > 0)
+  if (error_is_expired())
       next_state = FSM_STATE_FATAL;
   else if (code == PROGRAMMER_TIMEOUT || code == PROGRAMMER_OK)
       next_state = FSM_STATE_IDLE;
@@ -334,6 +341,7 @@ fsm_state_t fsm_do_balancing(fsm_state_data_t *data) {
   /*** USER CODE BEGIN DO_BALANCING ***/
   MAINBOARD_UNUSED(data); 
 
+  (void)can_comm_fast_routine();
   (void)timebase_routine();
   (void)can_comm_routine();
   (void)display_run_animation(
@@ -343,7 +351,7 @@ fsm_state_t fsm_do_balancing(fsm_state_data_t *data) {
       timebase_get_tick()
   );
 
-  if (error_get_expired() > 0)
+  if (error_is_expired())
       next_state = FSM_STATE_FATAL;
   else if (fsm_is_event_triggered()) {
       if (fsm_fired_event->type == FSM_EVENT_TYPE_CELLBOARD_FATAL)
@@ -376,11 +384,12 @@ fsm_state_t fsm_do_airn_check(fsm_state_data_t *data) {
   /*** USER CODE BEGIN DO_AIRN_CHECK ***/
   MAINBOARD_UNUSED(data); 
 
+  (void)can_comm_fast_routine();
   (void)timebase_routine();
   (void)can_comm_routine();
 
   FeedbackId id = FEEDBACK_ID_UNKNOWN;
-  if (error_get_expired() > 0)
+  if (error_is_expired())
       next_state = FSM_STATE_FATAL;
   else if (fsm_is_event_triggered()) {
       if (fsm_fired_event->type == FSM_EVENT_TYPE_CELLBOARD_FATAL)
@@ -431,6 +440,13 @@ fsm_state_t fsm_do_airn_check(fsm_state_data_t *data) {
       next_state = FSM_STATE_PRECHARGE_CHECK;
   }
 
+  /*
+   * The TS off request from the ECU is latched because its event is dropped
+   * if another one is still pending, the AIRs are already open at this point
+   */
+  if (next_state != FSM_STATE_FATAL && pcu_is_ts_off_requested())
+      next_state = FSM_STATE_IDLE;
+
   // If there is a problem during the TS on procedure send info about the problematic feedback
   if (next_state == FSM_STATE_IDLE) {
       size_t byte_size = 0U;
@@ -469,6 +485,7 @@ fsm_state_t fsm_do_precharge_check(fsm_state_data_t *data) {
   /*** USER CODE BEGIN DO_PRECHARGE_CHECK ***/
   MAINBOARD_UNUSED(data); 
 
+  (void)can_comm_fast_routine();
   (void)timebase_routine();
   (void)can_comm_routine();
 
@@ -478,7 +495,7 @@ fsm_state_t fsm_do_precharge_check(fsm_state_data_t *data) {
   (void)display_set_digit(perc);
 
   FeedbackId id = FEEDBACK_ID_UNKNOWN;
-  if (error_get_expired() > 0)
+  if (error_is_expired())
       next_state = FSM_STATE_FATAL;
   else if (fsm_is_event_triggered()) {
       if (fsm_fired_event->type == FSM_EVENT_TYPE_CELLBOARD_FATAL)
@@ -526,6 +543,10 @@ fsm_state_t fsm_do_precharge_check(fsm_state_data_t *data) {
       next_state = FSM_STATE_AIRP_CHECK;
   }
 
+  // Handle the latched TS off request from the ECU
+  if (next_state != FSM_STATE_FATAL && pcu_is_ts_off_requested())
+      next_state = FSM_STATE_IDLE;
+
   // If there is a problem during the TS on procedure send info about the problematic feedback
   if (next_state == FSM_STATE_IDLE) {
       size_t byte_size = 0U;
@@ -564,11 +585,12 @@ fsm_state_t fsm_do_airp_check(fsm_state_data_t *data) {
   /*** USER CODE BEGIN DO_AIRP_CHECK ***/
   MAINBOARD_UNUSED(data); 
 
+  (void)can_comm_fast_routine();
   (void)timebase_routine();
   (void)can_comm_routine();
   
   FeedbackId id = FEEDBACK_ID_UNKNOWN;
-  if (error_get_expired() > 0)
+  if (error_is_expired())
       next_state = FSM_STATE_FATAL;
   else if (fsm_is_event_triggered()) {
       if (fsm_fired_event->type == FSM_EVENT_TYPE_CELLBOARD_FATAL)
@@ -615,6 +637,10 @@ fsm_state_t fsm_do_airp_check(fsm_state_data_t *data) {
       next_state = FSM_STATE_TS_ON;
   }
 
+  // Handle the latched TS off request from the ECU
+  if (next_state != FSM_STATE_FATAL && pcu_is_ts_off_requested())
+      next_state = FSM_STATE_IDLE;
+
   // If there is a problem during the TS on procedure send info about the problematic feedback
   if (next_state == FSM_STATE_IDLE) {
       size_t byte_size = 0U;
@@ -653,6 +679,7 @@ fsm_state_t fsm_do_ts_on(fsm_state_data_t *data) {
   /*** USER CODE BEGIN DO_TS_ON ***/
   MAINBOARD_UNUSED(data); 
 
+  (void)can_comm_fast_routine();
   (void)timebase_routine();
   (void)can_comm_routine();
   (void)display_run_animation(
@@ -663,7 +690,7 @@ fsm_state_t fsm_do_ts_on(fsm_state_data_t *data) {
   );
 
   FeedbackId id = FEEDBACK_ID_UNKNOWN;
-  if (error_get_expired() > 0)
+  if (error_is_expired())
       next_state = FSM_STATE_FATAL;
   else if (fsm_is_event_triggered()) {
       if (fsm_fired_event->type == FSM_EVENT_TYPE_CELLBOARD_FATAL)
@@ -688,6 +715,10 @@ fsm_state_t fsm_do_ts_on(fsm_state_data_t *data) {
       );
       next_state = FSM_STATE_IDLE;
   }
+
+  // Handle the latched TS off request from the ECU
+  if (next_state != FSM_STATE_FATAL && pcu_is_ts_off_requested())
+      next_state = FSM_STATE_IDLE;
   /*** USER CODE END DO_TS_ON ***/
   
   switch (next_state) {
@@ -735,6 +766,9 @@ void fsm_idle_to_fatal(fsm_state_data_t *data) {
 
   // Activate the AMS
   pcu_ams_activate();
+
+  // Save the pack state that led to the error
+  black_box_trigger();
   /*** USER CODE END IDLE_TO_FATAL ***/
 }
 
@@ -795,6 +829,9 @@ void fsm_handle_fatal_error(fsm_state_data_t *data) {
 
   // Stop balancing in case it is running
   (void)bal_stop();
+
+  // Save the pack state that led to the error
+  black_box_trigger();
   /*** USER CODE END HANDLE_FATAL_ERROR ***/
 }
 
@@ -888,6 +925,8 @@ void fsm_ts_on(fsm_state_data_t *data) {
 fsm_state_t fsm_run_state(fsm_state_t cur_state, fsm_state_data_t *data) {
   
   /*** USER CODE BEGIN RUN_STATE ***/
+  if (hfsm.fsm_state != cur_state)
+    (void)event_log_push(EVENT_LOG_TYPE_FSM_TRANSITION, hfsm.fsm_state, cur_state);
   hfsm.fsm_state = cur_state;
   /*** USER CODE END RUN_STATE ***/
 
@@ -13,6 +13,7 @@
 #include "timebase.h"
 #include "fsm.h"
 #include "internal-voltage.h"
+#include "feedback.h"
 
 #ifdef CONF_PCU_MODULE_ENABLE
 
@@ -73,6 +74,7 @@ PcuReturnCode pcu_init(const pcu_set_state_callback_t set, const pcu_toggle_stat
     hpcu.set = set;
     hpcu.toggle = toggle;
     hpcu.event.type = FSM_EVENT_TYPE_IGNORED;
+    hpcu.ecu_event.type = FSM_EVENT_TYPE_IGNORED;
 
     // Reset all gpios
     pcu_reset_all();
@@ -93,15 +95,18 @@ void pcu_reset_all(void) {
     hpcu.set(PCU_PIN_AMS, PCU_PIN_STATUS_HIGH);
 
     hpcu.timeout_event.type = FSM_EVENT_TYPE_IGNORED;
+    hpcu.ts_off_requested = false;
     _pcu_init_watchdogs();
 }
 
 void pcu_airn_open(void) {
     watchdog_stop(&hpcu.airn_watchdog);
     hpcu.set(PCU_PIN_AIR_NEGATIVE, PCU_PIN_STATUS_HIGH);
+    feedback_notify_contactor_command(FEEDBACK_CONTACTOR_AIRN, false);
 }
 void pcu_airn_close(void) {
     hpcu.set(PCU_PIN_AIR_NEGATIVE, PCU_PIN_STATUS_LOW);
+    feedback_notify_contactor_command(FEEDBACK_CONTACTOR_AIRN, true);
     watchdog_start(&hpcu.airn_watchdog);
 }
 void pcu_airn_stop_watchdog(void) {
@@ -111,9 +116,11 @@ void pcu_airn_stop_watchdog(void) {
 void pcu_airp_open(void) {
     watchdog_stop(&hpcu.airp_watchdog);
     hpcu.set(PCU_PIN_AIR_POSITIVE, PCU_PIN_STATUS_HIGH);
+    feedback_notify_contactor_command(FEEDBACK_CONTACTOR_AIRP, false);
 }
 void pcu_airp_close(void) {
     hpcu.set(PCU_PIN_AIR_POSITIVE, PCU_PIN_STATUS_LOW);
+    feedback_notify_contactor_command(FEEDBACK_CONTACTOR_AIRP, true);
     watchdog_start(&hpcu.airp_watchdog);
 }
 void pcu_airp_stop_watchdog(void) {
@@ -124,9 +131,11 @@ void pcu_airp_stop_watchdog(void) {
 void pcu_precharge_start(void) {
     watchdog_start(&hpcu.precharge_watchdog);
     hpcu.set(PCU_PIN_PRECHARGE, PCU_PIN_STATUS_LOW);
+    feedback_notify_contactor_command(FEEDBACK_CONTACTOR_PRECHARGE, true);
 }
 void pcu_precharge_stop(void) {
     hpcu.set(PCU_PIN_PRECHARGE, PCU_PIN_STATUS_HIGH);
+    feedback_notify_contactor_command(FEEDBACK_CONTACTOR_PRECHARGE, false);
     watchdog_stop(&hpcu.precharge_watchdog);
 }
 void pcu_precharge_stop_watchdog(void) {
@@ -150,14 +159,25 @@ bool pcu_is_precharge_complete(void) {
     return pcu_get_precharge_percentage() >= PCU_PRECHARGE_THRESHOLD_PERCENT;
 }
 
+bool pcu_is_ts_off_requested(void) {
+    return hpcu.ts_off_requested;
+}
+
 // TODO: Add watchdog for the set state canlib message
 void pcu_set_state_from_ecu_handle(primary_hv_set_status_ecu_converted_t * const payload) {
     if (payload == NULL)
         return;
-    hpcu.event.type = payload->status ?
+    // Open the contactors immediately, the FSM completes the procedure afterwards
+    if (!payload->status) {
+        pcu_airp_open();
+        pcu_precharge_stop();
+        pcu_airn_open();
+        hpcu.ts_off_requested = true;
+    }
+    hpcu.ecu_event.type = payload->status ?
         FSM_EVENT_TYPE_TS_ON :
         FSM_EVENT_TYPE_TS_OFF;
-    fsm_event_trigger(&hpcu.event);
+    fsm_event_trigger(&hpcu.ecu_event);
 }
 
 void pcu_set_state_from_handcart_handle(primary_hv_set_status_handcart_converted_t * const payload) {
@@ -17,6 +17,15 @@
 #include "current.h"
 #include "internal-voltage.h"
 #include "bal.h"
+#include "tdma.h"
+#include "trend.h"
+#include "resistance.h"
+#include "soc.h"
+#include "sop.h"
+#include "storage.h"
+#include "soh.h"
+#include "event-log.h"
+#include "black-box.h"
 
 #ifdef CONF_POST_MODULE_ENABLE
 
@@ -35,7 +44,7 @@ PostReturnCode _post_modules_init(const PostInitData * const data) {
      * The error and identity initialization functions have to be executed
      * before every other function to ensure the proper functionality
      */
-    if (error_init() != ERROR_OK)
+    if (error_init(data->cs_enter, data->cs_exit, data->error_update_timer, data->error_stop_timer) != ERROR_OK)
         return POST_UNINITIALIZED;
     identity_init();
 
@@ -46,15 +55,31 @@ PostReturnCode _post_modules_init(const PostInitData * const data) {
     (void)timebase_init(1U);
     (void)pcu_init(data->pcu_set, data->pcu_toggle);
     (void)volt_init();
-    (void)current_init();
-    (void)can_comm_init(data->can_send);
+    (void)current_init(data->cs_enter, data->cs_exit);
+    (void)can_comm_init(data->can_send, data->cs_enter, data->cs_exit);
     (void)programmer_init(data->system_reset);
     (void)led_init(data->led_set, data->led_toggle);
     (void)imd_init(data->imd_start);
-    (void)feedback_init(data->feedback_read_all, data->feedback_start_conversion);
+    (void)feedback_init(
+        data->feedback_read_all,
+        data->feedback_start_conversion,
+        data->feedback_get_time_us,
+        data->cs_enter,
+        data->cs_exit
+    );
     (void)display_init(data->display_set, data->display_toggle);
     (void)internal_voltage_init(data->spi_send, data->spi_send_receive);
     (void)bal_init();
+    (void)tdma_init();
+    (void)trend_init();
+    (void)resistance_init();
+    (void)soc_init();
+    (void)storage_init(data->spi_send, data->spi_send_receive);
+    (void)event_log_init(data->cs_enter, data->cs_exit);
+    (void)event_log_push(EVENT_LOG_TYPE_RESET, 0U, 0U);
+    (void)black_box_init(data->get_cycles);
+    (void)soh_init();
+    (void)sop_init();
 
     return POST_OK;
 }
@@ -63,6 +88,7 @@ PostReturnCode _post_module_setup(void) {
     pcu_reset_all();
     timebase_set_enable(true);
     can_comm_enable_all();
+    (void)feedback_start_analog_conversion_all();
 
     // Wait for the current sensor to start its normal operation cycle
     milliseconds_t t = timebase_get_time();
@@ -76,6 +102,8 @@ PostReturnCode _post_module_setup(void) {
 
 PostReturnCode post_run(const PostInitData data) {
     if (data.system_reset == NULL ||
+        data.cs_enter == NULL ||
+        data.cs_exit == NULL ||
         data.can_send == NULL ||
         data.led_set == NULL ||
         data.led_toggle == NULL ||
@@ -84,10 +112,12 @@ PostReturnCode post_run(const PostInitData data) {
         data.pcu_toggle == NULL ||
         data.feedback_read_all == NULL ||
         data.feedback_start_conversion == NULL ||
+        data.feedback_get_time_us == NULL ||
         data.display_set == NULL ||
         data.display_toggle == NULL ||
         data.spi_send == NULL ||
-        data.spi_send_receive == NULL)
+        data.spi_send_receive == NULL ||
+        data.get_cycles == NULL)
         return POST_NULL_POINTER;
 
     // Module initialization
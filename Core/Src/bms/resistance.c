@@ -0,0 +1,177 @@
+/**
+ * @file resistance.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Online estimation of the internal resistance and open circuit voltage of the cells
+ */
+
+#include "resistance.h"
+
+#include <string.h>
+
+#ifdef CONF_RESISTANCE_MODULE_ENABLE
+
+_STATIC _ResistanceHandler hresistance;
+
+/**
+ * @brief Reset the estimator of a cell to its initial state
+ *
+ * @param cell A pointer to the estimator
+ */
+_STATIC_INLINE void _resistance_reset_cell(ResistanceEstimator * const cell) {
+    cell->ocv = 0.f;
+    cell->resistance = RESISTANCE_INITIAL_OHM;
+    cell->p00 = RESISTANCE_INITIAL_OCV_VARIANCE;
+    cell->p01 = 0.f;
+    cell->p11 = RESISTANCE_INITIAL_RESISTANCE_VARIANCE;
+    cell->count = 0U;
+}
+
+ResistanceReturnCode resistance_init(void) {
+    memset(&hresistance, 0U, sizeof(hresistance));
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id)
+        for (size_t i = 0U; i < CELLBOARD_SEGMENT_SERIES_COUNT; ++i)
+            _resistance_reset_cell(&hresistance.cells[id][i]);
+    return RESISTANCE_OK;
+}
+
+ResistanceReturnCode resistance_update(
+    const CellboardId id,
+    const size_t offset,
+    const volt_t voltage,
+    const ampere_t current)
+{
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT)
+        return RESISTANCE_OUT_OF_BOUNDS;
+    ResistanceEstimator * const cell = &hresistance.cells[id][offset];
+
+    // Start from the voltage that the initial resistance would give
+    if (cell->count == 0U)
+        cell->ocv = voltage + cell->resistance * current;
+
+    /*
+     * The regressor is phi = [1, -I] so that V = phi' * [OCV, R]
+     * and the covariance matrix P is symmetric
+     */
+    const float phi = -current;
+    const float pphi0 = cell->p00 + cell->p01 * phi;
+    const float pphi1 = cell->p01 + cell->p11 * phi;
+    const float den = RESISTANCE_FORGETTING_FACTOR + pphi0 + pphi1 * phi;
+    const float k0 = pphi0 / den;
+    const float k1 = pphi1 / den;
+
+    // Correct the parameters with the prediction error
+    const float err = voltage - (cell->ocv + cell->resistance * phi);
+    cell->ocv += k0 * err;
+    cell->resistance += k1 * err;
+
+    // Update the covariance, the forgetting is disabled if the matrix grows too much
+    const float lambda = (cell->p00 + cell->p11 > RESISTANCE_COVARIANCE_TRACE_MAX) ? 1.f : RESISTANCE_FORGETTING_FACTOR;
+    cell->p00 = (cell->p00 - k0 * pphi0) / lambda;
+    cell->p01 = (cell->p01 - k0 * pphi1) / lambda;
+    cell->p11 = (cell->p11 - k1 * pphi1) / lambda;
+
+    if (cell->count < UINT16_MAX)
+        ++cell->count;
+    return RESISTANCE_OK;
+}
+
+ResistanceReturnCode resistance_get_resistance(const CellboardId id, const size_t offset, float * const out) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT || out == NULL)
+        return RESISTANCE_OUT_OF_BOUNDS;
+    const ResistanceEstimator * const cell = &hresistance.cells[id][offset];
+    if (cell->count < RESISTANCE_MIN_UPDATE_COUNT)
+        return RESISTANCE_NOT_READY;
+    *out = cell->resistance;
+    return RESISTANCE_OK;
+}
+
+ResistanceReturnCode resistance_get_ocv(const CellboardId id, const size_t offset, volt_t * const out) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT || out == NULL)
+        return RESISTANCE_OUT_OF_BOUNDS;
+    const ResistanceEstimator * const cell = &hresistance.cells[id][offset];
+    if (cell->count < RESISTANCE_MIN_UPDATE_COUNT)
+        return RESISTANCE_NOT_READY;
+    *out = cell->ocv;
+    return RESISTANCE_OK;
+}
+
+size_t resistance_get_worst(const size_t k, size_t * const out) {
+    if (out == NULL)
+        return 0U;
+    const size_t max = MAINBOARD_MIN(k, CELLBOARD_SERIES_COUNT);
+    const ResistanceEstimator * const cells = &hresistance.cells[0U][0U];
+
+    // Insertion into a sorted array which is faster than a full sort for small k
+    size_t count = 0U;
+    for (size_t i = 0U; i < CELLBOARD_SERIES_COUNT; ++i) {
+        if (cells[i].count < RESISTANCE_MIN_UPDATE_COUNT)
+            continue;
+        size_t j = count;
+        while (j > 0U && cells[out[j - 1U]].resistance < cells[i].resistance) {
+            if (j < max)
+                out[j] = out[j - 1U];
+            --j;
+        }
+        if (j < max) {
+            out[j] = i;
+            count = MAINBOARD_MIN(count + 1U, max);
+        }
+    }
+    return count;
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+primary_hv_cells_resistance_converted_t * resistance_get_cells_resistance_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(hresistance.resistance_can_payload);
+
+    // Update the ranking only after every cell has been sent
+    if (hresistance.worst_offset == 0U)
+        hresistance.worst_count = resistance_get_worst(RESISTANCE_WORST_COUNT, hresistance.worst);
+
+    hresistance.resistance_can_payload.rank = hresistance.worst_offset;
+    if (hresistance.worst_count == 0U) {
+        hresistance.resistance_can_payload.cellboard_id = 0U;
+        hresistance.resistance_can_payload.offset = 0U;
+        hresistance.resistance_can_payload.resistance = 0.f;
+        hresistance.resistance_can_payload.ocv = 0.f;
+        return &hresistance.resistance_can_payload;
+    }
+
+    const size_t index = hresistance.worst[hresistance.worst_offset];
+    const ResistanceEstimator * const cell = &hresistance.cells[0U][0U] + index;
+    hresistance.resistance_can_payload.cellboard_id = (primary_hv_cells_resistance_cellboard_id)(index / CELLBOARD_SEGMENT_SERIES_COUNT);
+    hresistance.resistance_can_payload.offset = index % CELLBOARD_SEGMENT_SERIES_COUNT;
+    // The resistance is sent in mOhm
+    hresistance.resistance_can_payload.resistance = cell->resistance * 1000.f;
+    hresistance.resistance_can_payload.ocv = cell->ocv;
+
+    if (++hresistance.worst_offset >= hresistance.worst_count)
+        hresistance.worst_offset = 0U;
+    return &hresistance.resistance_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#ifdef CONF_RESISTANCE_STRINGS_ENABLE
+
+_STATIC char * resistance_module_name = "resistance";
+
+_STATIC char * resistance_return_code_name[] = {
+    [RESISTANCE_OK] = "ok",
+    [RESISTANCE_OUT_OF_BOUNDS] = "out of bounds",
+    [RESISTANCE_NOT_READY] = "not ready"
+};
+
+_STATIC char * resistance_return_code_description[] = {
+    [RESISTANCE_OK] = "executed successfully",
+    [RESISTANCE_OUT_OF_BOUNDS] = "attempt to access an invalid memory region",
+    [RESISTANCE_NOT_READY] = "the estimation has not converged yet"
+};
+
+#endif // CONF_RESISTANCE_STRINGS_ENABLE
+
+#endif // CONF_RESISTANCE_MODULE_ENABLE
@@ -0,0 +1,263 @@
+/**
+ * @file soc.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief State of charge estimation of the pack and of each segment
+ */
+
+#include "soc.h"
+
+#include <string.h>
+#include <math.h>
+
+#include "timebase.h"
+#include "volt.h"
+#include "current.h"
+
+#ifdef CONF_SOC_MODULE_ENABLE
+
+/**
+ * @brief Open circuit voltage of a cell in V for equally spaced values of the state of charge
+ *
+ * @details The first value corresponds to 0% and the last one to 100%
+ */
+_STATIC const float soc_ocv_table[] = {
+    3.00f, 3.45f, 3.55f, 3.62f, 3.68f, 3.75f, 3.84f, 3.93f, 4.02f, 4.10f, 4.20f
+};
+#define SOC_OCV_TABLE_SIZE (sizeof(soc_ocv_table) / sizeof(soc_ocv_table[0U]))
+#define SOC_OCV_TABLE_STEP (1.f / (SOC_OCV_TABLE_SIZE - 1U))
+
+_STATIC _SocHandler hsoc;
+
+/**
+ * @brief Get the open circuit voltage and its derivative for a given state of charge
+ *
+ * @details The table is equally spaced so the lookup takes constant time
+ *
+ * @param soc The state of charge in the range [0, 1]
+ * @param slope[out] A pointer where the derivative of the voltage in V is stored
+ *
+ * @return volt_t The open circuit voltage in V
+ */
+_STATIC_INLINE volt_t _soc_ocv(const float soc, float * const slope) {
+    const float pos = MAINBOARD_CLAMP(soc, 0.f, 1.f) * (SOC_OCV_TABLE_SIZE - 1U);
+    const size_t i = MAINBOARD_MIN((size_t)pos, SOC_OCV_TABLE_SIZE - 2U);
+    const float dv = soc_ocv_table[i + 1U] - soc_ocv_table[i];
+    *slope = dv / SOC_OCV_TABLE_STEP;
+    return soc_ocv_table[i] + dv * (pos - i);
+}
+
+/**
+ * @brief Get the state of charge from the open circuit voltage
+ *
+ * @param voltage The open circuit voltage in V
+ *
+ * @return float The state of charge in the range [0, 1]
+ */
+_STATIC_INLINE float _soc_from_ocv(const volt_t voltage) {
+    if (voltage <= soc_ocv_table[0U])
+        return 0.f;
+    for (size_t i = 1U; i < SOC_OCV_TABLE_SIZE; ++i) {
+        if (voltage < soc_ocv_table[i]) {
+            const float k = (voltage - soc_ocv_table[i - 1U]) / (soc_ocv_table[i] - soc_ocv_table[i - 1U]);
+            return (i - 1U + k) * SOC_OCV_TABLE_STEP;
+        }
+    }
+    return 1.f;
+}
+
+/**
+ * @brief Get the average cell voltage of a segment
+ *
+ * @param id The cellboard identifier
+ *
+ * @return volt_t The average voltage in V
+ */
+_STATIC_INLINE volt_t _soc_segment_voltage(const CellboardId id) {
+    const VoltAggregate * const aggregate = volt_get_segment_aggregate(id);
+    return (aggregate != NULL) ? aggregate->sum / CELLBOARD_SEGMENT_SERIES_COUNT : 0.f;
+}
+
+SocReturnCode soc_init(void) {
+    memset(&hsoc, 0U, sizeof(hsoc));
+    return SOC_OK;
+}
+
+void soc_integrate_current(const ampere_t current, const ticks_t timestamp) {
+    // Rectangular integration using the previous value which was valid until now
+    if (hsoc.last_current_time != 0U)
+        hsoc.charge += (uint32_t)((int64_t)hsoc.last_current * (timestamp - hsoc.last_current_time));
+    hsoc.last_current = (int32_t)(current * 1000.f);
+    hsoc.last_current_time = timestamp;
+}
+
+void soc_update(void) {
+    const ticks_t now = timebase_get_tick();
+
+    if (!hsoc.initialized) {
+        // Wait for a complete set of voltages
+        if (volt_get_sweep_count() == 0U)
+            return;
+        for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
+            hsoc.segments[id].soc = _soc_from_ocv(_soc_segment_voltage(id));
+            hsoc.segments[id].variance = SOC_INITIAL_VARIANCE;
+        }
+        hsoc.initialized = true;
+        hsoc.last_charge = hsoc.charge;
+        hsoc.rest_start = now;
+        hsoc.snapshot_time = now;
+        memcpy(hsoc.snapshot.segments, hsoc.segments, sizeof(hsoc.snapshot.segments));
+        return;
+    }
+
+    // Charge exchanged since the last update in As
+    const uint32_t charge = hsoc.charge;
+    const int32_t delta = (int32_t)(charge - hsoc.last_charge);
+    hsoc.last_charge = charge;
+    // The difference is converted before the product to keep its sign
+    const float dq = (float)delta * timebase_get_resolution() * 1e-6f;
+
+    // The voltage is trusted only after the cells have relaxed
+    const ampere_t current = current_get_current();
+    if (fabsf(current) > SOC_REST_CURRENT_A)
+        hsoc.rest_start = now;
+    hsoc.resting = (now - hsoc.rest_start) >= TIMEBASE_TIME_TO_TICKS(SOC_REST_TIME_MS, timebase_get_resolution());
+    const float noise = hsoc.resting ? SOC_MEASUREMENT_NOISE_REST : SOC_MEASUREMENT_NOISE_LOAD;
+
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
+        SocEstimator * const segment = &hsoc.segments[id];
+
+        // Prediction
+        segment->soc -= dq / SOC_CAPACITY_AS;
+        segment->variance += SOC_PROCESS_NOISE;
+
+        // Correction with the linearized voltage model V = OCV(soc) - R * I
+        float h;
+        const volt_t ocv = _soc_ocv(segment->soc, &h);
+        const float err = _soc_segment_voltage(id) - (ocv - SOC_GROUP_RESISTANCE_OHM * current);
+        const float k = segment->variance * h / (h * segment->variance * h + noise);
+        segment->soc = MAINBOARD_CLAMP(segment->soc + k * err, 0.f, 1.f);
+        segment->variance *= (1.f - k * h);
+    }
+
+    // Update the snapshot
+    if (now - hsoc.snapshot_time >= TIMEBASE_TIME_TO_TICKS(SOC_STORE_INTERVAL_MS, timebase_get_resolution())) {
+        hsoc.snapshot_time = now;
+        memcpy(hsoc.snapshot.segments, hsoc.segments, sizeof(hsoc.snapshot.segments));
+    }
+}
+
+float soc_get_soc(void) {
+    float sum = 0.f;
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id)
+        sum += hsoc.segments[id].soc;
+    return sum / CELLBOARD_COUNT;
+}
+
+float soc_get_min_segment_soc(void) {
+    float min = hsoc.segments[0U].soc;
+    for (CellboardId id = CELLBOARD_ID_1; id < CELLBOARD_ID_COUNT; ++id)
+        min = MAINBOARD_MIN(min, hsoc.segments[id].soc);
+    return min;
+}
+
+float soc_get_max_segment_soc(void) {
+    float max = hsoc.segments[0U].soc;
+    for (CellboardId id = CELLBOARD_ID_1; id < CELLBOARD_ID_COUNT; ++id)
+        max = MAINBOARD_MAX(max, hsoc.segments[id].soc);
+    return max;
+}
+
+uint32_t soc_get_charge(void) {
+    return hsoc.charge;
+}
+
+bool soc_is_resting(void) {
+    return hsoc.resting;
+}
+
+float soc_get_ocv_soc(void) {
+    return _soc_from_ocv(volt_get_avg());
+}
+
+SocReturnCode soc_get_segment_soc(const CellboardId id, float * const out) {
+    if (out == NULL)
+        return SOC_NULL_POINTER;
+    if (id >= CELLBOARD_ID_COUNT)
+        return SOC_OUT_OF_BOUNDS;
+    if (!hsoc.initialized)
+        return SOC_NOT_READY;
+    *out = hsoc.segments[id].soc;
+    return SOC_OK;
+}
+
+const SocSnapshot * soc_get_snapshot(void) {
+    return &hsoc.snapshot;
+}
+
+SocReturnCode soc_restore(const SocSnapshot * const snapshot) {
+    if (snapshot == NULL)
+        return SOC_NULL_POINTER;
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
+        const SocEstimator * const segment = &snapshot->segments[id];
+        if (!(segment->soc >= 0.f && segment->soc <= 1.f && segment->variance > 0.f))
+            return SOC_OUT_OF_BOUNDS;
+    }
+    memcpy(hsoc.segments, snapshot->segments, sizeof(hsoc.segments));
+    memcpy(&hsoc.snapshot, snapshot, sizeof(hsoc.snapshot));
+    hsoc.initialized = true;
+    hsoc.last_charge = hsoc.charge;
+    hsoc.rest_start = timebase_get_tick();
+    hsoc.snapshot_time = hsoc.rest_start;
+    return SOC_OK;
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+primary_hv_soc_estimation_converted_t * soc_get_soc_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(hsoc.soc_can_payload);
+    hsoc.soc_can_payload.soc = soc_get_soc();
+    hsoc.soc_can_payload.soc_min = soc_get_min_segment_soc();
+    hsoc.soc_can_payload.soc_max = soc_get_max_segment_soc();
+    return &hsoc.soc_can_payload;
+}
+
+primary_hv_segment_soc_converted_t * soc_get_segment_soc_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(hsoc.segment_soc_can_payload);
+    const SocEstimator * const segment = &hsoc.segments[hsoc.cellboard_id];
+    hsoc.segment_soc_can_payload.cellboard_id = (primary_hv_segment_soc_cellboard_id)hsoc.cellboard_id;
+    hsoc.segment_soc_can_payload.soc = segment->soc;
+    hsoc.segment_soc_can_payload.soc_std = sqrtf(segment->variance);
+
+    // Update index
+    if (++hsoc.cellboard_id >= CELLBOARD_ID_COUNT)
+        hsoc.cellboard_id = CELLBOARD_ID_0;
+    return &hsoc.segment_soc_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#ifdef CONF_SOC_STRINGS_ENABLE
+
+_STATIC char * soc_module_name = "soc";
+
+_STATIC char * soc_return_code_name[] = {
+    [SOC_OK] = "ok",
+    [SOC_NULL_POINTER] = "null pointer",
+    [SOC_OUT_OF_BOUNDS] = "out of bounds",
+    [SOC_NOT_READY] = "not ready"
+};
+
+_STATIC char * soc_return_code_description[] = {
+    [SOC_OK] = "executed successfully",
+    [SOC_NULL_POINTER] = "attempt to dereference a null pointer",
+    [SOC_OUT_OF_BOUNDS] = "attempt to access an invalid memory region",
+    [SOC_NOT_READY] = "the estimation has not been initialized yet"
+};
+
+#endif // CONF_SOC_STRINGS_ENABLE
+
+#endif // CONF_SOC_MODULE_ENABLE
@@ -0,0 +1,212 @@
+/**
+ * @file soh.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief State of health tracking of the pack
+ */
+
+#include "soh.h"
+
+#include <string.h>
+#include <math.h>
+
+#include "timebase.h"
+#include "volt.h"
+#include "current.h"
+#include "storage.h"
+
+#ifdef CONF_SOH_MODULE_ENABLE
+
+_STATIC _SohHandler hsoh;
+
+/**
+ * @brief Add a cycle to the depth of discharge histogram
+ *
+ * @param range The depth of discharge of the cycle in the range [0, 1]
+ * @param half_cycles The number of half cycles to add
+ */
+_STATIC_INLINE void _soh_count_cycle(const float range, const uint16_t half_cycles) {
+    const size_t bin = MAINBOARD_MIN((size_t)(range * SOH_DOD_BIN_COUNT), SOH_DOD_BIN_COUNT - 1U);
+    if (hsoh.state.dod_histogram[bin] <= UINT16_MAX - half_cycles)
+        hsoh.state.dod_histogram[bin] += half_cycles;
+}
+
+/**
+ * @brief Add a reversal point to the rainflow stack and count the closed cycles
+ *
+ * @details The three point streaming algorithm is used: a range is counted as
+ * a full cycle when it is enclosed by the following one or as a half cycle
+ * when it contains the starting point of the history
+ *
+ * @param soc The state of charge of the reversal point
+ */
+_STATIC void _soh_rainflow_push(const float soc) {
+    // Count the oldest point as a half cycle if the stack is full
+    if (hsoh.reversal_count >= SOH_RAINFLOW_STACK_SIZE) {
+        _soh_count_cycle(fabsf(hsoh.reversals[1U] - hsoh.reversals[0U]), 1U);
+        memmove(hsoh.reversals, &hsoh.reversals[1U], (SOH_RAINFLOW_STACK_SIZE - 1U) * sizeof(hsoh.reversals[0U]));
+        --hsoh.reversal_count;
+    }
+    hsoh.reversals[hsoh.reversal_count++] = soc;
+
+    while (hsoh.reversal_count >= 3U) {
+        float * const top = &hsoh.reversals[hsoh.reversal_count - 1U];
+        const float x = fabsf(top[0] - top[-1]);
+        const float y = fabsf(top[-1] - top[-2]);
+        if (x < y)
+            break;
+        if (hsoh.reversal_count == 3U) {
+            // The range contains the starting point
+            _soh_count_cycle(y, 1U);
+            hsoh.reversals[0U] = hsoh.reversals[1U];
+            hsoh.reversals[1U] = hsoh.reversals[2U];
+            hsoh.reversal_count = 2U;
+        }
+        else {
+            _soh_count_cycle(y, 2U);
+            top[-2] = top[0];
+            hsoh.reversal_count -= 2U;
+        }
+    }
+}
+
+/**
+ * @brief Detect the reversal points of the state of charge
+ *
+ * @param soc The current state of charge
+ */
+_STATIC_INLINE void _soh_rainflow_update(const float soc) {
+    if (hsoh.direction == 0) {
+        if (fabsf(soc - hsoh.extreme) >= SOH_RAINFLOW_HYSTERESIS) {
+            _soh_rainflow_push(hsoh.extreme);
+            hsoh.direction = (soc > hsoh.extreme) ? 1 : -1;
+            hsoh.extreme = soc;
+        }
+        return;
+    }
+
+    // Follow the extreme or detect a reversal
+    const float diff = (soc - hsoh.extreme) * hsoh.direction;
+    if (diff > 0.f)
+        hsoh.extreme = soc;
+    else if (diff <= -SOH_RAINFLOW_HYSTERESIS) {
+        _soh_rainflow_push(hsoh.extreme);
+        hsoh.direction = -hsoh.direction;
+        hsoh.extreme = soc;
+    }
+}
+
+/**
+ * @brief Update the capacity estimation when the pack reaches a new rest point
+ */
+_STATIC_INLINE void _soh_capacity_update(void) {
+    const bool resting = soc_is_resting();
+    const bool rest_start = resting && !hsoh.last_resting;
+    hsoh.last_resting = resting;
+    if (!rest_start)
+        return;
+
+    const float soc = soc_get_ocv_soc();
+    const int64_t charge = (int64_t)(hsoh.state.charge_out - hsoh.state.charge_in);
+    if (hsoh.state.rest_valid) {
+        const float delta_soc = fabsf(soc - hsoh.state.rest_soc);
+        if (delta_soc >= SOH_CAPACITY_MIN_DELTA_SOC) {
+            const float measured = fabsf((float)(charge - hsoh.state.rest_charge)) * 1e-6f / delta_soc;
+            hsoh.state.capacity += SOH_CAPACITY_GAIN * (measured - hsoh.state.capacity);
+        }
+    }
+    hsoh.state.rest_soc = soc;
+    hsoh.state.rest_charge = charge;
+    hsoh.state.rest_valid = true;
+}
+
+SohReturnCode soh_init(void) {
+    memset(&hsoh, 0U, sizeof(hsoh));
+    hsoh.last_charge = soc_get_charge();
+    hsoh.save_time = timebase_get_tick();
+
+    if (storage_load(STORAGE_REGION_SOH, &hsoh.state, sizeof(hsoh.state)) != STORAGE_OK ||
+        !(hsoh.state.capacity > 0.f && hsoh.state.capacity <= SOC_CAPACITY_AS * 2.f)) {
+        memset(&hsoh.state, 0U, sizeof(hsoh.state));
+        hsoh.state.capacity = SOC_CAPACITY_AS;
+        return SOH_NOT_RESTORED;
+    }
+    (void)soc_restore(&hsoh.state.soc);
+    return SOH_OK;
+}
+
+void soh_update(void) {
+    // Charge exchanged since the last update in uAs
+    const uint32_t charge = soc_get_charge();
+    const int32_t delta = (int32_t)(charge - hsoh.last_charge);
+    hsoh.last_charge = charge;
+    const uint64_t dq = (uint64_t)(delta >= 0 ? delta : -(int64_t)delta) * timebase_get_resolution();
+
+    // Energy exchanged in mJ
+    const uint64_t energy = (uint64_t)(dq * volt_get_sum() * 1e-3f);
+    if (delta >= 0) {
+        hsoh.state.charge_out += dq;
+        hsoh.state.energy_out += energy;
+    }
+    else {
+        hsoh.state.charge_in += dq;
+        hsoh.state.energy_in += energy;
+    }
+
+    // Wait for the state of charge estimation before counting the cycles
+    float segment_soc;
+    if (soc_get_segment_soc(CELLBOARD_ID_0, &segment_soc) == SOC_OK) {
+        const float soc = soc_get_soc();
+        if (!hsoh.started) {
+            hsoh.extreme = soc;
+            hsoh.started = true;
+        }
+        _soh_rainflow_update(soc);
+        _soh_capacity_update();
+    }
+
+    // Save the state
+    const ticks_t now = timebase_get_tick();
+    if (now - hsoh.save_time >= TIMEBASE_TIME_TO_TICKS(SOH_SAVE_INTERVAL_MS, timebase_get_resolution())) {
+        const SocSnapshot * const snapshot = soc_get_snapshot();
+        if (snapshot != NULL)
+            memcpy(&hsoh.state.soc, snapshot, sizeof(hsoh.state.soc));
+        if (storage_save(STORAGE_REGION_SOH, &hsoh.state, sizeof(hsoh.state)) == STORAGE_OK)
+            hsoh.save_time = now;
+    }
+}
+
+float soh_get_soh(void) {
+    return hsoh.state.capacity / SOC_CAPACITY_AS;
+}
+
+float soh_get_capacity(void) {
+    return hsoh.state.capacity;
+}
+
+float soh_get_equivalent_cycles(void) {
+    return hsoh.state.charge_out * 1e-6f / SOC_CAPACITY_AS;
+}
+
+const SohState * soh_get_state(void) {
+    return &hsoh.state;
+}
+
+#ifdef CONF_SOH_STRINGS_ENABLE
+
+_STATIC char * soh_module_name = "soh";
+
+_STATIC char * soh_return_code_name[] = {
+    [SOH_OK] = "ok",
+    [SOH_NOT_RESTORED] = "not restored"
+};
+
+_STATIC char * soh_return_code_description[] = {
+    [SOH_OK] = "executed successfully",
+    [SOH_NOT_RESTORED] = "no valid saved state has been found"
+};
+
+#endif // CONF_SOH_STRINGS_ENABLE
+
+#endif // CONF_SOH_MODULE_ENABLE
@@ -0,0 +1,157 @@
+/**
+ * @file sop.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief State of power estimation, i.e. the maximum current and power that
+ * can be drawn from or supplied to the pack for a given amount of time
+ */
+
+#include "sop.h"
+
+#include <string.h>
+
+#include "volt.h"
+#include "temp.h"
+#include "current.h"
+#include "resistance.h"
+#include "soc.h"
+
+#ifdef CONF_SOP_MODULE_ENABLE
+
+/** @brief Duration in s and resistance factor of each horizon */
+_STATIC const float sop_horizon_time[] = {
+    [SOP_HORIZON_2S] = 2.f,
+    [SOP_HORIZON_10S] = 10.f
+};
+_STATIC const float sop_resistance_factor[] = {
+    [SOP_HORIZON_2S] = SOP_RESISTANCE_FACTOR_2S,
+    [SOP_HORIZON_10S] = SOP_RESISTANCE_FACTOR_10S
+};
+
+_STATIC _SopHandler hsop;
+
+/**
+ * @brief Get the internal resistance used to calculate the limits
+ *
+ * @details The highest estimated resistance is used since the weakest cell
+ * is the first one to reach the voltage limits
+ *
+ * @return float The resistance in Ohm
+ */
+_STATIC_INLINE float _sop_get_resistance(void) {
+    size_t index;
+    float resistance = RESISTANCE_INITIAL_OHM;
+    if (resistance_get_worst(1U, &index) == 1U)
+        (void)resistance_get_resistance(
+            (CellboardId)(index / CELLBOARD_SEGMENT_SERIES_COUNT),
+            index % CELLBOARD_SEGMENT_SERIES_COUNT,
+            &resistance
+        );
+    return resistance;
+}
+
+/**
+ * @brief Get the derating factor for a given temperature
+ *
+ * @details The factor goes linearly from 1 at the start temperature to 0 at the end one
+ *
+ * @param temperature The temperature in °C
+ * @param start The temperature where the derating starts in °C
+ * @param end The temperature where the limit reaches zero in °C
+ *
+ * @return float The derating factor in the range [0, 1]
+ */
+_STATIC_INLINE float _sop_derating(const celsius_t temperature, const celsius_t start, const celsius_t end) {
+    return MAINBOARD_CLAMP(1.f - (temperature - start) / (end - start), 0.f, 1.f);
+}
+
+SopReturnCode sop_init(void) {
+    memset(&hsop, 0U, sizeof(hsop));
+    return SOP_OK;
+}
+
+void sop_update(void) {
+    const ampere_t current = current_get_current();
+    const float resistance = _sop_get_resistance();
+
+    // Remove the voltage drop caused by the current flowing right now
+    const volt_t ocv_min = volt_get_min() + resistance * current;
+    const volt_t ocv_max = volt_get_max() + resistance * current;
+    const volt_t ocv_pack = volt_get_sum() + resistance * CELLBOARD_SERIES_COUNT * current;
+
+    const float discharge_derating = _sop_derating(temp_get_max(), SOP_DISCHARGE_DERATING_HIGH_C, TEMP_MAX_C);
+    const float charge_derating = MAINBOARD_MIN(
+        _sop_derating(temp_get_max(), SOP_CHARGE_DERATING_HIGH_C, TEMP_MAX_C),
+        _sop_derating(temp_get_min(), SOP_CHARGE_DERATING_LOW_C, 0.f)
+    );
+    // The series segments carry the same current so the extreme ones limit the pack
+    const float soc_min = soc_get_min_segment_soc();
+    const float soc_max = soc_get_max_segment_soc();
+
+    for (SopHorizon horizon = SOP_HORIZON_2S; horizon < SOP_HORIZON_COUNT; ++horizon) {
+        SopLimits * const limits = &hsop.limits[horizon];
+        const float r = resistance * sop_resistance_factor[horizon];
+        const float t = sop_horizon_time[horizon];
+
+        // Discharge
+        ampere_t i = (ocv_min - (VOLT_MIN_V + SOP_VOLTAGE_MARGIN_V)) / r;
+        i = MAINBOARD_MIN(i, CURRENT_MAX_A * SOP_LIMIT_MARGIN) * discharge_derating;
+        i = MAINBOARD_CLAMP(i, 0.f, soc_min * SOC_CAPACITY_AS / t);
+        limits->discharge_current = i;
+        limits->discharge_power = MAINBOARD_CLAMP(
+            i * (ocv_pack - r * CELLBOARD_SERIES_COUNT * i) * 0.001f,
+            0.f,
+            CURRENT_MAX_POWER_KW * SOP_LIMIT_MARGIN
+        );
+
+        // Charge
+        i = ((VOLT_MAX_V - SOP_VOLTAGE_MARGIN_V) - ocv_max) / r;
+        i = MAINBOARD_MIN(i, -CURRENT_MIN_A * SOP_LIMIT_MARGIN) * charge_derating;
+        i = MAINBOARD_CLAMP(i, 0.f, (1.f - soc_max) * SOC_CAPACITY_AS / t);
+        limits->charge_current = i;
+        limits->charge_power = i * (ocv_pack + r * CELLBOARD_SERIES_COUNT * i) * 0.001f;
+    }
+}
+
+const SopLimits * sop_get_limits(const SopHorizon horizon) {
+    if (horizon >= SOP_HORIZON_COUNT)
+        return NULL;
+    return &hsop.limits[horizon];
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+primary_hv_power_limits_converted_t * sop_get_power_limits_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(hsop.power_limits_can_payload);
+    const SopLimits * const limits = &hsop.limits[hsop.horizon];
+    hsop.power_limits_can_payload.horizon = (primary_hv_power_limits_horizon)hsop.horizon;
+    hsop.power_limits_can_payload.discharge_current = limits->discharge_current;
+    hsop.power_limits_can_payload.charge_current = limits->charge_current;
+    hsop.power_limits_can_payload.discharge_power = limits->discharge_power;
+    hsop.power_limits_can_payload.charge_power = limits->charge_power;
+
+    // Update index
+    if (++hsop.horizon >= SOP_HORIZON_COUNT)
+        hsop.horizon = SOP_HORIZON_2S;
+    return &hsop.power_limits_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#ifdef CONF_SOP_STRINGS_ENABLE
+
+_STATIC char * sop_module_name = "sop";
+
+_STATIC char * sop_return_code_name[] = {
+    [SOP_OK] = "ok"
+};
+
+_STATIC char * sop_return_code_description[] = {
+    [SOP_OK] = "executed successfully"
+};
+
+#endif // CONF_SOP_STRINGS_ENABLE
+
+#endif // CONF_SOP_MODULE_ENABLE
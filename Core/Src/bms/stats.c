@@ -0,0 +1,113 @@
+/**
+ * @file stats.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Statistics functions shared by the measurement modules
+ */
+
+#include "stats.h"
+
+#include <math.h>
+
+#if defined(CONF_STATS_CMSIS_DSP_ENABLE) && defined(__arm__)
+#define STATS_CMSIS_DSP_BACKEND
+#include "arm_math.h"
+#endif  // CONF_STATS_CMSIS_DSP_ENABLE
+
+#ifdef STATS_CMSIS_DSP_BACKEND
+
+float stats_min_f32(const float * const data, const size_t count, size_t * const index) {
+    float32_t min;
+    uint32_t min_index;
+    arm_min_f32(data, count, &min, &min_index);
+    if (index != NULL)
+        *index = min_index;
+    return min;
+}
+
+float stats_max_f32(const float * const data, const size_t count, size_t * const index) {
+    float32_t max;
+    uint32_t max_index;
+    arm_max_f32(data, count, &max, &max_index);
+    if (index != NULL)
+        *index = max_index;
+    return max;
+}
+
+float stats_sum_f32(const float * const data, const size_t count) {
+    if (count == 0U)
+        return 0.f;
+    // The library does not provide a sum function for floating point values
+    return stats_mean_f32(data, count) * count;
+}
+
+float stats_mean_f32(const float * const data, const size_t count) {
+    float32_t mean;
+    arm_mean_f32(data, count, &mean);
+    return mean;
+}
+
+float stats_std_f32(const float * const data, const size_t count) {
+    if (count < 2U)
+        return 0.f;
+    float32_t std;
+    arm_std_f32(data, count, &std);
+    return std;
+}
+
+#else  // STATS_CMSIS_DSP_BACKEND
+
+float stats_min_f32(const float * const data, const size_t count, size_t * const index) {
+    float min = data[0U];
+    size_t min_index = 0U;
+    for (size_t i = 1U; i < count; ++i) {
+        if (data[i] < min) {
+            min = data[i];
+            min_index = i;
+        }
+    }
+    if (index != NULL)
+        *index = min_index;
+    return min;
+}
+
+float stats_max_f32(const float * const data, const size_t count, size_t * const index) {
+    float max = data[0U];
+    size_t max_index = 0U;
+    for (size_t i = 1U; i < count; ++i) {
+        if (data[i] > max) {
+            max = data[i];
+            max_index = i;
+        }
+    }
+    if (index != NULL)
+        *index = max_index;
+    return max;
+}
+
+float stats_sum_f32(const float * const data, const size_t count) {
+    float sum = 0.f;
+    for (size_t i = 0U; i < count; ++i)
+        sum += data[i];
+    return sum;
+}
+
+float stats_mean_f32(const float * const data, const size_t count) {
+    return stats_sum_f32(data, count) / count;
+}
+
+float stats_std_f32(const float * const data, const size_t count) {
+    if (count < 2U)
+        return 0.f;
+    // Two passes are used to avoid the cancellation of the sum of squares formula
+    const float mean = stats_mean_f32(data, count);
+    float sum = 0.f;
+    for (size_t i = 0U; i < count; ++i) {
+        const float diff = data[i] - mean;
+        sum += diff * diff;
+    }
+    return sqrtf(sum / (count - 1U));
+}
+
+#endif  // STATS_CMSIS_DSP_BACKEND
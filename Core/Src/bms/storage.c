@@ -0,0 +1,309 @@
+/**
+ * @file storage.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Persistent storage of data inside the external EEPROM
+ */
+
+#include "storage.h"
+
+#include <string.h>
+
+#ifdef CONF_STORAGE_MODULE_ENABLE
+
+/** @brief Initial value and polynomial of the CRC-16/CCITT */
+#define STORAGE_CRC_INIT (0xFFFFU)
+#define STORAGE_CRC_POLYNOMIAL (0x1021U)
+
+_STATIC const StorageRegionLayout storage_layout[] = {
+    [STORAGE_REGION_SOH] = { STORAGE_SOH_BASE_ADDRESS, STORAGE_SOH_SLOT_SIZE, STORAGE_SOH_SLOT_COUNT },
+    [STORAGE_REGION_EVENT_LOG] = { STORAGE_EVENT_LOG_BASE_ADDRESS, STORAGE_EVENT_LOG_SLOT_SIZE, STORAGE_EVENT_LOG_SLOT_COUNT },
+    [STORAGE_REGION_BLACK_BOX] = { STORAGE_BLACK_BOX_BASE_ADDRESS, STORAGE_BLACK_BOX_SLOT_SIZE, STORAGE_BLACK_BOX_SLOT_COUNT }
+};
+
+_STATIC _StorageHandler hstorage;
+
+/**
+ * @brief Update a CRC-16/CCITT with new data
+ *
+ * @param crc The current value of the CRC
+ * @param data A pointer to the data
+ * @param size The size of the data in bytes
+ *
+ * @return uint16_t The updated CRC
+ */
+_STATIC_INLINE uint16_t _storage_crc(uint16_t crc, const uint8_t * const data, const size_t size) {
+    for (size_t i = 0U; i < size; ++i) {
+        crc ^= (uint16_t)data[i] << 8U;
+        for (size_t bit = 0U; bit < 8U; ++bit)
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1U) ^ STORAGE_CRC_POLYNOMIAL) : (uint16_t)(crc << 1U);
+    }
+    return crc;
+}
+
+/**
+ * @brief Get the CRC of a record
+ *
+ * @param header A pointer to the header of the record
+ * @param data A pointer to the data of the record
+ *
+ * @return uint16_t The CRC of the record
+ */
+_STATIC_INLINE uint16_t _storage_record_crc(const StorageRecordHeader * const header, const uint8_t * const data) {
+    uint16_t crc = _storage_crc(STORAGE_CRC_INIT, (const uint8_t *)&header->sequence, sizeof(header->sequence));
+    crc = _storage_crc(crc, (const uint8_t *)&header->size, sizeof(header->size));
+    return _storage_crc(crc, data, header->size);
+}
+
+/**
+ * @brief Get the address of the slot that contains a record
+ *
+ * @details The first record is always written in the first slot
+ *
+ * @param region The region of the record
+ * @param sequence The sequence number of the record
+ *
+ * @return m95256_address_t The address of the first byte of the slot
+ */
+_STATIC_INLINE m95256_address_t _storage_slot_address(const StorageRegion region, const uint32_t sequence) {
+    const StorageRegionLayout * const layout = &storage_layout[region];
+    return layout->base + ((sequence - 1U) % layout->slot_count) * layout->slot_size;
+}
+
+/**
+ * @brief Read the sequence number of a slot waiting for the end of any write cycle
+ *
+ * @param region The region of the slot
+ * @param slot The index of the slot
+ * @param out[out] A pointer where the sequence number, or 0 if the slot is erased, is stored
+ *
+ * @return bool True if the slot was read, false if the EEPROM is still busy
+ */
+_STATIC_INLINE bool _storage_read_sequence(const StorageRegion region, const size_t slot, uint32_t * const out) {
+    const StorageRegionLayout * const layout = &storage_layout[region];
+    uint32_t sequence = 0U;
+    for (size_t i = 0U; i < STORAGE_BUSY_RETRY_COUNT; ++i) {
+        if (m95256_read(
+            &hstorage.eeprom,
+            layout->base + slot * layout->slot_size,
+            (uint8_t *)&sequence,
+            sizeof(sequence)) != M95256_BUSY)
+        {
+            *out = (sequence == UINT32_MAX) ? 0U : sequence;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Find the newest record of a region
+ *
+ * @details The slots from the first one up to the newest record contain increasing
+ * sequence numbers greater or equal than the first one while the following slots
+ * contain older or erased records, so the boundary is found with a binary search
+ *
+ * @param region The region to search
+ * @param out[out] A pointer where the sequence number of the newest record,
+ * or 0 if the region is empty, is stored
+ *
+ * @return bool True if the region was searched, false if the EEPROM is still busy
+ */
+_STATIC bool _storage_find_newest(const StorageRegion region, uint32_t * const out) {
+    uint32_t first = 0U;
+    *out = 0U;
+    if (!_storage_read_sequence(region, 0U, &first))
+        return false;
+    if (first == 0U)
+        return true;
+    size_t low = 0U;
+    size_t high = storage_layout[region].slot_count - 1U;
+    uint32_t newest = first;
+    while (low < high) {
+        const size_t mid = low + (high - low + 1U) / 2U;
+        uint32_t sequence = 0U;
+        if (!_storage_read_sequence(region, mid, &sequence))
+            return false;
+        if (sequence >= first) {
+            low = mid;
+            newest = sequence;
+        }
+        else
+            high = mid - 1U;
+    }
+    *out = newest;
+    return true;
+}
+
+/**
+ * @brief Write the next page of the pending record
+ *
+ * @return M95256ReturnCode The return code of the EEPROM driver
+ */
+_STATIC M95256ReturnCode _storage_write_page(void) {
+    // Write up to the end of the current page
+    const m95256_address_t address = hstorage.address + hstorage.offset;
+    const size_t size = MAINBOARD_MIN(
+        hstorage.size - hstorage.offset,
+        M95256_PAGE_SIZE - (address % M95256_PAGE_SIZE)
+    );
+    const M95256ReturnCode code = m95256_write_page(&hstorage.eeprom, address, &hstorage.buffer[hstorage.offset], size);
+    if (code != M95256_OK)
+        return code;
+    hstorage.offset += size;
+    if (hstorage.offset >= hstorage.size)
+        hstorage.pending = false;
+    return M95256_OK;
+}
+
+StorageReturnCode storage_init(const spi_send_callback_t send, const spi_send_receive_callback_t send_receive) {
+    if (send == NULL || send_receive == NULL)
+        return STORAGE_NULL_POINTER;
+    memset(&hstorage, 0U, sizeof(hstorage));
+    (void)m95256_init(&hstorage.eeprom, send, send_receive);
+
+    // A region that can not be searched is treated as empty
+    StorageReturnCode code = STORAGE_OK;
+    for (StorageRegion region = STORAGE_REGION_SOH; region < STORAGE_REGION_COUNT; ++region) {
+        if (!_storage_find_newest(region, &hstorage.sequence[region]))
+            code = STORAGE_BUSY;
+    }
+    return code;
+}
+
+StorageReturnCode storage_load(const StorageRegion region, void * const out, const size_t size) {
+    if (out == NULL)
+        return STORAGE_NULL_POINTER;
+    if (region >= STORAGE_REGION_COUNT || size + sizeof(StorageRecordHeader) > storage_layout[region].slot_size)
+        return STORAGE_OUT_OF_BOUNDS;
+
+    /*
+     * The record being written could be the newest one of the region and the
+     * routine is not executed while waiting, so the record is completed here
+     */
+    size_t retry = 0U;
+    while (hstorage.pending) {
+        const M95256ReturnCode code = _storage_write_page();
+        if (code == M95256_OK)
+            retry = 0U;
+        else if (code != M95256_BUSY || ++retry >= STORAGE_BUSY_RETRY_COUNT)
+            return STORAGE_BUSY;
+    }
+
+    // Try the records starting from the newest one
+    const size_t count = storage_get_count(region);
+    for (size_t i = 0U; i < count; ++i) {
+        StorageReturnCode code = STORAGE_BUSY;
+        for (size_t retry = 0U; code == STORAGE_BUSY && retry < STORAGE_BUSY_RETRY_COUNT; ++retry)
+            code = storage_read(region, hstorage.sequence[region] - i, out, size);
+        if (code == STORAGE_OK)
+            return STORAGE_OK;
+        // Give up on the whole region if the EEPROM does not respond
+        if (code == STORAGE_BUSY)
+            return STORAGE_EMPTY;
+    }
+    return STORAGE_EMPTY;
+}
+
+StorageReturnCode storage_save(const StorageRegion region, const void * const data, const size_t size) {
+    if (data == NULL)
+        return STORAGE_NULL_POINTER;
+    if (region >= STORAGE_REGION_COUNT || size + sizeof(StorageRecordHeader) > storage_layout[region].slot_size)
+        return STORAGE_OUT_OF_BOUNDS;
+    if (hstorage.pending)
+        return STORAGE_BUSY;
+
+    // Prepare the record for the next slot
+    StorageRecordHeader header = {
+        .sequence = hstorage.sequence[region] + 1U,
+        .size = (uint16_t)size
+    };
+    header.crc = _storage_record_crc(&header, data);
+    memcpy(hstorage.buffer, &header, sizeof(header));
+    memcpy(&hstorage.buffer[sizeof(header)], data, size);
+
+    hstorage.sequence[region] = header.sequence;
+    hstorage.address = _storage_slot_address(region, header.sequence);
+    hstorage.offset = 0U;
+    hstorage.size = sizeof(header) + size;
+    hstorage.pending = true;
+    return STORAGE_OK;
+}
+
+StorageReturnCode storage_read(
+    const StorageRegion region,
+    const uint32_t sequence,
+    void * const out,
+    const size_t size)
+{
+    if (out == NULL)
+        return STORAGE_NULL_POINTER;
+    if (region >= STORAGE_REGION_COUNT ||
+        size + sizeof(StorageRecordHeader) > storage_layout[region].slot_size ||
+        sequence == 0U ||
+        sequence > hstorage.sequence[region] ||
+        hstorage.sequence[region] - sequence >= storage_layout[region].slot_count)
+        return STORAGE_OUT_OF_BOUNDS;
+    // The newest record could be incomplete
+    if (hstorage.pending)
+        return STORAGE_BUSY;
+
+    uint8_t record[STORAGE_SLOT_SIZE_MAX];
+    const size_t record_size = sizeof(StorageRecordHeader) + size;
+    if (m95256_read(&hstorage.eeprom, _storage_slot_address(region, sequence), record, record_size) == M95256_BUSY)
+        return STORAGE_BUSY;
+
+    StorageRecordHeader header;
+    memcpy(&header, record, sizeof(header));
+    const uint8_t * const data = &record[sizeof(header)];
+    if (header.sequence != sequence || header.size != size || _storage_record_crc(&header, data) != header.crc)
+        return STORAGE_EMPTY;
+    memcpy(out, data, size);
+    return STORAGE_OK;
+}
+
+uint32_t storage_get_sequence(const StorageRegion region) {
+    if (region >= STORAGE_REGION_COUNT)
+        return 0U;
+    return hstorage.sequence[region];
+}
+
+size_t storage_get_count(const StorageRegion region) {
+    if (region >= STORAGE_REGION_COUNT)
+        return 0U;
+    return MAINBOARD_MIN(hstorage.sequence[region], storage_layout[region].slot_count);
+}
+
+bool storage_is_busy(void) {
+    return hstorage.pending;
+}
+
+void storage_routine(void) {
+    if (hstorage.pending)
+        (void)_storage_write_page();
+}
+
+#ifdef CONF_STORAGE_STRINGS_ENABLE
+
+_STATIC char * storage_module_name = "storage";
+
+_STATIC char * storage_return_code_name[] = {
+    [STORAGE_OK] = "ok",
+    [STORAGE_NULL_POINTER] = "null pointer",
+    [STORAGE_OUT_OF_BOUNDS] = "out of bounds",
+    [STORAGE_BUSY] = "busy",
+    [STORAGE_EMPTY] = "empty"
+};
+
+_STATIC char * storage_return_code_description[] = {
+    [STORAGE_OK] = "executed successfully",
+    [STORAGE_NULL_POINTER] = "attempt to dereference a null pointer",
+    [STORAGE_OUT_OF_BOUNDS] = "attempt to access an invalid memory region",
+    [STORAGE_BUSY] = "another record is being written",
+    [STORAGE_EMPTY] = "no valid record has been found"
+};
+
+#endif // CONF_STORAGE_STRINGS_ENABLE
+
+#endif // CONF_STORAGE_MODULE_ENABLE
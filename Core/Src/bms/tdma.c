@@ -0,0 +1,99 @@
+/**
+ * @file tdma.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Time division of the BMS network between the cellboards
+ */
+
+#include "tdma.h"
+
+#include <string.h>
+
+#include "timebase.h"
+
+#ifdef CONF_TDMA_MODULE_ENABLE
+
+_STATIC _TdmaHandler htdma;
+
+TdmaReturnCode tdma_init(void) {
+    memset(&htdma, 0U, sizeof(htdma));
+    const milliseconds_t resolution = timebase_get_resolution();
+    htdma.cycle_time = TIMEBASE_TIME_TO_TICKS(TDMA_CYCLE_TIME_MS, resolution);
+    htdma.slot_time = TIMEBASE_TIME_TO_TICKS(TDMA_SLOT_TIME_MS, resolution);
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    htdma.sync_can_payload.slot_time = TDMA_SLOT_TIME_MS;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    return TDMA_OK;
+}
+
+TdmaReturnCode tdma_notify_reception(const CellboardId id, const ticks_t timestamp) {
+    if (id >= CELLBOARD_ID_COUNT)
+        return TDMA_OUT_OF_BOUNDS;
+    if (!htdma.synced)
+        return TDMA_NOT_SYNCED;
+
+    /*
+     * The frame can be handled after a newer sync frame has been sent
+     * so its offset is calculated modulo the cycle duration
+     */
+    const ticks_t offset = (timestamp >= htdma.sync_time) ?
+        (timestamp - htdma.sync_time) % htdma.cycle_time :
+        (htdma.cycle_time - (htdma.sync_time - timestamp) % htdma.cycle_time) % htdma.cycle_time;
+    const ticks_t slot_start = htdma.slot_time * id;
+
+    TdmaSlotStats * const stats = &htdma.stats[id];
+    ++stats->received;
+    if (offset >= slot_start && offset < slot_start + htdma.slot_time) {
+        ++stats->in_slot;
+        stats->max_offset = MAINBOARD_MAX(stats->max_offset, offset - slot_start);
+    }
+    else
+        ++stats->out_of_slot;
+    return TDMA_OK;
+}
+
+const TdmaSlotStats * tdma_get_slot_stats(const CellboardId id) {
+    if (id >= CELLBOARD_ID_COUNT)
+        return NULL;
+    return &htdma.stats[id];
+}
+
+void tdma_reset_slot_stats(void) {
+    memset(htdma.stats, 0U, sizeof(htdma.stats));
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+bms_mainboard_sync_converted_t * tdma_get_sync_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(htdma.sync_can_payload);
+
+    // Start a new cycle
+    htdma.synced = true;
+    htdma.sync_time = timebase_get_tick();
+    htdma.sync_can_payload.cycle = htdma.cycle++;
+    return &htdma.sync_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#ifdef CONF_TDMA_STRINGS_ENABLE
+
+_STATIC char * tdma_module_name = "tdma";
+
+_STATIC char * tdma_return_code_name[] = {
+    [TDMA_OK] = "ok",
+    [TDMA_OUT_OF_BOUNDS] = "out of bounds",
+    [TDMA_NOT_SYNCED] = "not synced"
+};
+
+_STATIC char * tdma_return_code_description[] = {
+    [TDMA_OK] = "executed successfully",
+    [TDMA_OUT_OF_BOUNDS] = "attempt to access an invalid memory region",
+    [TDMA_NOT_SYNCED] = "no sync frame has been sent yet"
+};
+
+#endif // CONF_TDMA_STRINGS_ENABLE
+
+#endif // CONF_TDMA_MODULE_ENABLE
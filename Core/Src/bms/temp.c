@@ -9,11 +9,24 @@
 #include "temp.h"
 
 #include <string.h>
+#include <math.h>
 
 #include "error.h"
+#include "timebase.h"
+#include "stats.h"
+#include "can-comm.h"
+#include "tdma.h"
+
+#include "min-heap.h"
 
 #ifdef CONF_TEMPERATURE_MODULE_ENABLE
 
+_Static_assert((TEMP_TREE_SEGMENT_LEAF_COUNT & (TEMP_TREE_SEGMENT_LEAF_COUNT - 1U)) == 0U, "The number of leaves of a segment of the temperature trees must be a power of two");
+_Static_assert((TEMP_TREE_LEAF_COUNT & (TEMP_TREE_LEAF_COUNT - 1U)) == 0U, "The number of leaves of the temperature trees must be a power of two");
+_Static_assert(TEMP_TREE_SEGMENT_LEAF_COUNT >= CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT, "The leaves of a segment of the temperature trees must fit all its sensors");
+_Static_assert(TEMP_TREE_LEAF_COUNT >= CELLBOARD_COUNT * TEMP_TREE_SEGMENT_LEAF_COUNT, "The leaves of the temperature trees must fit all the segments");
+_Static_assert(TEMP_TREE_LEAF_COUNT == (1U << TEMP_TREE_DEPTH), "The depth of the temperature trees must match their number of leaves");
+
 _STATIC _TempHandler htemp;
 
 // Array to map cells index in memory to phisical positions
@@ -40,27 +53,244 @@ _STATIC_INLINE int32_t _temp_cell_position_from_index(size_t index) {
 }
 
 /**
- * @brief Check if the temperature values are in range otherwise set an error
+ * @brief Set or reset the errors of the sensors whose flag has changed
+ *
+ * @param group The error group
+ * @param base The error instance of the first sensor of the word
+ * @param changed The bitmap of the changed flags
+ * @param flags The bitmap of the new flags
+ */
+_STATIC_INLINE void _temp_update_errors(
+    const ErrorGroup group,
+    const size_t base,
+    bit_flag32_t changed,
+    const bit_flag32_t flags)
+{
+    while (changed != 0U) {
+        const bit_pos_t bit = __builtin_ctz(changed);
+        if (MAINBOARD_BIT_GET(flags, bit))
+            (void)error_set(group, base + bit);
+        else
+            (void)error_reset(group, base + bit);
+        changed &= changed - 1U;
+    }
+}
+
+/**
+ * @brief Check if the temperature values of a segment are in range otherwise set an error
+ *
+ * @details The limits of the given sensors are evaluated into bitmasks which are compared
+ * with the previous ones so that the error functions are called only on transitions
+ *
+ * @attention The error is set only once when a sensor crosses the limit so its group
+ * must not have a threshold, the error is debounced by the group timeout only
+ *
+ * @param id The cellboard identifier
+ * @param offset The offset of the first sensor to check
+ * @param size The number of sensors to check
+ */
+_STATIC_INLINE void _temp_check_values(const CellboardId id, const size_t offset, const size_t size) {
+    const temp_cell_t * const temperatures = htemp.temperatures[id];
+    const temp_cell_t min = TEMP_CELL_FROM_CELSIUS(TEMP_MIN_C);
+    const temp_cell_t max = TEMP_CELL_FROM_CELSIUS(TEMP_MAX_C);
+
+    bit_flag32_t under[TEMP_BITMAP_WORD_COUNT];
+    bit_flag32_t over[TEMP_BITMAP_WORD_COUNT];
+    memcpy(under, htemp.under[id], sizeof(under));
+    memcpy(over, htemp.over[id], sizeof(over));
+    for (size_t i = offset; i < offset + size; ++i) {
+        under[i / 32U] = MAINBOARD_BIT_TOGGLE_IF(under[i / 32U], temperatures[i] < min, i % 32U);
+        over[i / 32U] = MAINBOARD_BIT_TOGGLE_IF(over[i / 32U], temperatures[i] > max, i % 32U);
+    }
+
+    for (size_t word = 0U; word < TEMP_BITMAP_WORD_COUNT; ++word) {
+        const size_t base = id * CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT + word * 32U;
+        _temp_update_errors(ERROR_GROUP_UNDER_TEMPERATURE, base, under[word] ^ htemp.under[id][word], under[word]);
+        _temp_update_errors(ERROR_GROUP_OVER_TEMPERATURE, base, over[word] ^ htemp.over[id][word], over[word]);
+    }
+    memcpy(htemp.under[id], under, sizeof(under));
+    memcpy(htemp.over[id], over, sizeof(over));
+}
+
+/** @brief Get the index of the tree node which contains all the sensors of a segment */
+#define TEMP_TREE_SEGMENT_NODE(ID) (((TEMP_TREE_LEAF_COUNT) / (TEMP_TREE_SEGMENT_LEAF_COUNT)) + (ID))
+
+/** @brief Maximum number of candidate subtrees while the k hottest sensors are retrieved */
+#define TEMP_TOP_K_CANDIDATE_COUNT ((TEMP_TOP_K_MAX_COUNT) * (TEMP_TREE_DEPTH) + 1U)
+
+/**
+ * @brief Get the tree leaf which contains a single sensor
  *
  * @param id The cellboard identifier
- * @param offset The cell offset of the segment
- * @param value The temperature value in °C
+ * @param offset The sensor offset of the segment
+ *
+ * @return size_t The index of the leaf
  */
-_STATIC_INLINE void _temp_check_value(const CellboardId id, const size_t offset, const celsius_t value) {
-    size_t index = id * CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT + offset;
-    if (value < TEMP_MIN_C)
-        error_set(ERROR_GROUP_UNDER_TEMPERATURE, index);
-    else
-        error_reset(ERROR_GROUP_UNDER_TEMPERATURE, index);
+_STATIC_INLINE size_t _temp_tree_leaf(const CellboardId id, const size_t offset) {
+    return TEMP_TREE_LEAF_COUNT + id * TEMP_TREE_SEGMENT_LEAF_COUNT + offset;
+}
 
-    if (value > TEMP_MAX_C)
-        error_set(ERROR_GROUP_OVER_TEMPERATURE, index);
-    else
-        error_reset(ERROR_GROUP_OVER_TEMPERATURE, index);
+/**
+ * @brief Get the stored temperature of a sensor given its index in the pack
+ *
+ * @param index The sensor index
+ *
+ * @return temp_cell_t The stored temperature
+ */
+_STATIC_INLINE temp_cell_t _temp_raw(const size_t index) {
+    return htemp.temperatures[index / CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT][index % CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT];
+}
+
+/**
+ * @brief Get the temperature of a sensor given its index in the pack
+ *
+ * @param index The sensor index
+ *
+ * @return celsius_t The temperature in °C
+ */
+_STATIC_INLINE celsius_t _temp_value(const size_t index) {
+    return TEMP_CELL_TO_CELSIUS(_temp_raw(index));
+}
+
+/**
+ * @brief Get the sensor index stored in a node of a tree
+ *
+ * @details The leaves are not stored since their value depends only on their position
+ *
+ * @param tree The internal nodes of the tree
+ * @param node The index of the node
+ *
+ * @return uint16_t The sensor index or TEMP_TREE_NONE if the node is an unused leaf
+ */
+_STATIC_INLINE uint16_t _temp_tree_get(const uint16_t * const tree, const size_t node) {
+    if (node < TEMP_TREE_LEAF_COUNT)
+        return tree[node];
+    const size_t id = (node - TEMP_TREE_LEAF_COUNT) / TEMP_TREE_SEGMENT_LEAF_COUNT;
+    const size_t offset = (node - TEMP_TREE_LEAF_COUNT) % TEMP_TREE_SEGMENT_LEAF_COUNT;
+    if (id >= CELLBOARD_COUNT || offset >= CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT)
+        return TEMP_TREE_NONE;
+    return id * CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT + offset;
+}
+
+/**
+ * @brief Get the sensor with the lower temperature between two tree nodes
+ *
+ * @param a The sensor index of the first node (can be TEMP_TREE_NONE)
+ * @param b The sensor index of the second node (can be TEMP_TREE_NONE)
+ *
+ * @return uint16_t The winning sensor index
+ */
+_STATIC_INLINE uint16_t _temp_tree_min(const uint16_t a, const uint16_t b) {
+    if (a == TEMP_TREE_NONE)
+        return b;
+    if (b == TEMP_TREE_NONE)
+        return a;
+    return (_temp_raw(b) < _temp_raw(a)) ? b : a;
+}
+
+/**
+ * @brief Get the sensor with the higher temperature between two tree nodes
+ *
+ * @param a The sensor index of the first node (can be TEMP_TREE_NONE)
+ * @param b The sensor index of the second node (can be TEMP_TREE_NONE)
+ *
+ * @return uint16_t The winning sensor index
+ */
+_STATIC_INLINE uint16_t _temp_tree_max(const uint16_t a, const uint16_t b) {
+    if (a == TEMP_TREE_NONE)
+        return b;
+    if (b == TEMP_TREE_NONE)
+        return a;
+    return (_temp_raw(b) > _temp_raw(a)) ? b : a;
+}
+
+/**
+ * @brief Update the winners of a single internal node of both trees
+ *
+ * @param node The index of the node
+ */
+_STATIC_INLINE void _temp_tree_update_node(const size_t node) {
+    htemp.min_tree[node] = _temp_tree_min(_temp_tree_get(htemp.min_tree, 2U * node), _temp_tree_get(htemp.min_tree, 2U * node + 1U));
+    htemp.max_tree[node] = _temp_tree_max(_temp_tree_get(htemp.max_tree, 2U * node), _temp_tree_get(htemp.max_tree, 2U * node + 1U));
+}
+
+/**
+ * @brief Update the tree nodes from a leaf up to the root
+ *
+ * @param leaf The index of the updated leaf
+ */
+_STATIC_INLINE void _temp_tree_update(size_t leaf) {
+    for (size_t node = leaf / 2U; node > 0U; node /= 2U)
+        _temp_tree_update_node(node);
+}
+
+/** @brief Build the index trees from the current temperatures */
+_STATIC_INLINE void _temp_tree_build(void) {
+    for (size_t node = TEMP_TREE_LEAF_COUNT - 1U; node > 0U; --node)
+        _temp_tree_update_node(node);
+}
+
+/**
+ * @brief Compare two candidate subtrees by the temperature of their winners
+ *
+ * @details The hottest candidate is the minimum of the heap
+ *
+ * @param a A pointer to the first candidate node
+ * @param b A pointer to the second candidate node
+ *
+ * @return int8_t -1 if the first is hotter, 1 if the second is hotter, 0 otherwise
+ */
+int8_t _temp_tree_candidate_compare(void * a, void * b) {
+    const temp_cell_t f = _temp_raw(_temp_tree_get(htemp.max_tree, *(uint16_t *)a));
+    const temp_cell_t s = _temp_raw(_temp_tree_get(htemp.max_tree, *(uint16_t *)b));
+    if (f > s) return -1;
+    return f == s ? 0 : 1;
+}
+
+/**
+ * @brief Get the k hottest sensors of a subtree
+ *
+ * @details Every time the winner of a candidate subtree is taken the subtrees
+ * that lost against it along the path to its leaf become new candidates,
+ * so at most TEMP_TREE_DEPTH candidates are added for each sensor and the
+ * candidates are kept in a heap, which takes O(k * depth * log(k * depth))
+ *
+ * @param root The root of the subtree
+ * @param k The number of sensors to retrieve
+ * @param indices[out] The array where the sensor indices are stored
+ *
+ * @return size_t The number of indices stored in the array
+ */
+_STATIC size_t _temp_tree_top_k(const size_t root, size_t k, size_t * const indices) {
+    MinHeap(uint16_t, TEMP_TOP_K_CANDIDATE_COUNT) candidates;
+    (void)min_heap_init(&candidates, uint16_t, TEMP_TOP_K_CANDIDATE_COUNT, _temp_tree_candidate_compare);
+    uint16_t node = root;
+    if (_temp_tree_get(htemp.max_tree, node) != TEMP_TREE_NONE)
+        (void)min_heap_insert(&candidates, &node);
+
+    k = MAINBOARD_MIN(k, TEMP_TOP_K_MAX_COUNT);
+    size_t n = 0U;
+    while (n < k && min_heap_remove(&candidates, 0U, &node) == MIN_HEAP_OK) {
+        // Take the hottest candidate
+        const uint16_t winner = _temp_tree_get(htemp.max_tree, node);
+        indices[n++] = winner;
+
+        // Add the subtrees that lost against the winner
+        while (node < TEMP_TREE_LEAF_COUNT) {
+            const uint16_t left = 2U * node;
+            uint16_t other = (_temp_tree_get(htemp.max_tree, left) == winner) ? left + 1U : left;
+            node = (other == left) ? left + 1U : left;
+            if (_temp_tree_get(htemp.max_tree, other) != TEMP_TREE_NONE)
+                (void)min_heap_insert(&candidates, &other);
+        }
+    }
+    return n;
 }
 
 TempReturnCode temp_init(void) {
     memset(&htemp, 0U, sizeof(htemp));
+    freshness_init(&htemp.freshness, htemp.fresh, &htemp.last_update[0][0], CELLBOARD_TEMP_SENSOR_COUNT);
+    _temp_tree_build();
     return TEMP_OK;
 }
 
@@ -69,68 +299,132 @@ const cells_temp_t * temp_get_values(void) {
 }
 
 celsius_t temp_get_min(void) {
-    celsius_t min = TEMP_MAX_C;
-    for (size_t i = 0U; i < CELLBOARD_COUNT; ++i) {
-        for (size_t j = 0U; j < CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT; ++j) {
-            min = MAINBOARD_MIN(min, htemp.temperatures[i][j]);
-        }
-    }
-    return min;
+    return _temp_value(_temp_tree_get(htemp.min_tree, 1U));
 }
 
 celsius_t temp_get_max(void) {
-    celsius_t max = 0U;
-    for (size_t i = 0U; i < CELLBOARD_COUNT; ++i) {
-        for (size_t j = 0U; j < CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT; ++j) {
-            max = MAINBOARD_MAX(max, htemp.temperatures[i][j]);
-        }
-    }
-    return max;
+    return _temp_value(_temp_tree_get(htemp.max_tree, 1U));
 }
 
 celsius_t temp_get_sum(void) {
-    celsius_t sum = 0U;
-    for (size_t i = 0U; i < CELLBOARD_COUNT; ++i) {
-        for (size_t j = 0U; j < CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT; ++j) {
-            sum += htemp.temperatures[i][j];
-        }
-    }
-    return sum;
+    return htemp.sum;
+}
+
+celsius_t temp_get_std(void) {
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+    // The variance is obtained from the sum of squares which is exact in integer math
+    const int16_t * const temperatures = &htemp.temperatures[0U][0U];
+    int32_t total;
+    fixed_point_i16_aggregate(temperatures, CELLBOARD_TEMP_SENSOR_COUNT, NULL, NULL, &total);
+
+    const int64_t n = CELLBOARD_TEMP_SENSOR_COUNT;
+    const int64_t sum = total;
+    const int64_t sum_squares = fixed_point_i16_sum_squares(temperatures, CELLBOARD_TEMP_SENSOR_COUNT);
+    const float var = (float)(n * sum_squares - sum * sum) / (float)(n * (n - 1));
+    return TEMP_CELL_TO_CELSIUS(sqrtf(MAINBOARD_MAX(var, 0.f)));
+#else  // CONF_CELLS_FIXED_POINT_ENABLE
+    // The matrix is contiguous so it can be processed as a single array
+    return stats_std_f32(&htemp.temperatures[0U][0U], CELLBOARD_TEMP_SENSOR_COUNT);
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
+}
+
+celsius_t temp_get_segment_min(const CellboardId id) {
+    if (id >= CELLBOARD_ID_COUNT)
+        return 0U;
+    return _temp_value(_temp_tree_get(htemp.min_tree, TEMP_TREE_SEGMENT_NODE(id)));
+}
+
+celsius_t temp_get_segment_max(const CellboardId id) {
+    if (id >= CELLBOARD_ID_COUNT)
+        return 0U;
+    return _temp_value(_temp_tree_get(htemp.max_tree, TEMP_TREE_SEGMENT_NODE(id)));
+}
+
+size_t temp_get_top_k(size_t k, size_t * const indices) {
+    if (indices == NULL)
+        return 0U;
+    return _temp_tree_top_k(1U, k, indices);
+}
+
+size_t temp_get_segment_top_k(const CellboardId id, size_t k, size_t * const indices) {
+    if (id >= CELLBOARD_ID_COUNT || indices == NULL)
+        return 0U;
+    return _temp_tree_top_k(TEMP_TREE_SEGMENT_NODE(id), k, indices);
 }
 
 celsius_t temp_get_avg(void) {
     return temp_get_sum() / CELLBOARD_TEMP_SENSOR_COUNT;
 }
 
+uint32_t temp_get_sweep_count(void) {
+    return htemp.freshness.sweep;
+}
+
+ticks_t temp_get_sweep_time(void) {
+    return htemp.freshness.sweep_time;
+}
+
+bool temp_is_cell_fresh(const CellboardId id, const size_t offset) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT)
+        return false;
+    return freshness_is_fresh(&htemp.freshness, id * CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT + offset);
+}
+
+ticks_t temp_get_cell_age(const CellboardId id, const size_t offset) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT)
+        return 0U;
+    return freshness_get_age(&htemp.freshness, id * CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT + offset, timebase_get_tick());
+}
+
+ticks_t temp_get_data_age(void) {
+    return freshness_get_oldest_age(&htemp.freshness, timebase_get_tick());
+}
+
 void temp_cells_temperature_handle(bms_cellboard_cells_temperature_converted_t * const payload) {
     const size_t size = 4U;
     if (payload == NULL ||
        (CellboardId)payload->cellboard_id >= CELLBOARD_ID_COUNT ||
        payload->offset + size > CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT)
        return;
+    const ticks_t timestamp = can_comm_get_rx_timestamp();
+    (void)tdma_notify_reception((CellboardId)payload->cellboard_id, timestamp);
 
     // Update temperatures
     const size_t offset = payload->offset;
-    celsius_t * const temperatures = htemp.temperatures[payload->cellboard_id];
-    temperatures[offset] = payload->temperature_0;
-    temperatures[offset + 1U] = payload->temperature_1;
-    temperatures[offset + 2U] = payload->temperature_2;
-    temperatures[offset + 3U] = payload->temperature_3;
+    temp_cell_t * const temperatures = htemp.temperatures[payload->cellboard_id];
+    temperatures[offset] = TEMP_CELL_FROM_CELSIUS(payload->temperature_0);
+    temperatures[offset + 1U] = TEMP_CELL_FROM_CELSIUS(payload->temperature_1);
+    temperatures[offset + 2U] = TEMP_CELL_FROM_CELSIUS(payload->temperature_2);
+    temperatures[offset + 3U] = TEMP_CELL_FROM_CELSIUS(payload->temperature_3);
+    _temp_check_values((CellboardId)payload->cellboard_id, offset, size);
+    (void)freshness_update(&htemp.freshness, payload->cellboard_id * CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT + offset, size, timestamp);
     for (size_t i = 0U; i < size; ++i)
-        _temp_check_value((CellboardId)payload->cellboard_id, offset + i, temperatures[offset + i]);
+        _temp_tree_update(_temp_tree_leaf((CellboardId)payload->cellboard_id, offset + i));
+
+    // Update the sums, only the modified segment is scanned
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+    int32_t segment_sum = 0;
+    fixed_point_i16_aggregate(temperatures, CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT, NULL, NULL, &segment_sum);
+    htemp.segment_sum[payload->cellboard_id] = TEMP_CELL_TO_CELSIUS(segment_sum);
+#else  // CONF_CELLS_FIXED_POINT_ENABLE
+    htemp.segment_sum[payload->cellboard_id] = stats_sum_f32(temperatures, CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT);
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
+    htemp.sum = 0.f;
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id)
+        htemp.sum += htemp.segment_sum[id];
 }
 
 primary_hv_cells_temperature_converted_t * temp_get_cells_temperature_canlib_payload(size_t * const byte_size) {
     if (byte_size != NULL)
         *byte_size = sizeof(htemp.temp_can_payload);
 
-    const celsius_t * temperatures = htemp.temperatures[htemp.cellboard_id];
+    const temp_cell_t * temperatures = htemp.temperatures[htemp.cellboard_id];
     htemp.temp_can_payload.cellboard_id = (primary_hv_cells_temperature_cellboard_id)htemp.cellboard_id;
 
-    htemp.temp_can_payload.temperature_0 = temperatures[htemp.offset];
-    htemp.temp_can_payload.temperature_1 = temperatures[htemp.offset + 1];
-    htemp.temp_can_payload.temperature_2 = temperatures[htemp.offset + 2];
-    htemp.temp_can_payload.temperature_3 = temperatures[htemp.offset + 3];
+    htemp.temp_can_payload.temperature_0 = TEMP_CELL_TO_CELSIUS(temperatures[htemp.offset]);
+    htemp.temp_can_payload.temperature_1 = TEMP_CELL_TO_CELSIUS(temperatures[htemp.offset + 1]);
+    htemp.temp_can_payload.temperature_2 = TEMP_CELL_TO_CELSIUS(temperatures[htemp.offset + 2]);
+    htemp.temp_can_payload.temperature_3 = TEMP_CELL_TO_CELSIUS(temperatures[htemp.offset + 3]);
 
     htemp.temp_can_payload.temperature_id_0 = _temp_cell_position_from_index(htemp.offset);
     htemp.temp_can_payload.temperature_id_1 = _temp_cell_position_from_index(htemp.offset + 1);
@@ -160,6 +454,38 @@ primary_hv_cells_temp_stats_converted_t * temp_get_cells_temperature_stats_canli
     return &htemp.temp_stats_can_payload;
 }
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+primary_hv_cells_temp_hottest_converted_t * temp_get_cells_temperature_hottest_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(htemp.hottest_can_payload);
+
+    // Update the list only after every sensor has been sent
+    if (htemp.hottest_offset == 0U)
+        htemp.hottest_count = temp_get_top_k(TEMP_HOTTEST_COUNT, htemp.hottest);
+
+    size_t index[TEMP_HOTTEST_PER_CAN_MESSAGE];
+    for (size_t i = 0U; i < TEMP_HOTTEST_PER_CAN_MESSAGE; ++i)
+        index[i] = htemp.hottest[MAINBOARD_MIN(htemp.hottest_offset + i, htemp.hottest_count - 1U)];
+
+    htemp.hottest_can_payload.rank = htemp.hottest_offset;
+
+    htemp.hottest_can_payload.cellboard_id_0 = index[0U] / CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT;
+    htemp.hottest_can_payload.temperature_id_0 = _temp_cell_position_from_index(index[0U] % CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT);
+    htemp.hottest_can_payload.temperature_0 = _temp_value(index[0U]);
+
+    htemp.hottest_can_payload.cellboard_id_1 = index[1U] / CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT;
+    htemp.hottest_can_payload.temperature_id_1 = _temp_cell_position_from_index(index[1U] % CELLBOARD_SEGMENT_TEMP_SENSOR_COUNT);
+    htemp.hottest_can_payload.temperature_1 = _temp_value(index[1U]);
+
+    htemp.hottest_offset += TEMP_HOTTEST_PER_CAN_MESSAGE;
+    if (htemp.hottest_offset >= htemp.hottest_count)
+        htemp.hottest_offset = 0U;
+    return &htemp.hottest_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 #ifdef CONF_TEMPERATURE_STRINGS_ENABLE
 
 _STATIC char * temp_module_name = "temperature";
@@ -22,6 +22,15 @@
 #include "temp.h"
 #include "error.h"
 #include "cooling-temp.h"
+#include "tdma.h"
+#include "trend.h"
+#include "resistance.h"
+#include "soc.h"
+#include "sop.h"
+#include "soh.h"
+#include "storage.h"
+#include "event-log.h"
+#include "black-box.h"
 
 #ifdef CONF_TASKS_MODULE_ENABLE
 
@@ -176,6 +185,88 @@ void _tasks_send_hv_cells_temperature_stats(void) {
     );
 }
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/** @brief Send the hottest cells temperatures via CAN */
+void _tasks_send_hv_cells_temperature_hottest(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)temp_get_cells_temperature_hottest_canlib_payload(&byte_size);
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_CELLS_TEMP_HOTTEST_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the weak cells of a single cellboard via CAN */
+void _tasks_send_hv_weak_cells(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)trend_get_weak_cells_canlib_payload(&byte_size);
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_WEAK_CELLS_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the cells with the highest internal resistance via CAN */
+void _tasks_send_hv_cells_resistance(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)resistance_get_cells_resistance_canlib_payload(&byte_size);
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_CELLS_RESISTANCE_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the state of charge of the pack via CAN */
+void _tasks_send_hv_soc_estimation(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)soc_get_soc_canlib_payload(&byte_size);
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_SOC_ESTIMATION_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the state of charge of a single segment via CAN */
+void _tasks_send_hv_segment_soc(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)soc_get_segment_soc_canlib_payload(&byte_size);
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_SEGMENT_SOC_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the current and power limits via CAN */
+void _tasks_send_hv_power_limits(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)sop_get_power_limits_canlib_payload(&byte_size);
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_POWER_LIMITS_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 /** @brief Send the cooling temperatures via CAN */
 void _tasks_send_hv_cooling_temperature(void) {
     size_t byte_size = 0U;
@@ -241,6 +332,25 @@ void _tasks_send_hv_feedback_analog_sd(void) {
     ); 
 }
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/** @brief Send the command to feedback latency of the contactors via CAN */
+void _tasks_send_hv_contactor_latency(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)feedback_get_contactor_latency_payload(&byte_size);
+    if (payload == NULL)
+        return;
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_CONTACTOR_LATENCY_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 /** @brief Send the IMD status via CAN */
 void _tasks_send_hv_imd_status(void) {
     size_t byte_size = 0U;
@@ -254,6 +364,27 @@ void _tasks_send_hv_imd_status(void) {
     ); 
 }
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/**
+ * @brief Send the sync frame which starts a new TDMA cycle on the BMS network
+ *
+ * @details The frame is sent immediately to keep the cellboards slots aligned
+ */
+void _tasks_send_tdma_sync(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)tdma_get_sync_canlib_payload(&byte_size);
+    can_comm_send_immediate(
+        CAN_NETWORK_BMS,
+        BMS_MAINBOARD_SYNC_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 /** @brief Send the set balancing status command via CAN */
 void _tasks_send_cellboard_set_balancing_status(void) {
     size_t byte_size = 0U;
@@ -280,14 +411,114 @@ void _tasks_send_errors(void) {
     );
 }
 
-/** @brief Update all the digital feedbacks */
-void _tasks_read_digital_feedbacks(void) {
-    (void)feedback_update_digital_feedback_all();
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/** @brief Send the next message of the error report via CAN */
+void _tasks_send_error_report(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)error_get_error_report_canlib_payload(&byte_size);
+    if (payload == NULL)
+        return;
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_ERROR_REPORT_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the next event of the log dump via CAN */
+void _tasks_send_event_log(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)event_log_get_event_log_canlib_payload(&byte_size);
+    if (payload == NULL)
+        return;
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_EVENT_LOG_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the next bytes of the black box dump via CAN */
+void _tasks_send_black_box(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)black_box_get_black_box_canlib_payload(&byte_size);
+    if (payload == NULL)
+        return;
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_BLACK_BOX_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the CAN messages statistics via CAN */
+void _tasks_send_debug_can_stats(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)can_comm_get_stats_canlib_payload(&byte_size);
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_DEBUG_CAN_STATS_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+/** @brief Send the CAN buffers statistics via CAN */
+void _tasks_send_debug_can_buffers(void) {
+    size_t byte_size = 0U;
+    uint8_t * const payload = (uint8_t * const)can_comm_get_buffers_canlib_payload(&byte_size);
+    can_comm_tx_add(
+        CAN_NETWORK_PRIMARY,
+        PRIMARY_HV_DEBUG_CAN_BUFFERS_INDEX,
+        CAN_FRAME_TYPE_DATA,
+        payload,
+        byte_size
+    );
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+/** @brief Update the state of charge estimation */
+void _tasks_update_soc(void) {
+    soc_update();
+}
+
+/** @brief Update the current and power limits */
+void _tasks_update_sop(void) {
+    sop_update();
+}
+
+/** @brief Update the state of health tracking */
+void _tasks_update_soh(void) {
+    soh_update();
+}
+
+/** @brief Record a sample of the pack state */
+void _tasks_record_black_box(void) {
+    (void)black_box_record();
+}
+
+/** @brief Write the next chunk of the black box capture */
+void _tasks_run_black_box(void) {
+    black_box_routine();
+}
+
+/** @brief Move the oldest queued event to the storage */
+void _tasks_run_event_log(void) {
+    event_log_routine();
 }
 
-/** @brief Start the conversion of all the analog feedbacks */
-void _tasks_start_analog_conversion_feedbacks(void) {
-    (void)feedback_start_analog_conversion_all();
+/** @brief Write the pending data to the EEPROM */
+void _tasks_run_storage(void) {
+    storage_routine();
 }
 
 /** @brief Update all the feedbacks status */
@@ -0,0 +1,216 @@
+/**
+ * @file trend.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Cells voltage history and weak cells detection
+ */
+
+#include "trend.h"
+
+#include <string.h>
+#include <math.h>
+
+#include "timebase.h"
+#include "volt.h"
+#include "current.h"
+
+#ifdef CONF_TREND_MODULE_ENABLE
+
+/** @brief Constants of the least squares fit with equally spaced samples */
+#define TREND_INDEX_SUM ((int32_t)(TREND_HISTORY_SIZE * (TREND_HISTORY_SIZE - 1U) / 2U))
+#define TREND_SLOPE_DENOMINATOR ((float)TREND_HISTORY_SIZE * TREND_HISTORY_SIZE * (TREND_HISTORY_SIZE * TREND_HISTORY_SIZE - 1U) / 12.f)
+
+/** @brief Conversion factor from the slope numerator to mV/s */
+#define TREND_SLOPE_TO_MV_S (1000.f / (TREND_SLOPE_DENOMINATOR * TREND_SAMPLE_PERIOD_MS))
+
+_STATIC _TrendHandler htrend;
+
+/**
+ * @brief Discard the history of a cell
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ */
+_STATIC_INLINE void _trend_reset_cell(const CellboardId id, const size_t offset) {
+    TrendCellHistory * const cell = &htrend.cells[id][offset];
+    if (cell->count == TREND_HISTORY_SIZE) {
+        htrend.slope_sum -= cell->slope;
+        --htrend.slope_count;
+    }
+    cell->head = 0U;
+    cell->count = 0U;
+    cell->sum = 0;
+    cell->weighted_sum = 0;
+    cell->slope = 0;
+}
+
+/**
+ * @brief Update the weak flag of a cell with hysteresis
+ *
+ * @param id The cellboard identifier
+ * @param offset The cell offset of the segment
+ */
+_STATIC_INLINE void _trend_update_weak(const CellboardId id, const size_t offset) {
+    // The detection is meaningful only when the voltage drop is caused by the load
+    if (htrend.slope_count < 2U || fabsf(current_get_current()) < TREND_LOAD_CURRENT_A)
+        return;
+
+    TrendCellHistory * const cell = &htrend.cells[id][offset];
+    const float pack = (float)htrend.slope_sum / htrend.slope_count;
+    const float diff = ((float)cell->slope - pack) * TREND_SLOPE_TO_MV_S;
+    const bool weak = (pack < 0.f) ? (diff < -TREND_WEAK_SLOPE_MARGIN_MV_S) : (diff > TREND_WEAK_SLOPE_MARGIN_MV_S);
+
+    if (weak && cell->weak_count < TREND_WEAK_THRESHOLD) {
+        if (++cell->weak_count == TREND_WEAK_THRESHOLD)
+            htrend.weak[id] = MAINBOARD_BIT_SET(htrend.weak[id], offset);
+    }
+    else if (!weak && cell->weak_count > 0U) {
+        if (--cell->weak_count == 0U)
+            htrend.weak[id] = MAINBOARD_BIT_RESET(htrend.weak[id], offset);
+    }
+}
+
+TrendReturnCode trend_init(void) {
+    memset(&htrend, 0U, sizeof(htrend));
+    return TREND_OK;
+}
+
+TrendReturnCode trend_update(
+    const CellboardId id,
+    const size_t offset,
+    const volt_t value,
+    const ticks_t timestamp)
+{
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT)
+        return TREND_OUT_OF_BOUNDS;
+
+    // Decimate the samples
+    TrendCellHistory * const cell = &htrend.cells[id][offset];
+    const ticks_t period = TIMEBASE_TIME_TO_TICKS(TREND_SAMPLE_PERIOD_MS, timebase_get_resolution());
+    const ticks_t elapsed = timestamp - cell->last_sample;
+    if (cell->count > 0U) {
+        if (elapsed < period)
+            return TREND_OK;
+        if (elapsed > period * TREND_GAP_PERIODS)
+            _trend_reset_cell(id, offset);
+    }
+    cell->last_sample = timestamp;
+
+    const int32_t sample = (int32_t)MAINBOARD_CLAMP(value * 1000.f + 0.5f, 0.f, (float)UINT16_MAX);
+    if (cell->count < TREND_HISTORY_SIZE) {
+        // Append the sample at the end of the history
+        cell->samples[(cell->head + cell->count) % TREND_HISTORY_SIZE] = (uint16_t)sample;
+        cell->weighted_sum += sample * cell->count;
+        cell->sum += sample;
+        if (++cell->count < TREND_HISTORY_SIZE)
+            return TREND_OK;
+        ++htrend.slope_count;
+    }
+    else {
+        /*
+         * Replace the oldest sample, the index of every other sample
+         * is decremented by one so their sum is removed from the weighted sum
+         */
+        const int32_t oldest = cell->samples[cell->head];
+        cell->samples[cell->head] = (uint16_t)sample;
+        cell->head = (cell->head + 1U) % TREND_HISTORY_SIZE;
+        cell->weighted_sum += oldest - cell->sum + sample * (int32_t)(TREND_HISTORY_SIZE - 1U);
+        cell->sum += sample - oldest;
+        htrend.slope_sum -= cell->slope;
+    }
+
+    cell->slope = (int32_t)TREND_HISTORY_SIZE * cell->weighted_sum - TREND_INDEX_SUM * cell->sum;
+    htrend.slope_sum += cell->slope;
+    _trend_update_weak(id, offset);
+    return TREND_OK;
+}
+
+TrendReturnCode trend_get_slope(const CellboardId id, const size_t offset, float * const out) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT || out == NULL)
+        return TREND_OUT_OF_BOUNDS;
+    const TrendCellHistory * const cell = &htrend.cells[id][offset];
+    if (cell->count < TREND_HISTORY_SIZE)
+        return TREND_NOT_READY;
+    *out = cell->slope * TREND_SLOPE_TO_MV_S;
+    return TREND_OK;
+}
+
+TrendReturnCode trend_get_deviation(const CellboardId id, const size_t offset, float * const out) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT || out == NULL)
+        return TREND_OUT_OF_BOUNDS;
+    const TrendCellHistory * const cell = &htrend.cells[id][offset];
+    if (cell->count == 0U)
+        return TREND_NOT_READY;
+    const uint16_t last = cell->samples[(cell->head + cell->count - 1U) % TREND_HISTORY_SIZE];
+    *out = (float)last - volt_get_avg() * 1000.f;
+    return TREND_OK;
+}
+
+float trend_get_pack_slope(void) {
+    if (htrend.slope_count == 0U)
+        return 0.f;
+    return ((float)htrend.slope_sum / htrend.slope_count) * TREND_SLOPE_TO_MV_S;
+}
+
+bool trend_is_weak(const CellboardId id, const size_t offset) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT)
+        return false;
+    return MAINBOARD_BIT_GET(htrend.weak[id], offset);
+}
+
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+primary_hv_weak_cells_converted_t * trend_get_weak_cells_canlib_payload(size_t * const byte_size) {
+    if (byte_size != NULL)
+        *byte_size = sizeof(htrend.weak_cells_can_payload);
+
+    // Find the cell whose voltage changes faster than the pack average
+    const CellboardId id = htrend.cellboard_id;
+    const int64_t pack = (htrend.slope_count > 0U) ? htrend.slope_sum / (int64_t)htrend.slope_count : 0;
+    size_t worst = 0U;
+    int64_t worst_diff = -1;
+    for (size_t i = 0U; i < CELLBOARD_SEGMENT_SERIES_COUNT; ++i) {
+        const TrendCellHistory * const cell = &htrend.cells[id][i];
+        if (cell->count < TREND_HISTORY_SIZE)
+            continue;
+        const int64_t diff = (cell->slope > pack) ? (cell->slope - pack) : (pack - cell->slope);
+        if (diff > worst_diff) {
+            worst_diff = diff;
+            worst = i;
+        }
+    }
+
+    htrend.weak_cells_can_payload.cellboard_id = (primary_hv_weak_cells_cellboard_id)id;
+    htrend.weak_cells_can_payload.weak_cells = htrend.weak[id];
+    htrend.weak_cells_can_payload.worst_offset = worst;
+    htrend.weak_cells_can_payload.worst_slope = (worst_diff < 0) ? 0.f : htrend.cells[id][worst].slope * TREND_SLOPE_TO_MV_S;
+    htrend.weak_cells_can_payload.pack_slope = trend_get_pack_slope();
+
+    // Update index
+    if (++htrend.cellboard_id >= CELLBOARD_ID_COUNT)
+        htrend.cellboard_id = CELLBOARD_ID_0;
+    return &htrend.weak_cells_can_payload;
+}
+
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
+#ifdef CONF_TREND_STRINGS_ENABLE
+
+_STATIC char * trend_module_name = "trend";
+
+_STATIC char * trend_return_code_name[] = {
+    [TREND_OK] = "ok",
+    [TREND_OUT_OF_BOUNDS] = "out of bounds",
+    [TREND_NOT_READY] = "not ready"
+};
+
+_STATIC char * trend_return_code_description[] = {
+    [TREND_OK] = "executed successfully",
+    [TREND_OUT_OF_BOUNDS] = "attempt to access an invalid memory region",
+    [TREND_NOT_READY] = "not enough samples are available"
+};
+
+#endif // CONF_TREND_STRINGS_ENABLE
+
+#endif // CONF_TREND_MODULE_ENABLE
@@ -9,44 +9,159 @@
 #include "volt.h"
 
 #include <string.h>
+#include <math.h>
 
 #include "identity.h"
 #include "timebase.h"
 #include "error.h"
+#include "can-comm.h"
+#include "tdma.h"
+#include "stats.h"
+#include "trend.h"
+#include "resistance.h"
+#include "current.h"
 
 #ifdef CONF_VOLTAGE_MODULE_ENABLE
 
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+_Static_assert(PRIMARY_HV_CELLS_VOLTAGE_STATS_BYTE_SIZE <= 8U, "The cells voltage stats with the extremes indices must fit a single CAN frame");
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
+
 _STATIC _VoltHandler hvolt;
 
 /**
- * @brief Check if the voltage values are in range otherwise set an error
+ * @brief Set or reset the errors of the cells whose flag has changed
+ *
+ * @param group The error group
+ * @param base The error instance of the first cell of the word
+ * @param changed The bitmap of the changed flags
+ * @param flags The bitmap of the new flags
+ */
+_STATIC_INLINE void _volt_update_errors(
+    const ErrorGroup group,
+    const size_t base,
+    bit_flag32_t changed,
+    const bit_flag32_t flags)
+{
+    while (changed != 0U) {
+        const bit_pos_t bit = __builtin_ctz(changed);
+        if (MAINBOARD_BIT_GET(flags, bit))
+            (void)error_set(group, base + bit);
+        else
+            (void)error_reset(group, base + bit);
+        changed &= changed - 1U;
+    }
+}
+
+/**
+ * @brief Check if the voltage values of a segment are in range otherwise set an error
+ *
+ * @details The limits of the given cells are evaluated into bitmasks which are compared
+ * with the previous ones so that the error functions are called only on transitions
+ *
+ * @attention The error is set only once when a cell crosses the limit so its group
+ * must not have a threshold, the error is debounced by the group timeout only
  *
  * @param id The cellboard identifier
- * @param offset The cell offset of the segment
- * @param value The voltage value in V
+ * @param offset The offset of the first cell to check
+ * @param size The number of cells to check
  */
-_STATIC_INLINE void _volt_check_value(const CellboardId id, const size_t offset, const volt_t value) {
-    size_t index = id * CELLBOARD_SEGMENT_SERIES_COUNT + offset;
-    if (value < VOLT_MIN_V)
-        error_set(ERROR_GROUP_UNDER_VOLTAGE, index);
-    else
-        error_reset(ERROR_GROUP_UNDER_VOLTAGE, index);
+_STATIC_INLINE void _volt_check_values(const CellboardId id, const size_t offset, const size_t size) {
+    const volt_cell_t * const volts = hvolt.voltages[id];
+    const volt_cell_t min = VOLT_CELL_FROM_VOLT(VOLT_MIN_V);
+    const volt_cell_t max = VOLT_CELL_FROM_VOLT(VOLT_MAX_V);
+
+    bit_flag32_t under[VOLT_BITMAP_WORD_COUNT];
+    bit_flag32_t over[VOLT_BITMAP_WORD_COUNT];
+    memcpy(under, hvolt.under[id], sizeof(under));
+    memcpy(over, hvolt.over[id], sizeof(over));
+    for (size_t i = offset; i < offset + size; ++i) {
+        under[i / 32U] = MAINBOARD_BIT_TOGGLE_IF(under[i / 32U], volts[i] < min, i % 32U);
+        over[i / 32U] = MAINBOARD_BIT_TOGGLE_IF(over[i / 32U], volts[i] > max, i % 32U);
+    }
 
-    if (value > VOLT_MAX_V)
-        error_set(ERROR_GROUP_OVER_VOLTAGE, index);
-    else
-        error_reset(ERROR_GROUP_OVER_VOLTAGE, index);
+    for (size_t word = 0U; word < VOLT_BITMAP_WORD_COUNT; ++word) {
+        const size_t base = id * CELLBOARD_SEGMENT_SERIES_COUNT + word * 32U;
+        _volt_update_errors(ERROR_GROUP_UNDER_VOLTAGE, base, under[word] ^ hvolt.under[id][word], under[word]);
+        _volt_update_errors(ERROR_GROUP_OVER_VOLTAGE, base, over[word] ^ hvolt.over[id][word], over[word]);
+    }
+    memcpy(hvolt.under[id], under, sizeof(under));
+    memcpy(hvolt.over[id], over, sizeof(over));
+}
+
+/**
+ * @brief Update the aggregated values of a segment and of the whole pack
+ *
+ * @details Only the given segment is scanned, the pack values are then
+ * obtained from the aggregated values of each segment
+ *
+ * @param id The identifier of the updated cellboard
+ */
+_STATIC_INLINE void _volt_update_aggregate(const CellboardId id) {
+    const volt_cell_t * const volts = hvolt.voltages[id];
+    const size_t base = id * CELLBOARD_SEGMENT_SERIES_COUNT;
+    VoltAggregate segment = {
+        .min_index = base,
+        .max_index = base
+    };
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+    uint16_t min, max;
+    uint32_t sum;
+    fixed_point_u16_aggregate(volts, CELLBOARD_SEGMENT_SERIES_COUNT, &min, &max, &sum);
+
+    // Search for the position of the extremes only after their values are known
+    bool min_found = false, max_found = false;
+    for (size_t i = 0U; i < CELLBOARD_SEGMENT_SERIES_COUNT && !(min_found && max_found); ++i) {
+        if (!min_found && volts[i] == min) {
+            segment.min_index = base + i;
+            min_found = true;
+        }
+        if (!max_found && volts[i] == max) {
+            segment.max_index = base + i;
+            max_found = true;
+        }
+    }
+    segment.min = VOLT_CELL_TO_VOLT(min);
+    segment.max = VOLT_CELL_TO_VOLT(max);
+    segment.sum = VOLT_CELL_TO_VOLT(sum);
+#else  // CONF_CELLS_FIXED_POINT_ENABLE
+    size_t min_offset, max_offset;
+    segment.min = stats_min_f32(volts, CELLBOARD_SEGMENT_SERIES_COUNT, &min_offset);
+    segment.max = stats_max_f32(volts, CELLBOARD_SEGMENT_SERIES_COUNT, &max_offset);
+    segment.sum = stats_sum_f32(volts, CELLBOARD_SEGMENT_SERIES_COUNT);
+    segment.min_index = base + min_offset;
+    segment.max_index = base + max_offset;
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
+    hvolt.segments[id] = segment;
+
+    // Update the pack values
+    VoltAggregate pack = hvolt.segments[CELLBOARD_ID_0];
+    for (CellboardId i = CELLBOARD_ID_1; i < CELLBOARD_ID_COUNT; ++i) {
+        pack.sum += hvolt.segments[i].sum;
+        if (hvolt.segments[i].min < pack.min) {
+            pack.min = hvolt.segments[i].min;
+            pack.min_index = hvolt.segments[i].min_index;
+        }
+        if (hvolt.segments[i].max > pack.max) {
+            pack.max = hvolt.segments[i].max;
+            pack.max_index = hvolt.segments[i].max_index;
+        }
+    }
+    hvolt.pack = pack;
 }
 
 VoltReturnCode volt_init(void) {
     memset(&hvolt, 0U, sizeof(hvolt));
+    freshness_init(&hvolt.freshness, hvolt.fresh, &hvolt.last_update[0][0], CELLBOARD_SERIES_COUNT);
     /*
      * Set the initial value of the voltages as maximum to avoid
      * problems during the balancing procedure
      */
     for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id)
         for (size_t cell = 0U; cell < CELLBOARD_SEGMENT_SERIES_COUNT; ++cell)
-            hvolt.voltages[id][cell] = VOLT_MAX_V;
+            hvolt.voltages[id][cell] = VOLT_CELL_FROM_VOLT(VOLT_MAX_V);
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id)
+        _volt_update_aggregate(id);
     return VOLT_OK;
 }
 
@@ -55,65 +170,151 @@ const cells_voltage_t * volt_get_values(void) {
 }
 
 volt_t volt_get_min(void) {
-    volt_t min = VOLT_MAX_V;
-    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
-        for (size_t i = 0U; i < CELLBOARD_SEGMENT_SERIES_COUNT; ++i) {
-            min = MAINBOARD_MIN(hvolt.voltages[id][i], min);
-        }
-    }
-    return min;
+    return hvolt.pack.min;
 }
 
 volt_t volt_get_max(void) {
-    volt_t max = 0.f;
-    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
-        for (size_t i = 0U; i < CELLBOARD_SEGMENT_SERIES_COUNT; ++i) {
-            max = MAINBOARD_MAX(hvolt.voltages[id][i], max);
-        }
-    }
-    return max;
+    return hvolt.pack.max;
 }
 
 volt_t volt_get_sum(void) {
-    volt_t sum = 0.f;
+    return hvolt.pack.sum;
+}
+
+volt_t volt_get_std(void) {
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+    /*
+     * The millivolts never exceed INT16_MAX so they can be used as signed values,
+     * the variance is obtained from the sum of squares which is exact in integer math
+     */
+    const uint16_t * const volts = &hvolt.voltages[0U][0U];
+    uint32_t total;
+    fixed_point_u16_aggregate(volts, CELLBOARD_SERIES_COUNT, NULL, NULL, &total);
+
+    const int64_t n = CELLBOARD_SERIES_COUNT;
+    const int64_t sum = total;
+    const int64_t sum_squares = fixed_point_i16_sum_squares((const int16_t *)volts, CELLBOARD_SERIES_COUNT);
+    const float var = (float)(n * sum_squares - sum * sum) / (float)(n * (n - 1));
+    return VOLT_CELL_TO_VOLT(sqrtf(MAINBOARD_MAX(var, 0.f)));
+#else  // CONF_CELLS_FIXED_POINT_ENABLE
+    // The matrix is contiguous so it can be processed as a single array
+    return stats_std_f32(&hvolt.voltages[0U][0U], CELLBOARD_SERIES_COUNT);
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
+}
+
+size_t volt_get_min_index(void) {
+    return hvolt.pack.min_index;
+}
+
+size_t volt_get_max_index(void) {
+    return hvolt.pack.max_index;
+}
+
+VoltReturnCode volt_get_histogram(
+    const volt_t low,
+    const volt_t width,
+    uint16_t * const bins,
+    const size_t bin_count)
+{
+    if (bins == NULL)
+        return VOLT_NULL_POINTER;
+    if (bin_count == 0U || width <= 0.f)
+        return VOLT_OUT_OF_BOUNDS;
+
+#ifdef CONF_CELLS_FIXED_POINT_ENABLE
+    const uint16_t fixed_width = VOLT_CELL_FROM_VOLT(width);
+    if (fixed_width == 0U)
+        return VOLT_OUT_OF_BOUNDS;
+    // The matrix is contiguous so it can be processed as a single array
+    fixed_point_u16_histogram(
+        &hvolt.voltages[0U][0U],
+        CELLBOARD_SERIES_COUNT,
+        VOLT_CELL_FROM_VOLT(low),
+        fixed_width,
+        bins,
+        bin_count
+    );
+#else  // CONF_CELLS_FIXED_POINT_ENABLE
+    memset(bins, 0U, bin_count * sizeof(*bins));
     for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
         for (size_t i = 0U; i < CELLBOARD_SEGMENT_SERIES_COUNT; ++i) {
-            sum += hvolt.voltages[id][i];
+            const volt_t value = MAINBOARD_MAX(hvolt.voltages[id][i] - low, 0.f);
+            ++bins[MAINBOARD_MIN((size_t)(value / width), bin_count - 1U)];
         }
     }
-    return sum;
+#endif  // CONF_CELLS_FIXED_POINT_ENABLE
+    return VOLT_OK;
+}
+
+const VoltAggregate * volt_get_segment_aggregate(const CellboardId id) {
+    if (id >= CELLBOARD_ID_COUNT)
+        return NULL;
+    return &hvolt.segments[id];
 }
 
 volt_t volt_get_avg(void) {
     return volt_get_sum() / CELLBOARD_SERIES_COUNT;
 }
 
+uint32_t volt_get_sweep_count(void) {
+    return hvolt.freshness.sweep;
+}
+
+ticks_t volt_get_sweep_time(void) {
+    return hvolt.freshness.sweep_time;
+}
+
+bool volt_is_cell_fresh(const CellboardId id, const size_t offset) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT)
+        return false;
+    return freshness_is_fresh(&hvolt.freshness, id * CELLBOARD_SEGMENT_SERIES_COUNT + offset);
+}
+
+ticks_t volt_get_cell_age(const CellboardId id, const size_t offset) {
+    if (id >= CELLBOARD_ID_COUNT || offset >= CELLBOARD_SEGMENT_SERIES_COUNT)
+        return 0U;
+    return freshness_get_age(&hvolt.freshness, id * CELLBOARD_SEGMENT_SERIES_COUNT + offset, timebase_get_tick());
+}
+
+ticks_t volt_get_data_age(void) {
+    return freshness_get_oldest_age(&hvolt.freshness, timebase_get_tick());
+}
+
 void volt_cells_voltage_handle(bms_cellboard_cells_voltage_converted_t * const payload) {
     const size_t size = 3U;
     if (payload == NULL ||
         (CellboardId)payload->cellboard_id >= CELLBOARD_ID_COUNT ||
         payload->offset + size > CELLBOARD_SEGMENT_SERIES_COUNT)
         return;
+    const ticks_t timestamp = can_comm_get_rx_timestamp();
+    const ampere_t current = current_get_current_at(timestamp);
+    (void)tdma_notify_reception((CellboardId)payload->cellboard_id, timestamp);
+
     // Update voltages
     const size_t offset = payload->offset;
-    volt_t * volts = hvolt.voltages[payload->cellboard_id];
-    volts[offset] = payload->voltage_0;
-    volts[offset + 1U] = payload->voltage_1;
-    volts[offset + 2U] = payload->voltage_2;
-    for (size_t i = 0U; i < size; ++i)
-        _volt_check_value((CellboardId)payload->cellboard_id, offset + i, volts[offset + i]);
+    volt_cell_t * volts = hvolt.voltages[payload->cellboard_id];
+    volts[offset] = VOLT_CELL_FROM_VOLT(payload->voltage_0);
+    volts[offset + 1U] = VOLT_CELL_FROM_VOLT(payload->voltage_1);
+    volts[offset + 2U] = VOLT_CELL_FROM_VOLT(payload->voltage_2);
+    _volt_check_values((CellboardId)payload->cellboard_id, offset, size);
+    (void)freshness_update(&hvolt.freshness, payload->cellboard_id * CELLBOARD_SEGMENT_SERIES_COUNT + offset, size, timestamp);
+    for (size_t i = 0U; i < size; ++i) {
+        (void)trend_update((CellboardId)payload->cellboard_id, offset + i, VOLT_CELL_TO_VOLT(volts[offset + i]), timestamp);
+        (void)resistance_update((CellboardId)payload->cellboard_id, offset + i, VOLT_CELL_TO_VOLT(volts[offset + i]), current);
+    }
+    _volt_update_aggregate((CellboardId)payload->cellboard_id);
 }
 
 primary_hv_cells_voltage_converted_t * volt_get_cells_voltage_canlib_payload(size_t * const byte_size) {
     if (byte_size != NULL)
         *byte_size = sizeof(hvolt.volt_can_payload);
-    const volt_t * const volts = hvolt.voltages[hvolt.cellboard_id];
+    const volt_cell_t * const volts = hvolt.voltages[hvolt.cellboard_id];
     // Set payload values
     hvolt.volt_can_payload.cellboard_id = (primary_hv_cells_voltage_cellboard_id)hvolt.cellboard_id;
     hvolt.volt_can_payload.offset = hvolt.offset;
-    hvolt.volt_can_payload.voltage_0 = volts[hvolt.offset];
-    hvolt.volt_can_payload.voltage_1 = volts[hvolt.offset + 1];
-    hvolt.volt_can_payload.voltage_2 = volts[hvolt.offset + 2];
+    hvolt.volt_can_payload.voltage_0 = VOLT_CELL_TO_VOLT(volts[hvolt.offset]);
+    hvolt.volt_can_payload.voltage_1 = VOLT_CELL_TO_VOLT(volts[hvolt.offset + 1]);
+    hvolt.volt_can_payload.voltage_2 = VOLT_CELL_TO_VOLT(volts[hvolt.offset + 2]);
 
     // Update indices
     hvolt.offset += 3;
@@ -138,6 +339,10 @@ primary_hv_cells_voltage_stats_converted_t * volt_get_cells_voltage_stats_canlib
     hvolt.volt_stats_can_payload.delta = max - min;
 
     hvolt.volt_stats_can_payload.avg = volt_get_avg();
+#ifdef CONF_CANLIB_PENDING_MESSAGES_ENABLE
+    hvolt.volt_stats_can_payload.min_index = hvolt.pack.min_index;
+    hvolt.volt_stats_can_payload.max_index = hvolt.pack.max_index;
+#endif // CONF_CANLIB_PENDING_MESSAGES_ENABLE
 
     return &hvolt.volt_stats_can_payload;
 }
@@ -64,6 +64,7 @@ void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
 
 void system_reset(void);
+uint32_t get_cycles(void);
 
 /* USER CODE END PFP */
 
@@ -114,8 +115,14 @@ int main(void)
   MX_SPI3_Init();
   MX_TIM6_Init();
   MX_TIM7_Init();
+  MX_TIM3_Init();
   /* USER CODE BEGIN 2 */
 
+  // Enable the CPU cycle counter used for profiling
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTEN_Msk;
+
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -139,8 +146,8 @@ int main(void)
       .system_reset = system_reset,
       .cs_enter = it_cs_enter,
       .cs_exit = it_cs_exit,
-      // .error_update_timer = tim_update_error_timer,
-      // .error_stop_timer = tim_stop_error_timer,
+      .error_update_timer = tim_update_error_timer,
+      .error_stop_timer = tim_stop_error_timer,
       .can_send = can_send,
       .led_set = gpio_led_set_state,
       .led_toggle = gpio_led_toggle_state,
@@ -149,10 +156,12 @@ int main(void)
       .pcu_toggle = gpio_pcu_toggle_state,
       .feedback_read_all = gpio_feedback_read_all,
       .feedback_start_conversion = adc_start_feedback_conversion,
+      .feedback_get_time_us = tim_get_time_us,
       .display_set = gpio_display_segment_set_state,
       .display_toggle = gpio_display_segment_toggle_state,
       .spi_send = spi_send,
-      .spi_send_receive = spi_send_receive
+      .spi_send_receive = spi_send_receive,
+      .get_cycles = get_cycles
   };
 
   fsm_state = fsm_run_state(fsm_state, &init_data);
@@ -224,6 +233,10 @@ void SystemClock_Config(void)
 void system_reset(void) {
     HAL_NVIC_SystemReset();
 }
+
+uint32_t get_cycles(void) {
+    return DWT->CYCCNT;
+}
  
 /* USER CODE END 4 */
 
@@ -45,7 +45,7 @@ void MX_SPI2_Init(void)
   hspi2.Init.CLKPolarity = SPI_POLARITY_LOW;
   hspi2.Init.CLKPhase = SPI_PHASE_1EDGE;
   hspi2.Init.NSS = SPI_NSS_SOFT;
-  hspi2.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;
+  hspi2.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_4;
   hspi2.Init.FirstBit = SPI_FIRSTBIT_MSB;
   hspi2.Init.TIMode = SPI_TIMODE_DISABLE;
   hspi2.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
@@ -56,6 +56,10 @@ void MX_SPI2_Init(void)
   }
   /* USER CODE BEGIN SPI2_Init 2 */
 
+  // Deselect the EEPROM and release the active low hold input
+  HAL_GPIO_WritePin(SPI_EEPROM_CS_GPIO_Port, SPI_EEPROM_CS_Pin, GPIO_PIN_SET);
+  HAL_GPIO_WritePin(HOLD_EEPROM_GPIO_Port, HOLD_EEPROM_Pin, GPIO_PIN_SET);
+
   /* USER CODE END SPI2_Init 2 */
 
 }
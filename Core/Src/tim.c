@@ -28,12 +28,13 @@
 
 #include "imd.h"
 #include "timebase.h"
-// #include "error-handler.h"
+#include "error.h"
 
 /* USER CODE END 0 */
 
 TIM_HandleTypeDef htim1;
 TIM_HandleTypeDef htim2;
+TIM_HandleTypeDef htim3;
 TIM_HandleTypeDef htim4;
 TIM_HandleTypeDef htim6;
 TIM_HandleTypeDef htim7;
@@ -161,6 +162,46 @@ void MX_TIM2_Init(void)
   /* USER CODE END TIM2_Init 2 */
   HAL_TIM_MspPostInit(&htim2);
 
+}
+/* TIM3 init function */
+void MX_TIM3_Init(void)
+{
+
+  /* USER CODE BEGIN TIM3_Init 0 */
+
+  /* USER CODE END TIM3_Init 0 */
+
+  TIM_ClockConfigTypeDef sClockSourceConfig = {0};
+  TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+  /* USER CODE BEGIN TIM3_Init 1 */
+
+  /* USER CODE END TIM3_Init 1 */
+  htim3.Instance = TIM3;
+  htim3.Init.Prescaler = 89;
+  htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim3.Init.Period = 249;
+  htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  if (HAL_TIM_Base_Init(&htim3) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
+  if (HAL_TIM_ConfigClockSource(&htim3, &sClockSourceConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+  sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+  if (HAL_TIMEx_MasterConfigSynchronization(&htim3, &sMasterConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN TIM3_Init 2 */
+
+  /* USER CODE END TIM3_Init 2 */
+
 }
 /* TIM4 init function */
 void MX_TIM4_Init(void)
@@ -278,7 +319,7 @@ void MX_TIM7_Init(void)
 
   /* USER CODE END TIM7_Init 1 */
   htim7.Instance = TIM7;
-  htim7.Init.Prescaler = 0;
+  htim7.Init.Prescaler = 44999;
   htim7.Init.CounterMode = TIM_COUNTERMODE_UP;
   htim7.Init.Period = 65535;
   htim7.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
@@ -324,6 +365,17 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* tim_baseHandle)
 
   /* USER CODE END TIM2_MspInit 1 */
   }
+  else if(tim_baseHandle->Instance==TIM3)
+  {
+  /* USER CODE BEGIN TIM3_MspInit 0 */
+
+  /* USER CODE END TIM3_MspInit 0 */
+    /* TIM3 clock enable */
+    __HAL_RCC_TIM3_CLK_ENABLE();
+  /* USER CODE BEGIN TIM3_MspInit 1 */
+
+  /* USER CODE END TIM3_MspInit 1 */
+  }
   else if(tim_baseHandle->Instance==TIM4)
   {
   /* USER CODE BEGIN TIM4_MspInit 0 */
@@ -454,6 +506,17 @@ void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef* tim_baseHandle)
 
   /* USER CODE END TIM2_MspDeInit 1 */
   }
+  else if(tim_baseHandle->Instance==TIM3)
+  {
+  /* USER CODE BEGIN TIM3_MspDeInit 0 */
+
+  /* USER CODE END TIM3_MspDeInit 0 */
+    /* Peripheral clock disable */
+    __HAL_RCC_TIM3_CLK_DISABLE();
+  /* USER CODE BEGIN TIM3_MspDeInit 1 */
+
+  /* USER CODE END TIM3_MspDeInit 1 */
+  }
   else if(tim_baseHandle->Instance==TIM4)
   {
   /* USER CODE BEGIN TIM4_MspDeInit 0 */
@@ -523,14 +586,14 @@ void tim_update_error_timer(const uint32_t timestamp, const uint16_t timeout) {
     HAL_TIM_Base_Stop_IT(&HTIM_ERROR);
 
     // Calculate the delta between the current time and the expected expiration time
-    const int32_t t = HAL_GetTick();
+    const int32_t t = timebase_get_time();
     // Negative value are clamped to 0
     const int32_t dt = MAINBOARD_MAX(0, ((int32_t)timestamp - t) + (int32_t)timeout);
 
-    // Set timer to expire after the calculated delta time
+    // Set timer to expire after the calculated delta time (the counter does not run with a zero reload value)
     __HAL_TIM_SET_COUNTER(&HTIM_ERROR, 0);
-    __HAL_TIM_SET_AUTORELOAD(&HTIM_ERROR, TIM_MS_TO_TICKS(&HTIM_ERROR, dt));
-    __HAL_TIM_CLEAR_FLAG(&HTIM_ERROR, TIM_IT_CC1);
+    __HAL_TIM_SET_AUTORELOAD(&HTIM_ERROR, MAINBOARD_MAX(1U, TIM_MS_TO_TICKS(&HTIM_ERROR, dt)));
+    __HAL_TIM_CLEAR_FLAG(&HTIM_ERROR, TIM_FLAG_UPDATE);
     HAL_TIM_Base_Start_IT(&HTIM_ERROR);
 }
 
@@ -538,9 +601,28 @@ void tim_stop_error_timer(void) {
     HAL_TIM_Base_Stop_IT(&HTIM_ERROR);
 }
 
+uint32_t tim_get_time_us(void) {
+    uint32_t ms, us;
+    FlagStatus elapsed;
+    // Read again if the tick is incremented in the meantime
+    do {
+        ms = timebase_get_time();
+        us = __HAL_TIM_GET_COUNTER(&HTIM_TIMEBASE);
+        elapsed = __HAL_TIM_GET_FLAG(&HTIM_TIMEBASE, TIM_FLAG_UPDATE) ? SET : RESET;
+    } while (ms != timebase_get_time() || __HAL_TIM_GET_COUNTER(&HTIM_TIMEBASE) < us);
+
+    /*
+     * The counter has already restarted but the tick is still pending (e.g. inside an interrupt),
+     * a counter near the end of the period means that it restarted after it was read
+     */
+    if (elapsed == SET && us < (__HAL_TIM_GET_AUTORELOAD(&HTIM_TIMEBASE) + 1U) / 2U)
+        ++ms;
+    return ms * 1000U + us;
+}
+
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef * htim) {
     if (htim->Instance == HTIM_ERROR.Instance) {
-        // error_handler_error_expire();
+        error_expire();
     }
     else if (htim->Instance == HTIM_TIMEBASE.Instance) {
         timebase_inc_tick();
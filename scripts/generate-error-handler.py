@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+
+"""
+Generate the constant tables of the error handler from the errors JSON file
+
+The group enum, the number of instances, the timeouts, the thresholds, the names
+and the layout of the instances data are written to a header and a source file inside the
+errors folders of the BMS so that the error handler has nothing to set up at
+runtime and can not drift from the JSON definition
+"""
+
+import json
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+HEADER_PATH = ROOT / 'Core' / 'Inc' / 'bms' / 'errors' / 'error-data.h'
+SOURCE_PATH = ROOT / 'Core' / 'Src' / 'bms' / 'errors' / 'error-data.c'
+
+# The output only depends on the JSON file so it can be regenerated by the build
+AUTHOR = 'agent [agent@local]'
+DATE = '2026-10-18'
+KEYS = { 'name', 'timeout', 'description', 'instances' }
+OPTIONAL_KEYS = { 'threshold' }
+NAME_REGEX = re.compile(r'^[A-Z][A-Z0-9_]*$')
+UINT8_MAX = 0xFF
+UINT16_MAX = 0xFFFF
+GROUP_COUNT_MAX = 32
+
+
+def fail(message):
+    print(f'[ERROR]: {message}', file=sys.stderr)
+    sys.exit(1)
+
+
+def load(path):
+    """Read and validate the error groups"""
+    with open(path, encoding='utf-8') as f:
+        errors = json.load(f).get('errors')
+    if not isinstance(errors, list) or not errors:
+        fail('the file must contain a non empty "errors" list')
+    if len(errors) > GROUP_COUNT_MAX:
+        fail(f'at most {GROUP_COUNT_MAX} groups are allowed')
+
+    names = set()
+    for i, error in enumerate(errors):
+        keys = set(error)
+        if not KEYS <= keys <= KEYS | OPTIONAL_KEYS:
+            missing = ', '.join(sorted(KEYS - keys))
+            unknown = ', '.join(sorted(keys - KEYS - OPTIONAL_KEYS))
+            fail(f'group {i} has missing keys [{missing}] and unknown keys [{unknown}]')
+
+        name = error['name']
+        if not isinstance(name, str) or not NAME_REGEX.match(name):
+            fail(f'group {i} has an invalid name "{name}"')
+        if name in names:
+            fail(f'group {name} is defined more than once')
+        names.add(name)
+
+        timeout = error['timeout']
+        if not isinstance(timeout, int) or not 0 <= timeout <= UINT16_MAX:
+            fail(f'group {name} has an invalid timeout {timeout}')
+
+        threshold = error.get('threshold', 1)
+        if isinstance(threshold, bool) or not isinstance(threshold, int) or not 1 <= threshold <= UINT8_MAX:
+            fail(f'group {name} has an invalid threshold {threshold}')
+
+        instances = error['instances']
+        if isinstance(instances, bool) or not (
+            (isinstance(instances, int) and 0 < instances <= UINT16_MAX) or
+            (isinstance(instances, str) and NAME_REGEX.match(instances))):
+            fail(f'group {name} has an invalid number of instances {instances}')
+
+        if not isinstance(error['description'], str) or not error['description'].strip():
+            fail(f'group {name} has an empty description')
+    return errors
+
+
+def instance_count(error):
+    instances = error['instances']
+    return f'{instances}U' if isinstance(instances, int) else instances
+
+
+def threshold(error):
+    return error.get('threshold', 1)
+
+
+def counter_count(error):
+    """Only the instances of the groups with a threshold need a counter"""
+    return f'ERROR_{error["name"]}_INSTANCE_COUNT' if threshold(error) > 1 else '0U'
+
+
+def offsets(errors, name, size):
+    """Chain the offsets of the data of each group inside a shared array"""
+    lines = []
+    previous = None
+    for e in errors:
+        if previous is None:
+            offset = '0U'
+        else:
+            offset = f'ERROR_{previous["name"]}_{name}_OFFSET + {size(previous)}'
+        lines.append(f'#define ERROR_{e["name"]}_{name}_OFFSET ({offset})')
+        previous = e
+    return lines
+
+
+def header(errors, json_name):
+    last = errors[-1]['name']
+    lines = [
+        '/**',
+        ' * @file error-data.h',
+        f' * @date {DATE}',
+        f' * @author {AUTHOR}',
+        ' *',
+        ' * @brief Error groups and their constant properties',
+        ' *',
+        f' * @attention This file is generated from {json_name} by the',
+        ' * generate-error-handler.py script, do not modify it manually',
+        ' */',
+        '',
+        '#ifndef ERROR_DATA_H',
+        '#define ERROR_DATA_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        '#include "mainboard-def.h"',
+        '',
+        '#include "bms_network.h"',
+        '',
+        '/** @brief Error instances count for each group */',
+    ]
+    lines += [f'#define ERROR_{e["name"]}_INSTANCE_COUNT ({instance_count(e)})' for e in errors]
+    lines += [
+        '',
+        '/** @brief Number of 32-bit words needed to store the flags of a group of instances */',
+        '#define ERROR_BITSET_SIZE(COUNT) (((COUNT) + 31U) / 32U)',
+        '',
+        '/** @brief Index of the first 32-bit word of each group inside the instances flags */',
+    ]
+    lines += offsets(errors, 'BITSET', lambda e: f'ERROR_BITSET_SIZE(ERROR_{e["name"]}_INSTANCE_COUNT)')
+    lines += [
+        '',
+        '/** @brief Number of 32-bit words needed to store the flags of all the groups */',
+        f'#define ERROR_BITSET_TOTAL_SIZE (ERROR_{last}_BITSET_OFFSET + '
+        f'ERROR_BITSET_SIZE(ERROR_{last}_INSTANCE_COUNT))',
+        '',
+        '/** @brief Number of set counters of each group, only the groups with a threshold have them */',
+    ]
+    lines += [f'#define ERROR_{e["name"]}_COUNTER_COUNT ({counter_count(e)})' for e in errors]
+    lines += [
+        '',
+        '/** @brief Index of the first set counter of each group */',
+    ]
+    lines += offsets(errors, 'COUNTER', lambda e: f'ERROR_{e["name"]}_COUNTER_COUNT')
+    lines += [
+        '',
+        '/** @brief Total number of set counters of all the groups */',
+        f'#define ERROR_COUNTER_TOTAL_COUNT (ERROR_{last}_COUNTER_OFFSET + ERROR_{last}_COUNTER_COUNT)',
+        '',
+        '/**',
+        ' * @brief Type of the error that categorize a group of instances',
+        ' *',
+        ' * @details',
+    ]
+    lines += [f' *     - ERROR_GROUP_{e["name"]} {e["description"]}' for e in errors]
+    lines += [
+        ' */',
+        'typedef enum {',
+    ]
+    lines += [f'    ERROR_GROUP_{e["name"]},' for e in errors]
+    lines += [
+        '    ERROR_GROUP_COUNT',
+        '} ErrorGroup;',
+        '',
+        '/** @brief Total number of instances for each group */',
+        'extern const uint16_t error_instances[ERROR_GROUP_COUNT];',
+        '',
+        '/**',
+        ' * @brief Time in ms after which each group expires',
+        ' *',
+        ' * @details A group with a zero timeout expires as soon as one of its instances is set',
+        ' */',
+        'extern const uint16_t error_timeouts[ERROR_GROUP_COUNT];',
+        '',
+        '/**',
+        ' * @brief Number of consecutive sets after which an instance of each group becomes active',
+        ' *',
+        ' * @details The instances of a group without a threshold become active as soon as they are set',
+        ' */',
+        'extern const uint8_t error_thresholds[ERROR_GROUP_COUNT];',
+        '',
+        '/** @brief Index of the first 32-bit word of each group inside the instances flags */',
+        'extern const uint16_t error_bitset_offsets[ERROR_GROUP_COUNT];',
+        '',
+        '/** @brief Index of the first set counter of each group */',
+        'extern const uint16_t error_counter_offsets[ERROR_GROUP_COUNT];',
+        '',
+        '/** @brief Human readable name of each group */',
+        'extern const char * const error_group_names[ERROR_GROUP_COUNT];',
+        '',
+        '#endif  // ERROR_DATA_H',
+    ]
+    return lines
+
+
+def table(errors, declaration, value):
+    lines = [f'{declaration} = {{']
+    lines += [f'    [ERROR_GROUP_{e["name"]}] = {value(e)},' for e in errors]
+    lines[-1] = lines[-1].rstrip(',')
+    lines.append('};')
+    return lines
+
+
+def source(errors, json_name):
+    lines = [
+        '/**',
+        ' * @file error-data.c',
+        f' * @date {DATE}',
+        f' * @author {AUTHOR}',
+        ' *',
+        ' * @brief Error groups and their constant properties',
+        ' *',
+        f' * @attention This file is generated from {json_name} by the',
+        ' * generate-error-handler.py script, do not modify it manually',
+        ' */',
+        '',
+        '#include "error-data.h"',
+        '',
+        '#include "mainboard-conf.h"',
+        '',
+        '#ifdef CONF_ERROR_MODULE_ENABLE',
+        '',
+        f'_Static_assert(ERROR_GROUP_COUNT <= {GROUP_COUNT_MAX}U, "The running groups must fit a 32-bit flag");',
+        '_Static_assert(ERROR_BITSET_TOTAL_SIZE <= UINT16_MAX, "The instances flags must be indexed by a 16-bit offset");',
+        '_Static_assert(ERROR_COUNTER_TOTAL_COUNT <= UINT16_MAX, "The set counters must be indexed by a 16-bit offset");',
+    ]
+    for e in errors:
+        count = f'ERROR_{e["name"]}_INSTANCE_COUNT'
+        lines.append(f'_Static_assert({count} > 0U && {count} <= UINT16_MAX, '
+                     f'"Invalid number of instances of the {e["name"]} group");')
+    lines.append('')
+    lines += table(errors, 'const uint16_t error_instances[ERROR_GROUP_COUNT]',
+                   lambda e: f'ERROR_{e["name"]}_INSTANCE_COUNT')
+    lines.append('')
+    lines += table(errors, 'const uint16_t error_timeouts[ERROR_GROUP_COUNT]',
+                   lambda e: f'{e["timeout"]}U')
+    lines.append('')
+    lines += table(errors, 'const uint8_t error_thresholds[ERROR_GROUP_COUNT]',
+                   lambda e: f'{threshold(e)}U')
+    lines.append('')
+    lines += table(errors, 'const uint16_t error_bitset_offsets[ERROR_GROUP_COUNT]',
+                   lambda e: f'ERROR_{e["name"]}_BITSET_OFFSET')
+    lines.append('')
+    lines += table(errors, 'const uint16_t error_counter_offsets[ERROR_GROUP_COUNT]',
+                   lambda e: f'ERROR_{e["name"]}_COUNTER_OFFSET')
+    lines.append('')
+    lines += table(errors, 'const char * const error_group_names[ERROR_GROUP_COUNT]',
+                   lambda e: '"' + e['name'].lower().replace('_', ' ') + '"')
+    lines += [
+        '',
+        '#endif  // CONF_ERROR_MODULE_ENABLE',
+    ]
+    return lines
+
+
+def main():
+    if len(sys.argv) != 2 or not Path(sys.argv[1]).is_file():
+        print('[ERROR]: Incorrect number of parameters', file=sys.stderr)
+        print(f'Usage: {Path(sys.argv[0]).name} json-file', file=sys.stderr)
+        sys.exit(1)
+
+    path = Path(sys.argv[1])
+    errors = load(path)
+    HEADER_PATH.write_text('\n'.join(header(errors, path.name)) + '\n', encoding='utf-8')
+    SOURCE_PATH.write_text('\n'.join(source(errors, path.name)) + '\n', encoding='utf-8')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,40 @@
+/**
+ * @file bms_network.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Subset of the bms canlib network used by the host tests
+ *
+ * @details Only the definitions used by the modules under test are declared,
+ * the real header is generated inside the canlib submodule
+ */
+
+#ifndef BMS_NETWORK_H
+#define BMS_NETWORK_H
+
+#include <stdint.h>
+
+typedef enum {
+    BMS_CELLBOARD_STATUS_STATUS_INIT_CHOICE,
+    BMS_CELLBOARD_STATUS_STATUS_IDLE_CHOICE,
+    BMS_CELLBOARD_STATUS_STATUS_FLASH_CHOICE,
+    BMS_CELLBOARD_STATUS_STATUS_BALANCING_CHOICE,
+    BMS_CELLBOARD_STATUS_STATUS_FATAL_CHOICE
+} bms_cellboard_status_status;
+
+typedef struct {
+    uint8_t cellboard_id;
+    bms_cellboard_status_status status;
+} bms_cellboard_status_converted_t;
+
+typedef enum {
+    bms_cellboard_error_group_open_wire,
+    bms_cellboard_error_group_other
+} bms_cellboard_error_group;
+
+typedef struct {
+    bms_cellboard_error_group group;
+    uint8_t cellboard_id;
+} bms_cellboard_error_t;
+
+#endif  // BMS_NETWORK_H
@@ -0,0 +1,29 @@
+/**
+ * @file mainboard-test.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Minimal helpers shared by the host tests
+ */
+
+#ifndef MAINBOARD_TEST_H
+#define MAINBOARD_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Check a condition and abort the test if it is false
+ *
+ * @param expression The condition to check
+ */
+#define TEST_ASSERT(expression) ((expression) ? \
+    (void)(0U) : \
+    test_assert_failed(#expression, __FILE__, __LINE__))
+
+static inline void test_assert_failed(const char * expression, const char * file, const int line) {
+    fprintf(stderr, "%s:%d: assertion failed: %s\n", file, line, expression);
+    exit(EXIT_FAILURE);
+}
+
+#endif  // MAINBOARD_TEST_H
@@ -0,0 +1,111 @@
+/**
+ * @file primary_network.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Subset of the primary canlib network used by the host tests
+ *
+ * @details Only the definitions used by the modules under test are declared,
+ * the real header is generated inside the canlib submodule
+ */
+
+#ifndef PRIMARY_NETWORK_H
+#define PRIMARY_NETWORK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PRIMARY_HV_FEEDBACK_ENZOMMA_INDEX (0)
+
+typedef uint8_t primary_hv_status_status;
+typedef uint8_t primary_hv_status_cellboard_0;
+typedef uint8_t primary_hv_status_cellboard_1;
+typedef uint8_t primary_hv_status_cellboard_2;
+typedef uint8_t primary_hv_status_cellboard_3;
+typedef uint8_t primary_hv_status_cellboard_4;
+typedef uint8_t primary_hv_status_cellboard_5;
+
+typedef struct {
+    primary_hv_status_status status;
+    primary_hv_status_cellboard_0 cellboard_0;
+    primary_hv_status_cellboard_1 cellboard_1;
+    primary_hv_status_cellboard_2 cellboard_2;
+    primary_hv_status_cellboard_3 cellboard_3;
+    primary_hv_status_cellboard_4 cellboard_4;
+    primary_hv_status_cellboard_5 cellboard_5;
+} primary_hv_status_converted_t;
+
+typedef struct {
+    bool ready;
+} primary_hv_flash_response_converted_t;
+
+typedef struct {
+    bool status;
+} primary_hv_set_status_ecu_converted_t;
+
+typedef struct {
+    bool status;
+} primary_hv_set_status_handcart_converted_t;
+
+typedef struct {
+    float ts;
+} primary_hv_ts_voltage_converted_t;
+
+typedef struct {
+    uint8_t feedback;
+} primary_hv_feedback_enzomma_converted_t;
+
+typedef uint8_t primary_hv_cells_resistance_cellboard_id;
+
+typedef struct {
+    primary_hv_cells_resistance_cellboard_id cellboard_id;
+    uint8_t offset;
+    uint8_t rank;
+    float resistance;
+    float ocv;
+} primary_hv_cells_resistance_converted_t;
+
+typedef struct {
+    float soc;
+    float soc_min;
+    float soc_max;
+} primary_hv_soc_estimation_converted_t;
+
+typedef uint8_t primary_hv_segment_soc_cellboard_id;
+
+typedef struct {
+    primary_hv_segment_soc_cellboard_id cellboard_id;
+    float soc;
+    float soc_std;
+} primary_hv_segment_soc_converted_t;
+
+typedef struct {
+    float inlet;
+    float outlet_0;
+    float outlet_1;
+    float outlet_2;
+    float outlet_3;
+    float outlet_4;
+    float outlet_5;
+} primary_hv_cooling_temperature_converted_t;
+
+typedef struct {
+    uint8_t group;
+    uint16_t instance;
+    uint8_t cellboard_group;
+    uint8_t cellboard_id;
+} primary_hv_error_converted_t;
+
+typedef struct {
+    uint8_t version;
+    uint8_t page;
+    bool last;
+    uint8_t group;
+    uint8_t expired_group;
+    float start_0;
+    float length_0;
+    float start_1;
+    float length_1;
+} primary_hv_error_report_converted_t;
+
+#endif  // PRIMARY_NETWORK_H
@@ -0,0 +1,27 @@
+/**
+ * @file error.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the error handler used by the cooling temperature host test
+ */
+
+#ifndef ERROR_H
+#define ERROR_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+typedef enum {
+    ERROR_OK
+} ErrorReturnCode;
+
+typedef enum {
+    ERROR_GROUP_COOLING_UNDER_TEMPERATURE,
+    ERROR_GROUP_COOLING_OVER_TEMPERATURE
+} ErrorGroup;
+
+ErrorReturnCode error_set(const ErrorGroup group, const size_t instance);
+ErrorReturnCode error_reset(const ErrorGroup group, const size_t instance);
+
+#endif  // ERROR_H
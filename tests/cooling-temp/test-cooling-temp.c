@@ -0,0 +1,82 @@
+/**
+ * @file test-cooling-temp.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Host test of the cooling temperature conversion
+ *
+ * @details The lookup table is compared with the double precision polynomial
+ * it is built from on a 0.1 mV grid that covers the whole voltage range
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "mainboard-test.h"
+
+#include "cooling-temp.h"
+#include "error.h"
+
+/** @brief Distance between two voltages of the comparison grid in V */
+#define TEST_GRID_STEP_V (0.1e-3)
+
+/** @brief Maximum allowed error from the polynomial over the whole range and inside the allowed temperatures in °C */
+#define TEST_ERROR_MAX_C (0.19)
+#define TEST_ERROR_IN_RANGE_MAX_C (0.03)
+
+/*** ######################### MODULE STUBS ################################ ***/
+
+ErrorReturnCode error_set(const ErrorGroup group, const size_t instance) {
+    MAINBOARD_UNUSED(group);
+    MAINBOARD_UNUSED(instance);
+    return ERROR_OK;
+}
+ErrorReturnCode error_reset(const ErrorGroup group, const size_t instance) {
+    MAINBOARD_UNUSED(group);
+    MAINBOARD_UNUSED(instance);
+    return ERROR_OK;
+}
+
+/*** ######################### TEST UTILITIES ############################## ***/
+
+/** @brief Convert a voltage with the module and read back the temperature */
+celsius_t test_convert(const volt_t value) {
+    TEST_ASSERT(cooling_temp_notify_conversion_complete(COOLING_TEMP_INDEX_INLET_LIQUID_TEMPERATURE, value) == COOLING_TEMP_OK);
+    return (*cooling_temp_get_values())[COOLING_TEMP_INDEX_INLET_LIQUID_TEMPERATURE];
+}
+
+/*** ######################### TEST CASES ################################## ***/
+
+/** @brief The lookup table stays within the documented error from the polynomial */
+void test_cooling_temp_error(void) {
+    double max_error = 0., max_in_range_error = 0.;
+    TEST_ASSERT(cooling_temp_init() == COOLING_TEMP_OK);
+
+    const size_t count = (size_t)((COOLING_TEMP_MAX_LIMIT_V - COOLING_TEMP_MIN_LIMIT_V) / TEST_GRID_STEP_V + 0.5);
+    for (size_t i = 0U; i <= count; ++i) {
+        const double value = COOLING_TEMP_MIN_LIMIT_V + i * TEST_GRID_STEP_V;
+        const double expected = COOLING_TEMP_POLYNOMIAL(value);
+        const double error = fabs(test_convert((volt_t)value) - expected);
+        max_error = fmax(max_error, error);
+        if (expected >= COOLING_TEMP_MIN_C && expected <= COOLING_TEMP_MAX_C)
+            max_in_range_error = fmax(max_in_range_error, error);
+    }
+    printf("max error       : %.4f C over the whole range, %.4f C inside the allowed temperatures\n", max_error, max_in_range_error);
+    TEST_ASSERT(max_error <= TEST_ERROR_MAX_C);
+    TEST_ASSERT(max_in_range_error <= TEST_ERROR_IN_RANGE_MAX_C);
+}
+
+/** @brief The voltages outside the limits are converted as the limits */
+void test_cooling_temp_limits(void) {
+    TEST_ASSERT(test_convert(COOLING_TEMP_MIN_LIMIT_V - 0.5f) == test_convert(COOLING_TEMP_MIN_LIMIT_V));
+    TEST_ASSERT(test_convert(COOLING_TEMP_MAX_LIMIT_V + 0.5f) == test_convert(COOLING_TEMP_MAX_LIMIT_V));
+    TEST_ASSERT(fabs(test_convert(COOLING_TEMP_MAX_LIMIT_V) - COOLING_TEMP_POLYNOMIAL(COOLING_TEMP_MAX_LIMIT_V)) <= 1e-3);
+}
+
+int main(void) {
+    test_cooling_temp_error();
+    test_cooling_temp_limits();
+    printf("cooling-temp: ok\n");
+    return EXIT_SUCCESS;
+}
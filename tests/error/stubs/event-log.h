@@ -0,0 +1,28 @@
+/**
+ * @file event-log.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the event log module used by the error host test
+ */
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <stdint.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+typedef enum {
+    EVENT_LOG_OK
+} EventLogReturnCode;
+
+typedef enum {
+    EVENT_LOG_TYPE_ERROR_SET,
+    EVENT_LOG_TYPE_ERROR_EXPIRED
+} EventLogType;
+
+EventLogReturnCode event_log_push(const EventLogType type, const uint8_t data_0, const uint16_t data_1);
+
+#endif  // EVENT_LOG_H
@@ -0,0 +1,24 @@
+/**
+ * @file tasks.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the tasks module used by the error host test
+ */
+
+#ifndef TASKS_H
+#define TASKS_H
+
+#include <stdbool.h>
+
+typedef enum {
+    TASKS_OK
+} TasksReturnCode;
+
+typedef enum {
+    TASKS_ID_SEND_ERRORS
+} TasksId;
+
+TasksReturnCode tasks_set_enable(const TasksId id, const bool enabled);
+
+#endif  // TASKS_H
@@ -0,0 +1,17 @@
+/**
+ * @file timebase.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the timebase module used by the error host test
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+milliseconds_t timebase_get_time(void);
+
+#endif  // TIMEBASE_H
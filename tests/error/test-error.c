@@ -0,0 +1,262 @@
+/**
+ * @file test-error.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Host test of the error handling
+ *
+ * @details The hardware timer is replaced by a variable that stores the time
+ * at which it should elapse, the test moves the time forward and calls
+ * error_expire when the timer elapses
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "mainboard-test.h"
+
+#include "error.h"
+#include "tasks.h"
+#include "timebase.h"
+#include "event-log.h"
+
+static milliseconds_t now;
+static bool timer_running;
+static milliseconds_t timer_deadline;
+static bool send_errors_enabled;
+static size_t expired_log_count;
+
+/*** ######################### STUBS ##################################### ***/
+
+milliseconds_t timebase_get_time(void) {
+    return now;
+}
+
+TasksReturnCode tasks_set_enable(const TasksId id, const bool enabled) {
+    if (id == TASKS_ID_SEND_ERRORS)
+        send_errors_enabled = enabled;
+    return TASKS_OK;
+}
+
+EventLogReturnCode event_log_push(const EventLogType type, const uint8_t data_0, const uint16_t data_1) {
+    if (type == EVENT_LOG_TYPE_ERROR_EXPIRED)
+        ++expired_log_count;
+    return EVENT_LOG_OK;
+}
+
+void test_cs_enter(void) { }
+void test_cs_exit(void) { }
+
+void test_update_timer(const uint32_t timestamp, const uint16_t timeout) {
+    timer_running = true;
+    timer_deadline = timestamp + timeout;
+}
+
+void test_stop_timer(void) {
+    timer_running = false;
+}
+
+/*** ######################### TEST UTILITIES ############################## ***/
+
+/** @brief Initialize the error handler and the fake timer at time zero */
+void test_init(void) {
+    now = 0U;
+    timer_running = false;
+    send_errors_enabled = false;
+    expired_log_count = 0U;
+    TEST_ASSERT(error_init(test_cs_enter, test_cs_exit, test_update_timer, test_stop_timer) == ERROR_OK);
+}
+
+/** @brief Move the time forward and expire the groups when the timer elapses */
+void test_advance(const milliseconds_t ms) {
+    for (milliseconds_t i = 0U; i < ms; ++i) {
+        ++now;
+        if (timer_running && now == timer_deadline)
+            error_expire();
+    }
+}
+
+/*** ######################### TESTS ##################################### ***/
+
+/** @brief An instance of a group with a threshold becomes active only after enough consecutive sets */
+void test_error_threshold(void) {
+    test_init();
+    const ErrorGroup group = ERROR_GROUP_CAN_COMMUNICATION;
+    for (size_t i = 1U; i < error_thresholds[group]; ++i) {
+        TEST_ASSERT(error_set(group, ERROR_CAN_COMMUNICATION_INSTANCE_BMS) == ERROR_OK);
+        TEST_ASSERT(!error_is_active(group, ERROR_CAN_COMMUNICATION_INSTANCE_BMS));
+    }
+    TEST_ASSERT(!timer_running);
+
+    error_set(group, ERROR_CAN_COMMUNICATION_INSTANCE_BMS);
+    TEST_ASSERT(error_is_active(group, ERROR_CAN_COMMUNICATION_INSTANCE_BMS));
+    TEST_ASSERT(error_get_active_count(group) == 1U);
+    TEST_ASSERT(timer_running && timer_deadline == now + error_timeouts[group]);
+}
+
+/** @brief A reset clears the consecutive sets of an instance that is not active yet */
+void test_error_threshold_reset(void) {
+    test_init();
+    const ErrorGroup group = ERROR_GROUP_OVER_CURRENT;
+    TEST_ASSERT(error_thresholds[group] == 2U);
+    for (size_t i = 0U; i < 10U; ++i) {
+        error_set(group, 0U);
+        error_reset(group, 0U);
+    }
+    TEST_ASSERT(!error_is_active(group, 0U));
+    TEST_ASSERT(!timer_running);
+
+    error_set(group, 0U);
+    error_set(group, 0U);
+    TEST_ASSERT(error_is_active(group, 0U));
+}
+
+/** @brief The instances of a group without a threshold become active as soon as they are set */
+void test_error_no_threshold(void) {
+    test_init();
+    const ErrorGroup group = ERROR_GROUP_UNDER_VOLTAGE;
+    TEST_ASSERT(error_thresholds[group] == 1U);
+    error_set(group, 3U);
+    TEST_ASSERT(error_is_active(group, 3U));
+    TEST_ASSERT(timer_running && timer_deadline == error_timeouts[group]);
+}
+
+/** @brief The timeout is restarted from the reset time when the instance that started it is reset */
+void test_error_rearm(void) {
+    test_init();
+    const ErrorGroup group = ERROR_GROUP_OVER_TEMPERATURE;
+    const milliseconds_t timeout = error_timeouts[group];
+
+    // Two instances alternate without ever being active together for the whole timeout
+    error_set(group, 5U);
+    test_advance(timeout / 2U);
+    error_set(group, 1U);
+    test_advance(timeout / 2U - 1U);
+    error_reset(group, 5U);
+    TEST_ASSERT(timer_running && timer_deadline == now + timeout);
+    test_advance(1U);
+    error_set(group, 9U);
+    test_advance(timeout / 2U - 2U);
+    error_reset(group, 1U);
+    const milliseconds_t rearm = now;
+    TEST_ASSERT(timer_running && timer_deadline == rearm + timeout);
+
+    // Resetting an instance that did not start the timeout keeps it
+    error_set(group, 0U);
+    error_reset(group, 0U);
+    TEST_ASSERT(timer_deadline == rearm + timeout);
+    TEST_ASSERT(!error_is_expired());
+
+    // The remaining instance expires a whole timeout after the reset
+    test_advance(timer_deadline - now);
+    TEST_ASSERT(error_is_expired());
+    const ErrorInfo info = error_get_expired_info();
+    TEST_ASSERT(info.group == group && info.instance == 9U);
+    TEST_ASSERT(info.timestamp == rearm);
+    TEST_ASSERT(send_errors_enabled && expired_log_count == 1U);
+    TEST_ASSERT(!timer_running);
+}
+
+/** @brief The expired instance is the one active for the longest time, not the first one */
+void test_error_expire_oldest(void) {
+    test_init();
+    const ErrorGroup group = ERROR_GROUP_UNDER_TEMPERATURE;
+    error_set(group, 7U);
+    test_advance(10U);
+    error_set(group, 2U);
+    test_advance(error_timeouts[group]);
+    TEST_ASSERT(error_is_expired());
+    TEST_ASSERT(error_get_expired_info().instance == 7U);
+}
+
+/** @brief A group with a zero timeout expires as soon as an instance becomes active */
+void test_error_zero_timeout(void) {
+    test_init();
+    const ErrorGroup group = ERROR_GROUP_CELLBOARD_ERROR;
+    TEST_ASSERT(error_timeouts[group] == 0U);
+    bms_cellboard_error_t payload = { .group = bms_cellboard_error_group_other, .cellboard_id = 4U };
+    error_cellboard_handle(&payload);
+    TEST_ASSERT(!error_is_expired());
+    error_cellboard_handle(&payload);
+    TEST_ASSERT(error_is_expired());
+    TEST_ASSERT(error_get_expired_info().instance == 4U);
+    TEST_ASSERT(expired_log_count == 1U);
+}
+
+/** @brief The timer is stopped when the last instance of the last running group is reset */
+void test_error_stop(void) {
+    test_init();
+    error_set(ERROR_GROUP_OVER_VOLTAGE, 0U);
+    error_set(ERROR_GROUP_UNDER_VOLTAGE, 1U);
+    error_reset(ERROR_GROUP_OVER_VOLTAGE, 0U);
+    TEST_ASSERT(timer_running);
+    error_reset(ERROR_GROUP_UNDER_VOLTAGE, 1U);
+    TEST_ASSERT(!timer_running);
+    TEST_ASSERT(error_set(ERROR_GROUP_POST, error_instances[ERROR_GROUP_POST]) == ERROR_OUT_OF_BOUNDS);
+}
+
+/** @brief The report contains the runs of active instances and its pages end with the last flag */
+void test_error_report(void) {
+    test_init();
+    error_set(ERROR_GROUP_UNDER_VOLTAGE, 3U);
+    error_set(ERROR_GROUP_UNDER_VOLTAGE, 4U);
+    error_set(ERROR_GROUP_UNDER_VOLTAGE, 5U);
+    error_set(ERROR_GROUP_UNDER_VOLTAGE, 9U);
+    test_advance(ERROR_REPORT_MIN_INTERVAL_MS);
+
+    size_t byte_size = 0U;
+    const primary_hv_error_report_converted_t * payload = error_get_error_report_canlib_payload(&byte_size);
+    TEST_ASSERT(payload != NULL && byte_size == sizeof(*payload));
+    TEST_ASSERT(payload->page == 0U && payload->last);
+    TEST_ASSERT(payload->group == ERROR_GROUP_UNDER_VOLTAGE);
+    TEST_ASSERT(payload->start_0 == 3U && payload->length_0 == 3U);
+    TEST_ASSERT(payload->start_1 == 9U && payload->length_1 == 1U);
+    TEST_ASSERT(payload->expired_group == ERROR_GROUP_COUNT);
+
+    // The expiration of the group is a change
+    test_advance(error_timeouts[ERROR_GROUP_UNDER_VOLTAGE] - ERROR_REPORT_MIN_INTERVAL_MS);
+    TEST_ASSERT(error_is_expired());
+    payload = error_get_error_report_canlib_payload(NULL);
+    TEST_ASSERT(payload != NULL && payload->expired_group == ERROR_GROUP_UNDER_VOLTAGE);
+
+    // Nothing changed so the report is sent again only after the keep alive time
+    test_advance(ERROR_REPORT_KEEP_ALIVE_MS - 1U);
+    TEST_ASSERT(error_get_error_report_canlib_payload(NULL) == NULL);
+    test_advance(1U);
+    TEST_ASSERT(error_get_error_report_canlib_payload(NULL) != NULL);
+}
+
+/** @brief An instance that changes continuously starts a report at most once every minimum interval */
+void test_error_report_rate(void) {
+    test_init();
+    const milliseconds_t duration = 2000U;
+    size_t reports = 0U;
+    for (milliseconds_t i = 0U; i < duration; ++i) {
+        if (i % 2U == 0U)
+            error_set(ERROR_GROUP_OVER_VOLTAGE, 0U);
+        else
+            error_reset(ERROR_GROUP_OVER_VOLTAGE, 0U);
+        if (i % ERROR_REPORT_INTERVAL_MS == 0U) {
+            const primary_hv_error_report_converted_t * const payload = error_get_error_report_canlib_payload(NULL);
+            if (payload != NULL && payload->page == 0U)
+                ++reports;
+        }
+        test_advance(1U);
+    }
+    TEST_ASSERT(reports <= duration / ERROR_REPORT_MIN_INTERVAL_MS);
+    TEST_ASSERT(reports >= duration / ERROR_REPORT_MIN_INTERVAL_MS - 1U);
+}
+
+int main(void) {
+    test_error_threshold();
+    test_error_threshold_reset();
+    test_error_no_threshold();
+    test_error_rearm();
+    test_error_expire_oldest();
+    test_error_zero_timeout();
+    test_error_stop();
+    test_error_report();
+    test_error_report_rate();
+    printf("error: ok\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file test-freshness.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Host test of the freshness and sweep tracking
+ *
+ * @details The cells voltages are received in groups of three with the
+ * cellboards transmitting in order or at random, the age of the oldest value
+ * is compared with a full scan of the update times after every message
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mainboard-test.h"
+
+#include "freshness.h"
+
+/** @brief Number of values updated by a single message */
+#define TEST_GROUP_SIZE (3U)
+/** @brief Number of messages received by each test */
+#define TEST_MESSAGE_COUNT (20000U)
+
+static bit_flag32_t fresh[FRESHNESS_WORD_COUNT(CELLBOARD_SERIES_COUNT)];
+static ticks_t last_update[CELLBOARD_SERIES_COUNT];
+static Freshness freshness;
+
+/*** ######################### TEST UTILITIES ############################## ***/
+
+/** @brief Get the age of the oldest value with a full scan */
+ticks_t test_oldest_age(const ticks_t now) {
+    ticks_t age = 0U;
+    for (size_t i = 0U; i < CELLBOARD_SERIES_COUNT; ++i)
+        age = MAINBOARD_MAX(age, now - last_update[i]);
+    return age;
+}
+
+/** @brief Receive a group of values and check the tracked data against a full scan */
+bool test_receive(const size_t group, const ticks_t now) {
+    const bool sweep = freshness_update(&freshness, group * TEST_GROUP_SIZE, TEST_GROUP_SIZE, now);
+    TEST_ASSERT(freshness_get_oldest_age(&freshness, now) == test_oldest_age(now));
+    TEST_ASSERT(freshness_get_age(&freshness, group * TEST_GROUP_SIZE, now) == 0U);
+    return sweep;
+}
+
+/*** ######################### TESTS ##################################### ***/
+
+/** @brief A sweep is completed once per round when the groups are received in order */
+void test_freshness_in_order(void) {
+    freshness_init(&freshness, fresh, last_update, CELLBOARD_SERIES_COUNT);
+    const size_t groups = CELLBOARD_SERIES_COUNT / TEST_GROUP_SIZE;
+
+    ticks_t now = 0U;
+    for (size_t i = 0U; i < TEST_MESSAGE_COUNT; ++i) {
+        now += 1U;
+        const size_t group = i % groups;
+        const bool sweep = test_receive(group, now);
+        TEST_ASSERT(sweep == (group == groups - 1U));
+        if (sweep)
+            TEST_ASSERT(freshness.sweep_time == now);
+        else
+            TEST_ASSERT(freshness_is_fresh(&freshness, group * TEST_GROUP_SIZE));
+    }
+    TEST_ASSERT(freshness.sweep == TEST_MESSAGE_COUNT / groups);
+}
+
+/** @brief Groups received since the end of the last sweep by the random test */
+static bool received[CELLBOARD_SERIES_COUNT / TEST_GROUP_SIZE];
+static size_t received_count;
+
+/** @brief Receive a group and check the end of the sweep against the received groups */
+void test_receive_random(const size_t group, const ticks_t now) {
+    const size_t groups = CELLBOARD_SERIES_COUNT / TEST_GROUP_SIZE;
+    if (!received[group]) {
+        received[group] = true;
+        ++received_count;
+    }
+    const uint32_t sweep = freshness.sweep;
+    const bool completed = test_receive(group, now);
+    TEST_ASSERT(completed == (received_count == groups));
+    TEST_ASSERT(freshness.sweep == sweep + (completed ? 1U : 0U));
+    if (completed) {
+        memset(received, 0U, sizeof(received));
+        received_count = 0U;
+    }
+}
+
+/** @brief The oldest value is tracked with random arrivals and a tick counter overflow */
+void test_freshness_random(void) {
+    freshness_init(&freshness, fresh, last_update, CELLBOARD_SERIES_COUNT);
+    const size_t groups = CELLBOARD_SERIES_COUNT / TEST_GROUP_SIZE;
+
+    // The values are considered updated at time zero so the counter starts right after
+    ticks_t now = 1U;
+    srand(1U);
+    for (size_t i = 0U; i < TEST_MESSAGE_COUNT; ++i) {
+        now += 1U + rand() % 3U;
+        test_receive_random(rand() % groups, now);
+
+        // Jump close to the overflow of the tick counter in the middle of the test
+        if (i == TEST_MESSAGE_COUNT / 2U) {
+            now = (ticks_t)-50;
+            for (size_t group = 0U; group < groups; group += 2U)
+                test_receive_random(group, now);
+        }
+    }
+    TEST_ASSERT(freshness.sweep > 0U);
+}
+
+/** @brief The invalid ranges and indices are rejected */
+void test_freshness_bounds(void) {
+    freshness_init(&freshness, fresh, last_update, CELLBOARD_SERIES_COUNT);
+    TEST_ASSERT(!freshness_update(&freshness, CELLBOARD_SERIES_COUNT - 1U, 2U, 10U));
+    TEST_ASSERT(!freshness_is_fresh(&freshness, CELLBOARD_SERIES_COUNT - 1U));
+    TEST_ASSERT(!freshness_is_fresh(&freshness, CELLBOARD_SERIES_COUNT));
+    TEST_ASSERT(freshness_get_age(&freshness, CELLBOARD_SERIES_COUNT, 10U) == 0U);
+    TEST_ASSERT(freshness_get_oldest_age(&freshness, 10U) == 10U);
+}
+
+int main(void) {
+    test_freshness_in_order();
+    test_freshness_random();
+    test_freshness_bounds();
+    printf("freshness: ok\n");
+    return EXIT_SUCCESS;
+}
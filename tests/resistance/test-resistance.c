@@ -0,0 +1,194 @@
+/**
+ * @file test-resistance.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Host test of the internal resistance estimator with synthetic data
+ *
+ * @details Every cell is simulated as OCV - R * I plus the measurement noise,
+ * with a random current profile and an open circuit voltage that slowly drops
+ * while the pack is discharged
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "mainboard-test.h"
+
+#include "resistance.h"
+
+/** @brief Number of voltage samples of each cell */
+#define TEST_SAMPLE_COUNT (2000U)
+/** @brief Number of samples after which the current changes */
+#define TEST_CURRENT_STEP (20U)
+/** @brief Peak of the uniform voltage noise in V */
+#define TEST_NOISE_V (0.5e-3f)
+/** @brief Drop of the open circuit voltage for each Ah drawn from the pack */
+#define TEST_OCV_DROP_V_AH (0.05f)
+/** @brief Average of the random current profile in A */
+#define TEST_CURRENT_AVERAGE_A (50.f)
+/** @brief Time between two samples of the same cell in s */
+#define TEST_SAMPLE_PERIOD_S (0.1f)
+
+/** @brief Maximum allowed relative error of the resistance and error of the open circuit voltage in V */
+#define TEST_RESISTANCE_TOLERANCE (0.05f)
+#define TEST_OCV_TOLERANCE (2e-3f)
+/**
+ * @brief Lag of the estimated open circuit voltage while it drops with the discharge in V
+ *
+ * @details The forgetting factor averages the samples over about 1 / (1 - LAMBDA)
+ * updates so the estimation follows a drop of D volts per update with a lag of
+ * D * LAMBDA / (1 - LAMBDA)
+ */
+#define TEST_OCV_LAG (TEST_OCV_DROP_V_AH * TEST_CURRENT_AVERAGE_A * TEST_SAMPLE_PERIOD_S / 3600.f * \
+    RESISTANCE_FORGETTING_FACTOR / (1.f - RESISTANCE_FORGETTING_FACTOR))
+
+/** @brief Cells with a resistance higher than the others, in descending order */
+static const size_t worst[RESISTANCE_WORST_COUNT] = { 100U, 7U, 60U, 131U };
+
+static float resistance[CELLBOARD_SERIES_COUNT];
+static float ocv[CELLBOARD_SERIES_COUNT];
+static float current;
+static float ocv_drop;
+
+/*** ######################### TEST UTILITIES ############################## ***/
+
+float test_random(const float min, const float max) {
+    return min + (max - min) * (rand() / (float)RAND_MAX);
+}
+
+/** @brief Generate the cells parameters and initialize the module */
+void test_setup(void) {
+    srand(42U);
+    for (size_t i = 0U; i < CELLBOARD_SERIES_COUNT; ++i) {
+        resistance[i] = test_random(2.5e-3f, 3.5e-3f);
+        ocv[i] = test_random(3.9f, 4.1f);
+    }
+    for (size_t i = 0U; i < RESISTANCE_WORST_COUNT; ++i)
+        resistance[worst[i]] = 6e-3f - i * 0.5e-3f;
+    current = 0.f;
+    ocv_drop = 0.f;
+    TEST_ASSERT(resistance_init() == RESISTANCE_OK);
+}
+
+/**
+ * @brief Feed the same current to every cell of the pack for a number of samples
+ *
+ * @param count The number of samples of each cell
+ * @param random True to change the current every TEST_CURRENT_STEP samples
+ */
+void test_feed(const size_t count, const bool random) {
+    for (size_t s = 0U; s < count; ++s) {
+        if (random && s % TEST_CURRENT_STEP == 0U)
+            current = test_random(TEST_CURRENT_AVERAGE_A - 100.f, TEST_CURRENT_AVERAGE_A + 100.f);
+        for (size_t i = 0U; i < CELLBOARD_SERIES_COUNT; ++i) {
+            ocv[i] -= ocv_drop * current * TEST_SAMPLE_PERIOD_S / 3600.f;
+            const float voltage = ocv[i] - resistance[i] * current + test_random(-TEST_NOISE_V, TEST_NOISE_V);
+            const CellboardId id = (CellboardId)(i / CELLBOARD_SEGMENT_SERIES_COUNT);
+            TEST_ASSERT(resistance_update(id, i % CELLBOARD_SEGMENT_SERIES_COUNT, voltage, current) == RESISTANCE_OK);
+        }
+    }
+}
+
+/**
+ * @brief Check the estimation of every cell
+ *
+ * @param name The name of the test case that is printed with the errors
+ * @param ocv_tolerance The maximum allowed error of the open circuit voltage in V
+ */
+void test_check_estimation(const char * const name, const float ocv_tolerance) {
+    float max_error = 0.f, max_ocv_error = 0.f;
+    for (size_t i = 0U; i < CELLBOARD_SERIES_COUNT; ++i) {
+        const CellboardId id = (CellboardId)(i / CELLBOARD_SEGMENT_SERIES_COUNT);
+        const size_t offset = i % CELLBOARD_SEGMENT_SERIES_COUNT;
+        float r = 0.f;
+        volt_t v = 0.f;
+        TEST_ASSERT(resistance_get_resistance(id, offset, &r) == RESISTANCE_OK);
+        TEST_ASSERT(resistance_get_ocv(id, offset, &v) == RESISTANCE_OK);
+        max_error = fmaxf(max_error, fabsf(r - resistance[i]) / resistance[i]);
+        max_ocv_error = fmaxf(max_ocv_error, fabsf(v - ocv[i]));
+    }
+    printf("%-16s: max resistance error %.2f%%, max OCV error %.2f mV\n", name, max_error * 100.f, max_ocv_error * 1000.f);
+    TEST_ASSERT(max_error <= TEST_RESISTANCE_TOLERANCE);
+    TEST_ASSERT(max_ocv_error <= ocv_tolerance);
+}
+
+/*** ######################### TEST CASES ################################## ***/
+
+/** @brief The estimation is not available before the minimum number of updates */
+void test_resistance_not_ready(void) {
+    float r = 0.f;
+    test_setup();
+    TEST_ASSERT(resistance_get_resistance(CELLBOARD_ID_0, 0U, &r) == RESISTANCE_NOT_READY);
+    test_feed(RESISTANCE_MIN_UPDATE_COUNT - 1U, true);
+    TEST_ASSERT(resistance_get_resistance(CELLBOARD_ID_0, 0U, &r) == RESISTANCE_NOT_READY);
+    TEST_ASSERT(resistance_get_worst(RESISTANCE_WORST_COUNT, (size_t [RESISTANCE_WORST_COUNT]){ 0U }) == 0U);
+    test_feed(1U, true);
+    TEST_ASSERT(resistance_get_resistance(CELLBOARD_ID_0, 0U, &r) == RESISTANCE_OK);
+
+    TEST_ASSERT(resistance_update(CELLBOARD_ID_COUNT, 0U, 4.f, 0.f) == RESISTANCE_OUT_OF_BOUNDS);
+    TEST_ASSERT(resistance_update(CELLBOARD_ID_0, CELLBOARD_SEGMENT_SERIES_COUNT, 4.f, 0.f) == RESISTANCE_OUT_OF_BOUNDS);
+    TEST_ASSERT(resistance_get_resistance(CELLBOARD_ID_0, 0U, NULL) == RESISTANCE_OUT_OF_BOUNDS);
+}
+
+/** @brief The estimation converges with a varying current */
+void test_resistance_convergence(void) {
+    test_setup();
+    test_feed(TEST_SAMPLE_COUNT, true);
+    test_check_estimation("random current", TEST_OCV_TOLERANCE);
+
+    // The open circuit voltage drops while the pack is discharged
+    test_setup();
+    ocv_drop = TEST_OCV_DROP_V_AH;
+    test_feed(TEST_SAMPLE_COUNT, true);
+    test_check_estimation("discharge", TEST_OCV_LAG + TEST_OCV_TOLERANCE);
+}
+
+/** @brief The estimation stays stable while the current is constant and then tracks a new value */
+void test_resistance_constant_current(void) {
+    test_setup();
+    test_feed(TEST_SAMPLE_COUNT, true);
+
+    // Without excitation the covariance would wind up if the forgetting was not disabled
+    current = 30.f;
+    test_feed(10U * TEST_SAMPLE_COUNT, false);
+    test_check_estimation("constant current", TEST_OCV_TOLERANCE);
+
+    // The resistance grows with the temperature drop and is tracked again, slower than at startup
+    for (size_t i = 0U; i < CELLBOARD_SERIES_COUNT; ++i)
+        resistance[i] *= 1.2f;
+    test_feed(2U * TEST_SAMPLE_COUNT, true);
+    test_check_estimation("resistance step", TEST_OCV_TOLERANCE);
+}
+
+/** @brief The cells with the highest resistance are found in descending order */
+void test_resistance_worst(void) {
+    size_t out[RESISTANCE_WORST_COUNT] = { 0U };
+    test_setup();
+    test_feed(TEST_SAMPLE_COUNT, true);
+
+    TEST_ASSERT(resistance_get_worst(RESISTANCE_WORST_COUNT, out) == RESISTANCE_WORST_COUNT);
+    for (size_t i = 0U; i < RESISTANCE_WORST_COUNT; ++i)
+        TEST_ASSERT(out[i] == worst[i]);
+
+    // The payload is sent in mOhm one rank at a time
+    for (size_t i = 0U; i < RESISTANCE_WORST_COUNT; ++i) {
+        size_t byte_size = 0U;
+        const primary_hv_cells_resistance_converted_t * const payload = resistance_get_cells_resistance_canlib_payload(&byte_size);
+        TEST_ASSERT(byte_size == sizeof(*payload));
+        TEST_ASSERT(payload->rank == i);
+        TEST_ASSERT(payload->cellboard_id * CELLBOARD_SEGMENT_SERIES_COUNT + payload->offset == worst[i]);
+        TEST_ASSERT(fabsf(payload->resistance - resistance[worst[i]] * 1000.f) <= TEST_RESISTANCE_TOLERANCE * resistance[worst[i]] * 1000.f);
+    }
+    TEST_ASSERT(resistance_get_cells_resistance_canlib_payload(NULL)->rank == 0U);
+}
+
+int main(void) {
+    test_resistance_not_ready();
+    test_resistance_convergence();
+    test_resistance_constant_current();
+    test_resistance_worst();
+    printf("resistance: ok\n");
+    return EXIT_SUCCESS;
+}
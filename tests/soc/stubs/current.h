@@ -0,0 +1,17 @@
+/**
+ * @file current.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the current module used by the SoC host test
+ */
+
+#ifndef CURRENT_H
+#define CURRENT_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+ampere_t current_get_current(void);
+
+#endif  // CURRENT_H
@@ -0,0 +1,30 @@
+/**
+ * @file volt.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the cells voltage module used by the SoC host test
+ */
+
+#ifndef VOLT_H
+#define VOLT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+typedef struct {
+    volt_t min;
+    volt_t max;
+    volt_t sum;
+    size_t min_index;
+    size_t max_index;
+} VoltAggregate;
+
+const VoltAggregate * volt_get_segment_aggregate(const CellboardId id);
+uint32_t volt_get_sweep_count(void);
+volt_t volt_get_avg(void);
+
+#endif  // VOLT_H
@@ -0,0 +1,219 @@
+/**
+ * @file test-soc.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Host test and benchmark of the state of charge estimator
+ *
+ * @details The segments are simulated with the OCV(SoC) - R * I model, the
+ * current sensor reception interrupt is emulated every 10 ms and the filters
+ * are updated every SOC_UPDATE_INTERVAL_MS as done by the UPDATE_SOC task
+ *
+ * @attention The timings are taken on the host, the cycle counts of the target
+ * can only be measured on the hardware
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "mainboard-test.h"
+
+#include "soc.h"
+#include "volt.h"
+#include "current.h"
+#include "timebase.h"
+
+/** @brief Period of the current sensor messages in ms */
+#define TEST_CURRENT_PERIOD_MS (10U)
+/** @brief Number of calls of each function for a single timing */
+#define TEST_ITERATIONS (1000000U)
+
+/** @brief Maximum allowed error of the state of charge */
+#define TEST_SOC_TOLERANCE (0.01f)
+
+/** @brief Open circuit voltage of the simulated cells, equally spaced from 0% to 100% */
+static const float ocv_table[] = {
+    3.00f, 3.45f, 3.55f, 3.62f, 3.68f, 3.75f, 3.84f, 3.93f, 4.02f, 4.10f, 4.20f
+};
+#define TEST_OCV_TABLE_SIZE (sizeof(ocv_table) / sizeof(ocv_table[0U]))
+
+static ticks_t now;
+static float current;
+static float soc[CELLBOARD_COUNT];
+static VoltAggregate aggregates[CELLBOARD_COUNT];
+static uint32_t sweep;
+static volatile float sink;
+
+/*** ######################### MODULE STUBS ################################ ***/
+
+ticks_t timebase_get_tick(void) { return now; }
+milliseconds_t timebase_get_resolution(void) { return 1U; }
+
+const VoltAggregate * volt_get_segment_aggregate(const CellboardId id) { return &aggregates[id]; }
+uint32_t volt_get_sweep_count(void) { return sweep; }
+volt_t volt_get_avg(void) { return aggregates[CELLBOARD_ID_0].sum / CELLBOARD_SEGMENT_SERIES_COUNT; }
+
+ampere_t current_get_current(void) { return current; }
+
+/*** ######################### TEST UTILITIES ############################## ***/
+
+volt_t test_ocv(const float value) {
+    const float pos = MAINBOARD_CLAMP(value, 0.f, 1.f) * (TEST_OCV_TABLE_SIZE - 1U);
+    const size_t i = MAINBOARD_MIN((size_t)pos, TEST_OCV_TABLE_SIZE - 2U);
+    return ocv_table[i] + (ocv_table[i + 1U] - ocv_table[i]) * (pos - i);
+}
+
+double test_now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/** @brief Update the voltages of the segments from the simulated state of charge */
+void test_update_voltages(void) {
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
+        const volt_t voltage = test_ocv(soc[id]) - SOC_GROUP_RESISTANCE_OHM * current;
+        aggregates[id].sum = voltage * CELLBOARD_SEGMENT_SERIES_COUNT;
+    }
+    sweep = 1U;
+}
+
+/** @brief Initialize the module with the pack at rest at the given state of charge */
+void test_setup(const float value) {
+    now = 0U;
+    current = 0.f;
+    sweep = 0U;
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id)
+        soc[id] = value + 0.01f * id;
+    memset(aggregates, 0U, sizeof(aggregates));
+    TEST_ASSERT(soc_init() == SOC_OK);
+}
+
+/**
+ * @brief Run the simulation with a constant current
+ *
+ * @param amps The current of the pack in A, positive during discharge
+ * @param bias The relative error of the current sensor
+ * @param duration The simulated time in ms
+ */
+void test_run(const ampere_t amps, const float bias, const milliseconds_t duration) {
+    current = amps;
+    for (milliseconds_t t = 0U; t < duration; t += TEST_CURRENT_PERIOD_MS) {
+        now += TEST_CURRENT_PERIOD_MS;
+        for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id)
+            soc[id] -= current * TEST_CURRENT_PERIOD_MS * 1e-3f / SOC_CAPACITY_AS;
+        soc_integrate_current(current * (1.f + bias), now);
+
+        if (now % SOC_UPDATE_INTERVAL_MS == 0U) {
+            test_update_voltages();
+            soc_update();
+        }
+    }
+}
+
+/** @brief Get the maximum error of the estimation of the segments */
+float test_get_error(void) {
+    float error = 0.f;
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
+        float value = 0.f;
+        TEST_ASSERT(soc_get_segment_soc(id, &value) == SOC_OK);
+        error = fmaxf(error, fabsf(value - soc[id]));
+    }
+    return error;
+}
+
+/*** ######################### TEST CASES ################################## ***/
+
+/** @brief The filters are initialized from the open circuit voltage after the first sweep */
+void test_soc_init(void) {
+    float value = 0.f;
+    test_setup(0.5f);
+    TEST_ASSERT(soc_get_segment_soc(CELLBOARD_ID_0, &value) == SOC_NOT_READY);
+    test_run(0.f, 0.f, SOC_UPDATE_INTERVAL_MS);
+    printf("init            : max error %.2f%%\n", test_get_error() * 100.f);
+    TEST_ASSERT(test_get_error() <= TEST_SOC_TOLERANCE);
+}
+
+/** @brief The extremes of the segments state of charge are found */
+void test_soc_extremes(void) {
+    test_setup(0.4f);
+    test_run(0.f, 0.f, SOC_UPDATE_INTERVAL_MS);
+
+    float min = 1.f, max = 0.f;
+    for (CellboardId id = CELLBOARD_ID_0; id < CELLBOARD_ID_COUNT; ++id) {
+        float value = 0.f;
+        TEST_ASSERT(soc_get_segment_soc(id, &value) == SOC_OK);
+        min = fminf(min, value);
+        max = fmaxf(max, value);
+    }
+    TEST_ASSERT(soc_get_min_segment_soc() == min);
+    TEST_ASSERT(soc_get_max_segment_soc() == max);
+    TEST_ASSERT(soc_get_min_segment_soc() < soc_get_soc() && soc_get_soc() < soc_get_max_segment_soc());
+}
+
+/** @brief The state of charge grows while charging */
+void test_soc_charge(void) {
+    test_setup(0.3f);
+    test_run(0.f, 0.f, SOC_UPDATE_INTERVAL_MS);
+    const float start = soc_get_soc();
+
+    // 5 minutes at 40 A
+    test_run(-40.f, 0.f, 300000U);
+    printf("charge          : %.2f%% -> %.2f%%, max error %.2f%%\n", start * 100.f, soc_get_soc() * 100.f, test_get_error() * 100.f);
+    TEST_ASSERT(soc_get_soc() > start);
+    TEST_ASSERT(test_get_error() <= TEST_SOC_TOLERANCE);
+}
+
+/** @brief The drift caused by a current sensor bias is corrected when the pack rests */
+void test_soc_bias(void) {
+    test_setup(0.9f);
+    test_run(0.f, 0.f, SOC_UPDATE_INTERVAL_MS);
+
+    // 10 minutes at 40 A with a current sensor that reads 5% more
+    test_run(40.f, 0.05f, 600000U);
+    const float load_error = test_get_error();
+
+    // The voltage is trusted only after SOC_REST_TIME_MS
+    test_run(0.f, 0.05f, SOC_REST_TIME_MS + 30000U);
+    const float rest_error = test_get_error();
+    printf("5%% sensor bias  : max error %.2f%% under load, %.2f%% after rest\n", load_error * 100.f, rest_error * 100.f);
+    TEST_ASSERT(rest_error <= TEST_SOC_TOLERANCE);
+    TEST_ASSERT(rest_error < load_error);
+}
+
+/** @brief Time the update of the filters and the integration of the current */
+void test_soc_benchmark(void) {
+    test_setup(0.5f);
+    test_run(20.f, 0.f, SOC_UPDATE_INTERVAL_MS);
+
+    double start = test_now_ns();
+    for (size_t i = 0U; i < TEST_ITERATIONS; ++i) {
+        now += SOC_UPDATE_INTERVAL_MS;
+        soc_update();
+    }
+    const double update = (test_now_ns() - start) / TEST_ITERATIONS;
+
+    start = test_now_ns();
+    for (size_t i = 0U; i < TEST_ITERATIONS; ++i) {
+        now += TEST_CURRENT_PERIOD_MS;
+        soc_integrate_current(current, now);
+    }
+    const double integrate = (test_now_ns() - start) / TEST_ITERATIONS;
+    sink = soc_get_soc();
+
+    printf("soc_update            : %.1f ns per call (%u segments)\n", update, CELLBOARD_COUNT);
+    printf("soc_integrate_current : %.1f ns per call\n", integrate);
+}
+
+int main(void) {
+    test_soc_init();
+    test_soc_extremes();
+    test_soc_charge();
+    test_soc_bias();
+    test_soc_benchmark();
+    printf("soc: ok\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file test-stats.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Host test and benchmark of the statistics module
+ *
+ * @details The portable backend of stats.c is compared with the CMSIS-DSP
+ * functions used by the target backend, both compiled with the host compiler,
+ * on arrays with the sizes used by the measurement modules
+ *
+ * @attention The timings are taken on the host and only give the relative cost
+ * of the two implementations, the cycle counts of the target can only be
+ * measured on the hardware where CMSIS-DSP uses the FPU and the unrolled loops
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "mainboard-test.h"
+
+#include "arm_math.h"
+#include "stats.h"
+
+/** @brief Number of calls of each function for a single timing */
+#define TEST_ITERATIONS (1000000U)
+/** @brief Relative tolerance of the comparison of the results */
+#define TEST_TOLERANCE (1e-5f)
+
+/** @brief Array sizes: cooling sensors, cells per segment, temperatures per segment, whole pack */
+static const size_t sizes[] = { 7U, 24U, 48U, 144U };
+
+static float data[144U];
+static volatile float sink;
+
+/*** ######################### TEST UTILITIES ############################## ***/
+
+/** @brief Fill the data with cell voltages around 3.6V */
+void test_fill(const size_t count) {
+    srand(count);
+    for (size_t i = 0U; i < count; ++i)
+        data[i] = 3.6f + (rand() % 1000 - 500) * 1e-4f;
+}
+
+bool test_equal(const float a, const float b) {
+    return fabsf(a - b) <= TEST_TOLERANCE * fmaxf(1.f, fabsf(b));
+}
+
+double test_now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/*** ######################### BENCHMARK FUNCTIONS ######################### ***/
+
+float bench_stats_min(const size_t count) { return stats_min_f32(data, count, NULL); }
+float bench_stats_max(const size_t count) { return stats_max_f32(data, count, NULL); }
+float bench_stats_mean(const size_t count) { return stats_mean_f32(data, count); }
+float bench_stats_std(const size_t count) { return stats_std_f32(data, count); }
+
+float bench_arm_min(const size_t count) {
+    float32_t min;
+    uint32_t index;
+    arm_min_f32(data, count, &min, &index);
+    return min;
+}
+float bench_arm_max(const size_t count) {
+    float32_t max;
+    uint32_t index;
+    arm_max_f32(data, count, &max, &index);
+    return max;
+}
+float bench_arm_mean(const size_t count) {
+    float32_t mean;
+    arm_mean_f32(data, count, &mean);
+    return mean;
+}
+float bench_arm_std(const size_t count) {
+    float32_t std;
+    arm_std_f32(data, count, &std);
+    return std;
+}
+
+typedef float (* bench_function_t)(const size_t count);
+
+/** @brief Get the average time of a single call in ns */
+double bench_run(const bench_function_t function, const size_t count) {
+    const double start = test_now_ns();
+    for (size_t i = 0U; i < TEST_ITERATIONS; ++i)
+        sink = function(count);
+    return (test_now_ns() - start) / TEST_ITERATIONS;
+}
+
+/*** ######################### TEST CASES ################################## ***/
+
+/** @brief The portable backend gives the same results of CMSIS-DSP */
+void test_stats_results(void) {
+    for (size_t s = 0U; s < sizeof(sizes) / sizeof(sizes[0U]); ++s) {
+        const size_t count = sizes[s];
+        test_fill(count);
+
+        size_t index = 0U;
+        float32_t value;
+        uint32_t arm_index;
+
+        const float min = stats_min_f32(data, count, &index);
+        arm_min_f32(data, count, &value, &arm_index);
+        TEST_ASSERT(min == value && index == arm_index);
+
+        const float max = stats_max_f32(data, count, &index);
+        arm_max_f32(data, count, &value, &arm_index);
+        TEST_ASSERT(max == value && index == arm_index);
+
+        arm_mean_f32(data, count, &value);
+        TEST_ASSERT(test_equal(stats_mean_f32(data, count), value));
+        TEST_ASSERT(test_equal(stats_sum_f32(data, count), value * count));
+
+        arm_std_f32(data, count, &value);
+        TEST_ASSERT(test_equal(stats_std_f32(data, count), value));
+    }
+}
+
+/** @brief Time the portable backend against CMSIS-DSP */
+void test_stats_benchmark(void) {
+    const struct {
+        const char * name;
+        bench_function_t portable;
+        bench_function_t cmsis;
+    } functions[] = {
+        { "min", bench_stats_min, bench_arm_min },
+        { "max", bench_stats_max, bench_arm_max },
+        { "mean", bench_stats_mean, bench_arm_mean },
+        { "std", bench_stats_std, bench_arm_std }
+    };
+
+    printf("%-5s %5s %14s %14s\n", "func", "count", "portable [ns]", "cmsis [ns]");
+    for (size_t f = 0U; f < sizeof(functions) / sizeof(functions[0U]); ++f) {
+        for (size_t s = 0U; s < sizeof(sizes) / sizeof(sizes[0U]); ++s) {
+            const size_t count = sizes[s];
+            test_fill(count);
+            const double portable = bench_run(functions[f].portable, count);
+            const double cmsis = bench_run(functions[f].cmsis, count);
+            printf("%-5s %5zu %14.1f %14.1f\n", functions[f].name, count, portable, cmsis);
+        }
+    }
+}
+
+int main(void) {
+    test_stats_results();
+    test_stats_benchmark();
+    printf("stats: ok\n");
+    return EXIT_SUCCESS;
+}
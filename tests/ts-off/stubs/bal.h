@@ -0,0 +1,22 @@
+/**
+ * @file bal.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the balancing module used by the TS off host test
+ */
+
+#ifndef BAL_H
+#define BAL_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+typedef enum {
+    BAL_OK
+} BalReturnCode;
+
+BalReturnCode bal_start(void);
+BalReturnCode bal_stop(void);
+
+#endif  // BAL_H
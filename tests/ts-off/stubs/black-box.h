@@ -0,0 +1,17 @@
+/**
+ * @file black-box.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the black box module used by the TS off host test
+ */
+
+#ifndef BLACK_BOX_H
+#define BLACK_BOX_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+void black_box_trigger(void);
+
+#endif  // BLACK_BOX_H
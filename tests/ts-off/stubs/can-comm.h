@@ -0,0 +1,29 @@
+/**
+ * @file can-comm.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the CAN communication module used by the TS off host test
+ */
+
+#ifndef CAN_COMM_H
+#define CAN_COMM_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+typedef enum {
+    CAN_COMM_OK
+} CanCommReturnCode;
+
+CanCommReturnCode can_comm_fast_routine(void);
+CanCommReturnCode can_comm_routine(void);
+CanCommReturnCode can_comm_tx_add(
+    const CanNetwork network,
+    const can_index_t index,
+    const CanFrameType frame_type,
+    uint8_t * const data,
+    const size_t size
+);
+
+#endif  // CAN_COMM_H
@@ -0,0 +1,26 @@
+/**
+ * @file error.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the error handler used by the TS off host test
+ */
+
+#ifndef ERROR_H
+#define ERROR_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+typedef enum {
+    ERROR_OK
+} ErrorReturnCode;
+
+typedef enum {
+    ERROR_GROUP_POST
+} ErrorGroup;
+
+ErrorReturnCode error_set(const ErrorGroup group, const size_t instance);
+bool error_is_expired(void);
+
+#endif  // ERROR_H
@@ -0,0 +1,46 @@
+/**
+ * @file feedback.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the feedback module used by the TS off host test
+ */
+
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include <stdbool.h>
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "primary_network.h"
+
+#define FEEDBACK_BIT_SD_END (1U)
+#define FEEDBACK_IDLE_TO_AIRN_CHECK_MASK (0U)
+#define FEEDBACK_IDLE_TO_AIRN_CHECK_HIGH (0U)
+#define FEEDBACK_AIRN_CHECK_TO_PRECHARGE_MASK (0U)
+#define FEEDBACK_AIRN_CHECK_TO_PRECHARGE_HIGH (0U)
+#define FEEDBACK_PRECHARGE_TO_AIRP_CHECK_MASK (0U)
+#define FEEDBACK_PRECHARGE_TO_AIRP_CHECK_HIGH (0U)
+#define FEEDBACK_AIRP_CHECK_TO_TS_ON_MASK (0U)
+#define FEEDBACK_AIRP_CHECK_TO_TS_ON_HIGH (0U)
+#define FEEDBACK_TS_ON_MASK (0U)
+#define FEEDBACK_TS_ON_HIGH (0U)
+
+typedef enum {
+    FEEDBACK_ID_UNKNOWN = -1
+} FeedbackId;
+
+typedef enum {
+    FEEDBACK_CONTACTOR_AIRN,
+    FEEDBACK_CONTACTOR_PRECHARGE,
+    FEEDBACK_CONTACTOR_AIRP,
+    FEEDBACK_CONTACTOR_COUNT
+} FeedbackContactor;
+
+bool feedback_check_values(const bit_flag32_t mask, const bit_flag32_t value, FeedbackId * const out);
+primary_hv_feedback_enzomma_converted_t * feedback_get_enzomma_payload(const FeedbackId id, size_t * const byte_size);
+void feedback_notify_contactor_command(const FeedbackContactor contactor, const bool closed);
+
+#endif  // FEEDBACK_H
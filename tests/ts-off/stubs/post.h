@@ -0,0 +1,29 @@
+/**
+ * @file post.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the POST module used by the TS off host test
+ */
+
+#ifndef POST_H
+#define POST_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#include "pcu.h"
+#include "display.h"
+
+typedef enum {
+    POST_OK,
+    POST_NULL_POINTER
+} PostReturnCode;
+
+typedef struct {
+    int unused;
+} PostInitData;
+
+PostReturnCode post_run(PostInitData data);
+
+#endif  // POST_H
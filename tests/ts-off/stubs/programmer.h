@@ -0,0 +1,23 @@
+/**
+ * @file programmer.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the programmer module used by the TS off host test
+ */
+
+#ifndef PROGRAMMER_H
+#define PROGRAMMER_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+typedef enum {
+    PROGRAMMER_OK,
+    PROGRAMMER_BUSY,
+    PROGRAMMER_TIMEOUT
+} ProgrammerReturnCode;
+
+ProgrammerReturnCode programmer_routine(void);
+
+#endif  // PROGRAMMER_H
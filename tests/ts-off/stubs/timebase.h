@@ -0,0 +1,25 @@
+/**
+ * @file timebase.h
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Stub of the timebase module used by the TS off host test
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include "mainboard-conf.h"
+#include "mainboard-def.h"
+
+#define TIMEBASE_TIME_TO_TICKS(T, RES) ((T) / (RES))
+
+typedef enum {
+    TIMEBASE_OK
+} TimebaseReturnCode;
+
+TimebaseReturnCode timebase_routine(void);
+ticks_t timebase_get_tick(void);
+milliseconds_t timebase_get_resolution(void);
+
+#endif  // TIMEBASE_H
@@ -0,0 +1,381 @@
+/**
+ * @file test-ts-off.c
+ * @date 2026-10-18
+ * @author agent [agent@local]
+ *
+ * @brief Host test of the TS off handling of the PCU and the FSM
+ *
+ * @details The real pcu.c and fsm.c are compiled against stubs of the other
+ * modules, the stubs of the timebase and CAN routines advance a tick counter by
+ * the time spent running the tasks and sending the transmission buffer
+ *
+ * @details The CAN reception interrupt is emulated while the timebase tasks are
+ * running, i.e. right after the fast routine at the start of the main loop, which
+ * is the worst case for the fast path, the reaction latency is measured in ticks
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mainboard-test.h"
+
+#include "fsm.h"
+#include "pcu.h"
+#include "post.h"
+#include "can-comm.h"
+#include "timebase.h"
+#include "programmer.h"
+#include "feedback.h"
+#include "bal.h"
+#include "error.h"
+#include "internal-voltage.h"
+#include "event-log.h"
+#include "black-box.h"
+
+/** @brief Maximum number of FSM iterations to wait for a transition */
+#define TEST_ITERATION_MAX (10U)
+
+/** @brief Ticks spent by the timebase tasks in a single iteration of the main loop */
+#define TEST_TASKS_TICKS (2U)
+/** @brief Number of frames sent by the CAN routine in a single iteration, each takes a tick */
+#define TEST_TX_DRAIN_FRAMES (8U)
+
+/**
+ * @brief Maximum latency of the fast path in ticks
+ *
+ * @details A TS off from the ECU must never wait for the transmission buffer to
+ * be sent, only for the timebase task that was running when it was received
+ */
+#define TEST_FAST_LATENCY_MAX_TICKS (TEST_TASKS_TICKS)
+
+static ticks_t tick;
+static ticks_t open_tick;
+static ticks_t rx_tick;
+static bool ecu_received, ecu_queued;
+static bool handcart_received, handcart_queued;
+static primary_hv_set_status_ecu_converted_t ecu_payload;
+static primary_hv_set_status_handcart_converted_t handcart_payload;
+
+static PcuPinStatus pins[PCU_PIN_COUNT];
+static size_t watchdog_running;
+static fsm_state_t state;
+static PostInitData post_data;
+static bool contactor_open_notified[FEEDBACK_CONTACTOR_COUNT];
+
+/*** ######################### MODULE STUBS ################################ ***/
+
+void mainboard_assert_failed(const char * file, const int line) {
+    test_assert_failed("MAINBOARD_ASSERT", file, line);
+}
+
+PostReturnCode post_run(PostInitData data) {
+    MAINBOARD_UNUSED(data);
+    return POST_OK;
+}
+
+/** @brief Handle the ECU set status queued by the emulated reception interrupt */
+CanCommReturnCode can_comm_fast_routine(void) {
+    if (ecu_queued) {
+        ecu_queued = false;
+        pcu_set_state_from_ecu_handle(&ecu_payload);
+    }
+    return CAN_COMM_OK;
+}
+
+/**
+ * @brief Send the transmission buffer and then handle the reception buffer
+ *
+ * @details As the real routine the fast routine runs before every frame
+ */
+CanCommReturnCode can_comm_routine(void) {
+    (void)can_comm_fast_routine();
+    for (size_t i = 0U; i < TEST_TX_DRAIN_FRAMES; ++i) {
+        ++tick;
+        (void)can_comm_fast_routine();
+    }
+    if (handcart_queued) {
+        handcart_queued = false;
+        pcu_set_state_from_handcart_handle(&handcart_payload);
+    }
+    return CAN_COMM_OK;
+}
+CanCommReturnCode can_comm_tx_add(
+    const CanNetwork network,
+    const can_index_t index,
+    const CanFrameType frame_type,
+    uint8_t * const data,
+    const size_t size)
+{
+    MAINBOARD_UNUSED(network);
+    MAINBOARD_UNUSED(index);
+    MAINBOARD_UNUSED(frame_type);
+    MAINBOARD_UNUSED(data);
+    MAINBOARD_UNUSED(size);
+    return CAN_COMM_OK;
+}
+
+/** @brief Emulate the reception interrupt while the tasks are running */
+TimebaseReturnCode timebase_routine(void) {
+    if (ecu_received || handcart_received) {
+        rx_tick = tick;
+        ecu_queued = ecu_received;
+        handcart_queued = handcart_received;
+        ecu_received = handcart_received = false;
+    }
+    tick += TEST_TASKS_TICKS;
+    return TIMEBASE_OK;
+}
+ticks_t timebase_get_tick(void) { return tick; }
+milliseconds_t timebase_get_resolution(void) { return 1U; }
+
+ProgrammerReturnCode programmer_routine(void) { return PROGRAMMER_BUSY; }
+
+BalReturnCode bal_start(void) { return BAL_OK; }
+BalReturnCode bal_stop(void) { return BAL_OK; }
+
+ErrorReturnCode error_set(const ErrorGroup group, const size_t instance) {
+    MAINBOARD_UNUSED(group);
+    MAINBOARD_UNUSED(instance);
+    return ERROR_OK;
+}
+bool error_is_expired(void) { return false; }
+
+EventLogReturnCode event_log_push(const EventLogType type, const uint8_t data_0, const uint16_t data_1) {
+    MAINBOARD_UNUSED(type);
+    MAINBOARD_UNUSED(data_0);
+    MAINBOARD_UNUSED(data_1);
+    return EVENT_LOG_OK;
+}
+
+void black_box_trigger(void) { }
+
+bool feedback_check_values(const bit_flag32_t mask, const bit_flag32_t value, FeedbackId * const out) {
+    MAINBOARD_UNUSED(mask);
+    MAINBOARD_UNUSED(value);
+    MAINBOARD_UNUSED(out);
+    return true;
+}
+primary_hv_feedback_enzomma_converted_t * feedback_get_enzomma_payload(const FeedbackId id, size_t * const byte_size) {
+    static primary_hv_feedback_enzomma_converted_t payload;
+    MAINBOARD_UNUSED(id);
+    *byte_size = sizeof(payload);
+    return &payload;
+}
+void feedback_notify_contactor_command(const FeedbackContactor contactor, const bool closed) {
+    TEST_ASSERT(contactor < FEEDBACK_CONTACTOR_COUNT);
+    contactor_open_notified[contactor] = !closed;
+}
+
+volt_t internal_voltage_get_ts(void) { return 400.f; }
+volt_t internal_voltage_get_pack(void) { return 400.f; }
+
+DisplayReturnCode display_set_segment(const DisplaySegment segment, const DisplaySegmentStatus status) {
+    MAINBOARD_UNUSED(segment);
+    MAINBOARD_UNUSED(status);
+    return DISPLAY_OK;
+}
+DisplayReturnCode display_set_digit(const uint8_t digit) {
+    MAINBOARD_UNUSED(digit);
+    return DISPLAY_OK;
+}
+DisplayReturnCode display_run_animation(
+    const DisplaySegmentBit * const animation,
+    const size_t size,
+    const milliseconds_t interval,
+    const milliseconds_t t)
+{
+    MAINBOARD_UNUSED(animation);
+    MAINBOARD_UNUSED(size);
+    MAINBOARD_UNUSED(interval);
+    MAINBOARD_UNUSED(t);
+    return DISPLAY_OK;
+}
+DisplayReturnCode display_run_animation_string(
+    const char * const animation,
+    const size_t size,
+    const milliseconds_t interval,
+    const milliseconds_t t)
+{
+    MAINBOARD_UNUSED(animation);
+    MAINBOARD_UNUSED(size);
+    MAINBOARD_UNUSED(interval);
+    MAINBOARD_UNUSED(t);
+    return DISPLAY_OK;
+}
+
+WatchdogReturnCode watchdog_init(
+    Watchdog * const watchdog,
+    const ticks_t timeout,
+    const watchdog_timeout_callback_t expire)
+{
+    memset(watchdog, 0U, sizeof(*watchdog));
+    watchdog->timeout = timeout;
+    watchdog->expire = expire;
+    return WATCHDOG_OK;
+}
+WatchdogReturnCode watchdog_deinit(Watchdog * const watchdog) {
+    if (watchdog->running)
+        --watchdog_running;
+    watchdog->running = false;
+    return WATCHDOG_OK;
+}
+WatchdogReturnCode watchdog_start(Watchdog * const watchdog) {
+    if (!watchdog->running)
+        ++watchdog_running;
+    watchdog->running = true;
+    return WATCHDOG_OK;
+}
+WatchdogReturnCode watchdog_stop(Watchdog * const watchdog) {
+    if (watchdog->running)
+        --watchdog_running;
+    watchdog->running = false;
+    return WATCHDOG_OK;
+}
+
+/*** ######################### TEST UTILITIES ############################## ***/
+
+bool test_contactors_open(void);
+
+void test_pin_set(const PcuPin pin, const PcuPinStatus status) {
+    const bool open = test_contactors_open();
+    pins[pin] = status;
+    if (!open && test_contactors_open())
+        open_tick = tick;
+}
+void test_pin_toggle(const PcuPin pin) {
+    pins[pin] = (pins[pin] == PCU_PIN_STATUS_LOW) ? PCU_PIN_STATUS_HIGH : PCU_PIN_STATUS_LOW;
+}
+
+bool test_contactors_open(void) {
+    return pins[PCU_PIN_AIR_NEGATIVE] == PCU_PIN_STATUS_HIGH &&
+        pins[PCU_PIN_PRECHARGE] == PCU_PIN_STATUS_HIGH &&
+        pins[PCU_PIN_AIR_POSITIVE] == PCU_PIN_STATUS_HIGH;
+}
+
+void test_run(void) {
+    state = fsm_run_state(state, &post_data);
+}
+
+/** @brief Initialize the modules and run the FSM until the IDLE state */
+void test_setup(void) {
+    memset(pins, 0U, sizeof(pins));
+    memset(contactor_open_notified, 0U, sizeof(contactor_open_notified));
+    watchdog_running = 0U;
+    tick = 0U;
+    ecu_received = ecu_queued = false;
+    handcart_received = handcart_queued = false;
+    TEST_ASSERT(pcu_init(test_pin_set, test_pin_toggle) == PCU_OK);
+    state = FSM_STATE_INIT;
+    test_run();
+    TEST_ASSERT(state == FSM_STATE_IDLE);
+}
+
+/** @brief Run the FSM from the IDLE state until the given state of the TS on procedure */
+void test_ts_on_until(const fsm_state_t target) {
+    primary_hv_set_status_handcart_converted_t on = { .status = true };
+    pcu_set_state_from_handcart_handle(&on);
+    for (size_t i = 0U; i < TEST_ITERATION_MAX && state != target; ++i)
+        test_run();
+    TEST_ASSERT(state == target);
+    TEST_ASSERT(!test_contactors_open());
+}
+
+/**
+ * @brief Run the FSM until the IDLE state is reached
+ *
+ * @return size_t Number of iterations needed to reach the IDLE state
+ */
+size_t test_run_until_idle(void) {
+    size_t i = 0U;
+    for (; i < TEST_ITERATION_MAX && state != FSM_STATE_IDLE; ++i)
+        test_run();
+    return i;
+}
+
+/*** ######################### TEST CASES ################################## ***/
+
+/** @brief TS off from the ECU and from the handcart while the TS is on */
+void test_ts_off_latency(void) {
+    size_t idle = 0U;
+
+    // Deferred path, used by the handcart and by the ECU before the fast path
+    test_setup();
+    test_ts_on_until(FSM_STATE_TS_ON);
+    handcart_payload.status = false;
+    handcart_received = true;
+    idle = test_run_until_idle();
+    const ticks_t deferred = open_tick - rx_tick;
+    printf("deferred TS off: contactors open after %u ticks, idle after %zu iterations\n", deferred, idle);
+    TEST_ASSERT(test_contactors_open() && idle == 1U);
+    TEST_ASSERT(deferred == TEST_TASKS_TICKS + TEST_TX_DRAIN_FRAMES);
+
+    // Fast path
+    test_setup();
+    test_ts_on_until(FSM_STATE_TS_ON);
+    ecu_payload.status = false;
+    ecu_received = true;
+    idle = test_run_until_idle();
+    const ticks_t fast = open_tick - rx_tick;
+    printf("fast TS off:     contactors open after %u ticks, idle after %zu iterations\n", fast, idle);
+    TEST_ASSERT(test_contactors_open() && idle == 1U);
+    TEST_ASSERT(fast <= TEST_FAST_LATENCY_MAX_TICKS);
+    TEST_ASSERT(fast < deferred);
+
+    // The latency of the contactors is measured from the ECU handler
+    for (FeedbackContactor contactor = 0U; contactor < FEEDBACK_CONTACTOR_COUNT; ++contactor)
+        TEST_ASSERT(contactor_open_notified[contactor]);
+    TEST_ASSERT(watchdog_running == 0U);
+    TEST_ASSERT(!pcu_is_ts_off_requested());
+}
+
+/** @brief TS off from the ECU while another event is pending in every TS on state */
+void test_ts_off_pending_event(void) {
+    const fsm_state_t states[] = {
+        FSM_STATE_AIRN_CHECK,
+        FSM_STATE_PRECHARGE_CHECK,
+        FSM_STATE_AIRP_CHECK,
+        FSM_STATE_TS_ON
+    };
+    const primary_hv_set_status_ecu_converted_t ecu_off = { .status = false };
+    fsm_event_data_t pending = { .type = FSM_EVENT_TYPE_BALANCING_STOP };
+
+    for (size_t i = 0U; i < sizeof(states) / sizeof(states[0U]); ++i) {
+        test_setup();
+        test_ts_on_until(states[i]);
+
+        // The event of the ECU is dropped because another one is pending
+        fsm_event_trigger(&pending);
+        pcu_set_state_from_ecu_handle((primary_hv_set_status_ecu_converted_t *)&ecu_off);
+        TEST_ASSERT(pcu_is_ts_off_requested());
+
+        const size_t idle = test_run_until_idle();
+        printf("pending event in %-15s: idle after %zu iterations\n", fsm_state_names[states[i]], idle);
+        TEST_ASSERT(state == FSM_STATE_IDLE && idle == 1U);
+        TEST_ASSERT(watchdog_running == 0U);
+        TEST_ASSERT(!pcu_is_ts_off_requested());
+    }
+}
+
+/** @brief A TS off received while idle is not kept for the next TS on request */
+void test_ts_off_while_idle(void) {
+    const primary_hv_set_status_ecu_converted_t ecu_off = { .status = false };
+    const primary_hv_set_status_ecu_converted_t ecu_on = { .status = true };
+
+    test_setup();
+    pcu_set_state_from_ecu_handle((primary_hv_set_status_ecu_converted_t *)&ecu_off);
+    test_run();
+    TEST_ASSERT(state == FSM_STATE_IDLE);
+    TEST_ASSERT(!pcu_is_ts_off_requested());
+
+    pcu_set_state_from_ecu_handle((primary_hv_set_status_ecu_converted_t *)&ecu_on);
+    test_run();
+    TEST_ASSERT(state == FSM_STATE_AIRN_CHECK);
+}
+
+int main(void) {
+    test_ts_off_latency();
+    test_ts_off_pending_event();
+    test_ts_off_while_idle();
+    printf("ts-off: ok\n");
+    return EXIT_SUCCESS;
+}